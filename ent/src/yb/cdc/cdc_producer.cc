@@ -124,6 +124,8 @@ Result<bool> SetCommittedRecordIndexForReplicateMsg(
     case consensus::OperationType::SNAPSHOT_OP:
       FALLTHROUGH_INTENDED;
     case consensus::OperationType::TRUNCATE_OP:
+      FALLTHROUGH_INTENDED;
+    case consensus::OperationType::SPLIT_OP:
       return false;
   }
   FATAL_INVALID_ENUM_VALUE(consensus::OperationType, msg->op_type());
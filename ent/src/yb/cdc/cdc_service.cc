@@ -12,6 +12,7 @@
 
 #include "yb/cdc/cdc_service.h"
 
+#include <atomic>
 #include <shared_mutex>
 #include <chrono>
 #include <memory>
@@ -36,6 +37,8 @@
 #include "yb/client/session.h"
 #include "yb/client/yb_table_name.h"
 #include "yb/client/yb_op.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
@@ -61,6 +64,11 @@ TAG_FLAG(cdc_ybclient_reactor_threads, advanced);
 DEFINE_int32(cdc_state_checkpoint_update_interval_ms, 15 * 1000,
              "Rate at which CDC state's checkpoint is updated.");
 
+DEFINE_int32(cdc_get_changes_max_threads, 16,
+             "Max number of threads used to complete GetChanges calls, that were waiting for "
+             "new changes.");
+TAG_FLAG(cdc_get_changes_max_threads, advanced);
+
 DECLARE_int32(cdc_checkpoint_opid_interval_ms);
 
 METRIC_DEFINE_entity(cdc);
@@ -75,6 +83,9 @@ using tserver::TSTabletManager;
 using client::internal::RemoteTabletServer;
 
 constexpr int kMaxDurationForTabletLookup = 50;
+// Parked GetChanges call is completed at least this time before the client deadline, so the
+// response reaches the client in time.
+constexpr auto kGetChangesWaitDeadlineMargin = 500ms;
 const client::YBTableName kCdcStateTableName(
     YQL_DATABASE_CQL, master::kSystemNamespaceName, master::kCdcStateTableName);
 
@@ -91,8 +102,34 @@ CDCServiceImpl::CDCServiceImpl(TSTabletManager* tablet_manager,
       server->permanent_uuid(), &server->options(), server->metric_entity(), server->mem_tracker(),
       server->messenger());
   async_client_init_->Start();
+
+  CHECK_OK(ThreadPoolBuilder("cdc_get_changes")
+               .set_max_threads(FLAGS_cdc_get_changes_max_threads)
+               .Build(&get_changes_pool_));
 }
 
+struct CDCServiceImpl::GetChangesCall {
+  const GetChangesRequestPB* req;
+  GetChangesResponsePB* resp;
+  RpcContext context;
+  ProducerTabletInfo producer_tablet;
+  std::shared_ptr<tablet::TabletPeer> tablet_peer;
+  std::shared_ptr<client::YBSession> session;
+  std::shared_ptr<StreamMetadata> stream_metadata;
+  OpId op_id;
+
+  std::atomic<bool> completed{false};
+
+  // Protects listener_id and timeout_task_id, so wakeup does not race with registration.
+  std::mutex mutex;
+  int64_t listener_id = 0;
+  rpc::ScheduledTaskId timeout_task_id = rpc::kUninitializedScheduledTaskId;
+
+  GetChangesCall(const GetChangesRequestPB* req_, GetChangesResponsePB* resp_,
+                 RpcContext context_)
+      : req(req_), resp(resp_), context(std::move(context_)) {}
+};
+
 namespace {
 bool YsqlTableHasPrimaryKey(const client::YBSchema& schema) {
   for (const auto& col : schema.columns()) {
@@ -323,20 +360,41 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   RPC_CHECK_AND_RETURN_ERROR(record.ok(), record.status(), resp->mutable_error(),
                              CDCErrorPB::INTERNAL_ERROR, context);
 
+  auto call = std::make_shared<GetChangesCall>(req, resp, std::move(context));
+  call->producer_tablet = producer_tablet;
+  call->tablet_peer = std::move(tablet_peer);
+  call->session = std::move(session);
+  call->stream_metadata = std::move(*record);
+  call->op_id = op_id;
+  ProcessGetChanges(call, req->wait_for_changes_ms() > 0);
+}
+
+void CDCServiceImpl::ProcessGetChanges(const GetChangesCallPtr& call, bool can_wait) {
+  auto* req = call->req;
+  auto* resp = call->resp;
+  const auto& tablet_peer = call->tablet_peer;
+  const auto& producer_tablet = call->producer_tablet;
+
   int64_t last_readable_index;
   consensus::ReplicateMsgsHolder msgs_holder;
   MemTrackerPtr mem_tracker = GetMemTracker(tablet_peer, producer_tablet);
-  s = cdc::GetChanges(
-      req->stream_id(), req->tablet_id(), op_id, *record->get(), tablet_peer, mem_tracker,
-      &msgs_holder, resp, &last_readable_index);
+  Status s = cdc::GetChanges(
+      req->stream_id(), req->tablet_id(), call->op_id, *call->stream_metadata, tablet_peer,
+      mem_tracker, &msgs_holder, resp, &last_readable_index);
   RPC_STATUS_RETURN_ERROR(
       s,
       resp->mutable_error(),
       s.IsNotFound() ? CDCErrorPB::CHECKPOINT_TOO_OLD : CDCErrorPB::UNKNOWN_ERROR,
-      context);
+      call->context);
 
-  s = UpdateCheckpoint(producer_tablet, OpId::FromPB(resp->checkpoint().op_id()), op_id, session);
-  RPC_STATUS_RETURN_ERROR(s, resp->mutable_error(), CDCErrorPB::INTERNAL_ERROR, context);
+  if (can_wait && resp->records_size() == 0 && last_readable_index <= call->op_id.index &&
+      WaitForChanges(call)) {
+    return;
+  }
+
+  s = UpdateCheckpoint(
+      producer_tablet, OpId::FromPB(resp->checkpoint().op_id()), call->op_id, call->session);
+  RPC_STATUS_RETURN_ERROR(s, resp->mutable_error(), CDCErrorPB::INTERNAL_ERROR, call->context);
 
   tablet_peer->consensus()->UpdateCDCConsumerOpId(GetMinSentCheckpointForTablet(req->tablet_id()));
 
@@ -359,7 +417,81 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
     }
   }
 
-  context.RespondSuccess();
+  call->context.RespondSuccess();
+}
+
+bool CDCServiceImpl::WaitForChanges(const GetChangesCallPtr& call) {
+  auto deadline = std::min(
+      CoarseMonoClock::Now() + call->req->wait_for_changes_ms() * 1ms,
+      call->context.GetClientDeadline() - kGetChangesWaitDeadlineMargin);
+  auto wait_time = deadline - CoarseMonoClock::Now();
+  if (wait_time <= 0s) {
+    return false;
+  }
+
+  auto consensus = call->tablet_peer->shared_consensus();
+  if (!consensus) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(parked_calls_mutex_);
+    parked_calls_.insert(call);
+  }
+
+  std::lock_guard<std::mutex> lock(call->mutex);
+  call->listener_id = consensus->AddMajorityReplicatedListener(
+      call->op_id.index, [this, call] { WakeUpGetChanges(call); });
+  if (call->listener_id == 0) {
+    // New operations were replicated after we read changes.
+    std::lock_guard<std::mutex> parked_lock(parked_calls_mutex_);
+    parked_calls_.erase(call);
+    return false;
+  }
+  call->timeout_task_id = tablet_manager_->server()->messenger()->scheduler().Schedule(
+      [this, call](const Status&) { WakeUpGetChanges(call); },
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait_time));
+  return true;
+}
+
+void CDCServiceImpl::WakeUpGetChanges(const GetChangesCallPtr& call) {
+  if (call->completed.load(std::memory_order_acquire)) {
+    return;
+  }
+  auto status = get_changes_pool_->SubmitFunc([this, call] { FinishGetChanges(call); });
+  if (!status.ok()) {
+    FinishGetChanges(call);
+  }
+}
+
+void CDCServiceImpl::FinishGetChanges(const GetChangesCallPtr& call) {
+  if (call->completed.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  int64_t listener_id;
+  rpc::ScheduledTaskId timeout_task_id;
+  {
+    std::lock_guard<std::mutex> lock(call->mutex);
+    listener_id = call->listener_id;
+    timeout_task_id = call->timeout_task_id;
+  }
+  if (listener_id != 0) {
+    auto consensus = call->tablet_peer->shared_consensus();
+    if (consensus) {
+      consensus->RemoveMajorityReplicatedListener(listener_id);
+    }
+  }
+  if (timeout_task_id != rpc::kUninitializedScheduledTaskId) {
+    tablet_manager_->server()->messenger()->scheduler().Abort(timeout_task_id);
+  }
+  {
+    std::lock_guard<std::mutex> lock(parked_calls_mutex_);
+    parked_calls_.erase(call);
+  }
+
+  call->resp->Clear();
+  ProcessGetChanges(call, /* can_wait= */ false);
 }
 
 Result<RemoteTabletServer *> CDCServiceImpl::GetLeaderTServer(const TabletId& tablet_id) {
@@ -526,6 +658,17 @@ void CDCServiceImpl::GetCheckpoint(const GetCheckpointRequestPB* req,
 }
 
 void CDCServiceImpl::Shutdown() {
+  // Respond to all calls that are still waiting for changes, before the client is shut down.
+  std::vector<GetChangesCallPtr> parked_calls;
+  {
+    std::lock_guard<std::mutex> lock(parked_calls_mutex_);
+    parked_calls.assign(parked_calls_.begin(), parked_calls_.end());
+  }
+  for (const auto& call : parked_calls) {
+    FinishGetChanges(call);
+  }
+  get_changes_pool_->Shutdown();
+
   async_client_init_->Shutdown();
   rpcs_.Shutdown();
 }
@@ -15,6 +15,9 @@
 
 #include "yb/cdc/cdc_service.service.h"
 
+#include <mutex>
+#include <unordered_set>
+
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
@@ -37,6 +40,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/service_util.h"
+#include "yb/util/threadpool.h"
 
 namespace yb {
 
@@ -96,6 +100,10 @@ class CDCServiceImpl : public CDCServiceIf {
   }
 
  private:
+  // State of the GetChanges call, that could wait for new majority replicated operations.
+  struct GetChangesCall;
+  typedef std::shared_ptr<GetChangesCall> GetChangesCallPtr;
+
   template <class ReqType, class RespType>
   bool CheckOnline(const ReqType* req, RespType* resp, rpc::RpcContext* rpc);
 
@@ -118,6 +126,21 @@ class CDCServiceImpl : public CDCServiceIf {
 
   CHECKED_STATUS CheckTabletValidForStream(const ProducerTabletInfo& producer_info);
 
+  // Reads changes for the call and responds to it. When there are no new majority replicated
+  // operations and 'can_wait' is true, the call is parked until such operations appear or wait
+  // timeout expires.
+  void ProcessGetChanges(const GetChangesCallPtr& call, bool can_wait);
+
+  // Registers the call for wakeup by majority replicated operation listener or timeout.
+  // Returns false if the call should not wait.
+  bool WaitForChanges(const GetChangesCallPtr& call);
+
+  // Invoked when parked call should be completed, schedules FinishGetChanges.
+  void WakeUpGetChanges(const GetChangesCallPtr& call);
+
+  // Unregisters the parked call and responds to it with changes that are available now.
+  void FinishGetChanges(const GetChangesCallPtr& call);
+
   void TabletLeaderGetChanges(const GetChangesRequestPB* req,
                               GetChangesResponsePB* resp,
                               std::shared_ptr<rpc::RpcContext> context,
@@ -211,6 +234,12 @@ class CDCServiceImpl : public CDCServiceIf {
   // Map of HostPort -> CDCServiceProxy. This is used to redirect requests to tablet leader's
   // CDC service proxy.
   CDCServiceProxyMap cdc_service_map_;
+
+  // Used to complete parked GetChanges calls, since it could require writes to cdc_state table.
+  std::unique_ptr<ThreadPool> get_changes_pool_;
+
+  std::mutex parked_calls_mutex_;
+  std::unordered_set<GetChangesCallPtr> parked_calls_ GUARDED_BY(parked_calls_mutex_);
 };
 
 }  // namespace cdc
@@ -29,6 +29,7 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/slice.h"
 #include "yb/yql/cql/ql/util/errcodes.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
@@ -42,6 +43,8 @@ METRIC_DECLARE_gauge_int64(last_read_opid_index);
 namespace yb {
 namespace cdc {
 
+using namespace std::literals;
+
 using client::TableHandle;
 using client::YBSessionPtr;
 using rpc::RpcController;
@@ -336,6 +339,73 @@ TEST_F(CDCServiceTest, TestGetChangesInvalidStream) {
   ASSERT_TRUE(change_resp.has_error());
 }
 
+TEST_F(CDCServiceTest, TestGetChangesWaitsForChanges) {
+  CDCStreamId stream_id;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+
+  GetChangesRequestPB change_req;
+  GetChangesResponsePB change_resp;
+  change_req.set_tablet_id(tablet_id);
+  change_req.set_stream_id(stream_id);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+  {
+    RpcController rpc;
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_FALSE(change_resp.has_error());
+    ASSERT_EQ(change_resp.records_size(), 0);
+  }
+
+  // Nothing is written, so the call should respond with empty result after wait timeout.
+  change_req.mutable_from_checkpoint()->CopyFrom(change_resp.checkpoint());
+  change_req.set_wait_for_changes_ms(1000);
+  change_resp.Clear();
+  {
+    RpcController rpc;
+    rpc.set_timeout(MonoDelta::FromSeconds(30));
+    auto start = CoarseMonoClock::Now();
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_GE(CoarseMonoClock::Now() - start, 1s);
+    ASSERT_FALSE(change_resp.has_error());
+    ASSERT_EQ(change_resp.records_size(), 0);
+  }
+
+  // The call should respond as soon as a row is written.
+  change_req.mutable_from_checkpoint()->CopyFrom(change_resp.checkpoint());
+  change_req.set_wait_for_changes_ms(20000);
+  change_resp.Clear();
+  RpcController change_rpc;
+  change_rpc.set_timeout(MonoDelta::FromSeconds(30));
+  CountDownLatch latch(1);
+  auto start = CoarseMonoClock::Now();
+  cdc_proxy_->GetChangesAsync(
+      change_req, &change_resp, &change_rpc, [&latch]() { latch.CountDown(); });
+  ASSERT_FALSE(latch.WaitFor(MonoDelta::FromMilliseconds(500)));
+
+  tserver::WriteRequestPB write_req;
+  tserver::WriteResponsePB write_resp;
+  write_req.set_tablet_id(tablet_id);
+  {
+    RpcController rpc;
+    AddTestRowInsert(1, 11, "key1", &write_req);
+    ASSERT_OK(proxy->Write(write_req, &write_resp, &rpc));
+    ASSERT_FALSE(write_resp.has_error());
+  }
+
+  latch.Wait();
+  ASSERT_LT(CoarseMonoClock::Now() - start, 20s);
+  ASSERT_OK(change_rpc.status());
+  SCOPED_TRACE(change_resp.DebugString());
+  ASSERT_FALSE(change_resp.has_error());
+  ASSERT_EQ(change_resp.records_size(), 1);
+  ASSERT_NO_FATALS(AssertIntKey(change_resp.records(0).key(), 1));
+}
+
 TEST_F(CDCServiceTest, TestGetCheckpoint) {
   CDCStreamId stream_id;
   CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
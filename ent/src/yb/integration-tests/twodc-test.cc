@@ -332,6 +332,19 @@ class TwoDCTest : public YBTest, public testing::WithParamInterface<int> {
     return size;
   }
 
+  uint32_t GetMaxWriteRpcsInFlight(MiniCluster* cluster) {
+    uint32_t result = 0;
+    for (const auto& mini_tserver : cluster->mini_tablet_servers()) {
+      auto* tserver = dynamic_cast<tserver::enterprise::TabletServer*>(
+          mini_tserver->server());
+      CDCConsumer* cdc_consumer;
+      if (tserver && (cdc_consumer = tserver->GetCDCConsumer())) {
+        result = std::max(result, cdc_consumer->GetMaxWriteRpcsInFlight());
+      }
+    }
+    return result;
+  }
+
   void WriteTransactionalWorkload(uint32_t start, uint32_t end, YBClient* client,
                                   client::TransactionManager* txn_mgr, const YBTableName& table) {
     auto session = client->NewSession();
@@ -646,6 +659,56 @@ TEST_P(TwoDCTest, ApplyOperations) {
   Destroy();
 }
 
+TEST_P(TwoDCTest, ApplyOperationsToMultipleConsumerTablets) {
+  // Records of the single producer tablet are written to several consumer tablets, so write
+  // batches to different tablets are applied concurrently.
+  auto tables = ASSERT_RESULT(SetUpWithParams({4}, {1}, 1));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.reserve(1);
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  // Writes to the same key should be applied in order, so the deleted rows do not reappear.
+  WriteWorkload(0, 100, producer_client(), tables[0]->name());
+  DeleteWorkload(0, 50, producer_client(), tables[0]->name());
+  WriteWorkload(25, 35, producer_client(), tables[0]->name());
+
+  ASSERT_OK(VerifyNumRecords(tables[0]->name(), producer_client(), 60));
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
+TEST_P(TwoDCTest, PipelineWritesToSameConsumerTablet) {
+  // With one producer and one consumer tablet, all the writes go to the same consumer tablet, and
+  // several of them should still be in flight at the same time.
+  auto tables = ASSERT_RESULT(SetUpWithParams({1}, {1}, 1));
+
+  // Write before replication is set up, so the consumer receives a lot of records at once.
+  WriteWorkload(0, 500, producer_client(), tables[0]->name());
+  DeleteWorkload(0, 250, producer_client(), tables[0]->name());
+  WriteWorkload(100, 200, producer_client(), tables[0]->name());
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.reserve(1);
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+
+  // Later writes to the same key win, regardless of the order in which batches are applied.
+  ASSERT_OK(VerifyNumRecords(tables[0]->name(), producer_client(), 350));
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+  ASSERT_GT(GetMaxWriteRpcsInFlight(consumer_cluster()), 1);
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
 TEST_P(TwoDCTest, ApplyOperationsWithTransactions) {
   uint32_t replication_factor = NonTsanVsTsan(3, 1);
   auto tables = ASSERT_RESULT(SetUpWithParams({2}, {2}, replication_factor));
@@ -90,7 +90,8 @@ class ClusterLoadState : public yb::master::ClusterLoadState {
   }
 
   void SortLeaderLoad() override {
-    auto leader_count_comparator = LeaderLoadComparator(this);
+    auto leader_count_comparator =
+        LeaderLoadComparator(this, sorted_non_affinitized_leader_load_);
     sort(sorted_non_affinitized_leader_load_.begin(),
          sorted_non_affinitized_leader_load_.end(),
          leader_count_comparator);
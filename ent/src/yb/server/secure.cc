@@ -35,6 +35,8 @@ DEFINE_string(certs_for_client_dir, "",
               "this server that should be used for client to server communications. "
               "When empty, the same dir as for server to server communications is used.");
 
+DECLARE_bool(enable_stream_compression);
+
 namespace yb {
 namespace server {
 
@@ -57,6 +59,13 @@ Result<std::unique_ptr<rpc::SecureContext>> SetupSecureContext(
     return std::unique_ptr<rpc::SecureContext>();
   }
 
+  // Both encryption and compression replace the listen protocol of the messenger, so they could
+  // not be combined.
+  if (type == SecureContextType::kServerToServer && FLAGS_enable_stream_compression) {
+    return STATUS(InvalidArgument,
+                  "Stream compression could not be used with node to node encryption");
+  }
+
   std::string dir;
   if (type == SecureContextType::kClientToServer) {
     dir = FLAGS_certs_for_client_dir;
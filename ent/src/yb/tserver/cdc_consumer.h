@@ -89,6 +89,18 @@ class CDCConsumer {
     return TEST_num_successful_write_rpcs.load(std::memory_order_acquire);
   }
 
+  void UpdateMaxWriteRpcsInFlight(uint32_t writes_in_flight) {
+    auto current = TEST_max_write_rpcs_in_flight.load(std::memory_order_acquire);
+    while (current < writes_in_flight &&
+           !TEST_max_write_rpcs_in_flight.compare_exchange_weak(current, writes_in_flight)) {
+    }
+  }
+
+  // Max number of write rpcs that one output client had in flight at the same time.
+  uint32_t GetMaxWriteRpcsInFlight() {
+    return TEST_max_write_rpcs_in_flight.load(std::memory_order_acquire);
+  }
+
  private:
   // Runs a thread that periodically polls for any new threads.
   void RunThread();
@@ -146,6 +158,8 @@ class CDCConsumer {
   std::shared_ptr<rpc::Rpcs> rpcs_ = std::make_shared<rpc::Rpcs>();
 
   std::atomic<uint32_t> TEST_num_successful_write_rpcs {0};
+
+  std::atomic<uint32_t> TEST_max_write_rpcs_in_flight {0};
 };
 
 } // namespace enterprise
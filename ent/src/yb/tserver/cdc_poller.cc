@@ -21,6 +21,7 @@
 #include "yb/client/client.h"
 
 #include "yb/consensus/opid_util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/threadpool.h"
 
@@ -31,6 +32,11 @@ DEFINE_int32(replication_failure_delay_exponent, 16 /* ~ 2^16/1000 ~= 65 sec */,
 DEFINE_bool(cdc_consumer_use_proxy_forwarding, false,
             "When enabled, read requests from the CDC Consumer that go to the wrong node are "
             "forwarded to the correct node by the Producer.");
+DEFINE_int32(cdc_consumer_wait_for_changes_ms, 1000,
+             "How long the Producer could wait for new changes before responding to a poll "
+             "that has nothing to return. 0 means that the Producer responds immediately.");
+TAG_FLAG(cdc_consumer_wait_for_changes_ms, runtime);
+TAG_FLAG(cdc_consumer_wait_for_changes_ms, advanced);
 
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
@@ -100,6 +106,9 @@ void CDCPoller::DoPoll() {
   req.set_stream_id(producer_tablet_info_.stream_id);
   req.set_tablet_id(producer_tablet_info_.tablet_id);
   req.set_serve_as_proxy(FLAGS_cdc_consumer_use_proxy_forwarding);
+  if (FLAGS_cdc_consumer_wait_for_changes_ms > 0) {
+    req.set_wait_for_changes_ms(FLAGS_cdc_consumer_wait_for_changes_ms);
+  }
 
   cdc::CDCCheckpointPB checkpoint;
   *checkpoint.mutable_op_id() = op_id_;
@@ -34,6 +34,14 @@ DEFINE_bool(cdc_force_remote_tserver, false,
             "Avoid local tserver apply optimization for CDC and force remote RPCs.");
 TAG_FLAG(cdc_force_remote_tserver, runtime);
 
+DEFINE_int32(cdc_max_apply_batches_in_flight, 4,
+             "Max number of CDC write batches that are applied concurrently for a single producer "
+             "tablet, including several batches to the same consumer tablet. Each replicated "
+             "value is written at the hybrid time of its producer record, so the result does not "
+             "depend on the order in which concurrent batches are applied.");
+TAG_FLAG(cdc_max_apply_batches_in_flight, runtime);
+TAG_FLAG(cdc_max_apply_batches_in_flight, advanced);
+
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
 namespace yb {
@@ -61,7 +69,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   CHECKED_STATUS ApplyChanges(const cdc::GetChangesResponsePB* resp) override;
 
   void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                          rpc::Rpcs::Handle handle);
+                          const TabletId& tablet_id, rpc::Rpcs::Handle handle);
 
  private:
   void TabletLookupCallback(
@@ -71,7 +79,14 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   void WriteIfAllRecordsProcessed();
 
-  void SendNextCDCWriteToTablet();
+  // Sends write requests, that could be sent without waiting for the writes in flight, until
+  // cdc_max_apply_batches_in_flight writes are in flight.
+  void SendNextCDCWrites();
+
+  void SendCDCWrite(std::unique_ptr<WriteRequestPB> write_request);
+
+  // Handles completion of the write request to the tablet.
+  void WriteDone(const Status& status, const TabletId& tablet_id);
 
   // Increment processed record count.
   // Returns true if all records are processed, false if there are still some pending records.
@@ -91,7 +106,8 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   std::shared_ptr<client::YBTable> table_;
 
-  // Used to protect error_status_, op_id_, done_processing_ and record counts.
+  // Used to protect error_status_, op_id_, done_processing_, record counts, record_tablet_ids_,
+  // write_strategy_ and writes_in_flight_.
   mutable rw_spinlock lock_;
   Status error_status_ GUARDED_BY(lock_);
   OpIdPB op_id_ GUARDED_BY(lock_) = consensus::MinimumOpId();
@@ -103,7 +119,13 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   // This will cache the response to an ApplyChanges() request.
   cdc::GetChangesResponsePB resp_;
 
-  std::unique_ptr<TwoDCWriteInterface> write_strategy_;
+  // Consumer tablet of each record in resp_. Tablet lookups complete in arbitrary order, so records
+  // are passed to write_strategy_ only after all lookups are done, to keep their original order.
+  std::vector<TabletId> record_tablet_ids_ GUARDED_BY(lock_);
+
+  std::unique_ptr<TwoDCWriteInterface> write_strategy_ GUARDED_BY(lock_);
+
+  uint32_t writes_in_flight_ GUARDED_BY(lock_) = 0;
 };
 
 Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* resp) {
@@ -126,6 +148,8 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* resp) {
     done_processing_ = false;
     processed_record_count_ = 0;
     record_count_ = resp->records_size();
+    record_tablet_ids_.clear();
+    writes_in_flight_ = 0;
     ResetWriteInterface(&write_strategy_);
   }
 
@@ -158,6 +182,11 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* resp) {
     }
   }
 
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    record_tablet_ids_.resize(resp_.records_size());
+  }
+
   for (int i = 0; i < resp_.records_size(); i++) {
     // All KV-pairs within a single CDC record will be for the same row.
     // key(0).key() will contain the hash code for that row. We use this to lookup the tablet.
@@ -202,8 +231,15 @@ void TwoDCOutputClient::WriteIfAllRecordsProcessed() {
       // Return error, if any, without applying records.
       HandleResponse();
     } else {
-      // Apply the writes on consumer.
-      SendNextCDCWriteToTablet();
+      // Group the records to write requests in the order they were received, then apply the
+      // writes on consumer.
+      {
+        std::lock_guard<decltype(lock_)> l(lock_);
+        for (int i = 0; i < resp_.records_size(); i++) {
+          write_strategy_->ProcessRecord(record_tablet_ids_[i], resp_.records(i));
+        }
+      }
+      SendNextCDCWrites();
     }
   }
 }
@@ -217,20 +253,49 @@ void TwoDCOutputClient::TabletLookupCallback(
     return;
   }
 
-  write_strategy_->ProcessRecord(tablet->get()->tablet_id(), resp_.records(record_idx));
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    record_tablet_ids_[record_idx] = tablet->get()->tablet_id();
+  }
 
   WriteIfAllRecordsProcessed();
 }
 
 void TwoDCOutputClient::TabletLookupCallbackFastTrack(const size_t record_idx) {
-  write_strategy_->ProcessRecord(consumer_tablet_info_.tablet_id, resp_.records(record_idx));
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    record_tablet_ids_[record_idx] = consumer_tablet_info_.tablet_id;
+  }
 
   WriteIfAllRecordsProcessed();
 }
 
-void TwoDCOutputClient::SendNextCDCWriteToTablet() {
-  auto write_request = write_strategy_->GetNextWriteRequest();
+void TwoDCOutputClient::SendNextCDCWrites() {
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    // Once a write failed, the remaining writes are not sent.
+    if (!error_status_.ok()) {
+      return;
+    }
+    const uint32_t max_writes_in_flight = std::max(FLAGS_cdc_max_apply_batches_in_flight, 1);
+    while (writes_in_flight_ < max_writes_in_flight) {
+      auto write_request = write_strategy_->GetNextWriteRequest();
+      if (!write_request) {
+        break;
+      }
+      ++writes_in_flight_;
+      write_requests.push_back(std::move(write_request));
+    }
+    cdc_consumer_->UpdateMaxWriteRpcsInFlight(writes_in_flight_);
+  }
+
+  for (auto& write_request : write_requests) {
+    SendCDCWrite(std::move(write_request));
+  }
+}
 
+void TwoDCOutputClient::SendCDCWrite(std::unique_ptr<WriteRequestPB> write_request) {
   auto deadline = CoarseMonoClock::Now() +
                   MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
   auto write_rpc_handle = cdc_consumer_->rpcs()->Prepare();
@@ -242,32 +307,57 @@ void TwoDCOutputClient::SendNextCDCWriteToTablet() {
         local_client_.get(),
         write_request.get(),
         std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this,
-                  std::placeholders::_1, std::placeholders::_2, write_rpc_handle),
+                  std::placeholders::_1, std::placeholders::_2, write_request->tablet_id(),
+                  write_rpc_handle),
         UseLocalTserver());
     (**write_rpc_handle).SendRpc();
   } else {
     LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+    WriteDone(STATUS(Aborted, "CDC consumer is shutting down"), write_request->tablet_id());
   }
 }
 
 void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                                           rpc::Rpcs::Handle handle) {
+                                           const TabletId& tablet_id, rpc::Rpcs::Handle handle) {
   auto retained = cdc_consumer_->rpcs()->Unregister(handle);
   if (!status.ok()) {
-    HandleError(status, true /* done */);
+    WriteDone(status, tablet_id);
     return;
   } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()), true /* done */);
+    WriteDone(StatusFromPB(response.error().status()), tablet_id);
     return;
   }
 
   cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
 
-  if (!write_strategy_->HasMoreWrites()) {
+  WriteDone(Status::OK(), tablet_id);
+}
+
+void TwoDCOutputClient::WriteDone(const Status& status, const TabletId& tablet_id) {
+  if (!status.ok()) {
+    LOG(ERROR) << "Error while applying replicated record: " << status
+               << ", consumer tablet: " << consumer_tablet_info_.tablet_id;
+  }
+
+  bool done;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    write_strategy_->WriteRequestDone(tablet_id);
+    --writes_in_flight_;
+    if (!status.ok()) {
+      error_status_ = status;
+    }
+    // In case of error, respond only after all writes in flight are completed, so they are not
+    // applied concurrently with the retry of the same records.
+    done = writes_in_flight_ == 0 &&
+           (!error_status_.ok() || !write_strategy_->HasMoreWrites());
+  }
+
+  if (done) {
     // Last record, return response to caller.
     HandleResponse();
   } else {
-    SendNextCDCWriteToTablet();
+    SendNextCDCWrites();
   }
 }
 
@@ -11,6 +11,7 @@
 // under the License.
 
 #include <deque>
+#include <unordered_map>
 
 #include "yb/tserver/twodc_write_interface.h"
 #include "yb/tserver/tserver.pb.h"
@@ -45,10 +46,11 @@ namespace tserver {
 namespace enterprise {
 
 
-// The SequentialWriteImplementation strategy sends one record per WriteRequestPB, and waits for a
-// a response from one rpc before sending out another. This implementation sends rpcs in order
-// of opid. Note that a single write request can still contain a batch of multiple key value pairs,
-// corresponding to all the changes in a record.
+// The SequentialWriteImplementation strategy sends one record per WriteRequestPB. This
+// implementation sends rpcs in order of opid, without waiting for the previous ones to complete.
+// Each request is written at the hybrid time of its record, so requests to the same key could be
+// applied in any order. Note that a single write request can still contain a batch of multiple key
+// value pairs, corresponding to all the changes in a record.
 class SequentialWriteImplementation : public TwoDCWriteInterface {
  public:
   ~SequentialWriteImplementation() = default;
@@ -73,25 +75,33 @@ class SequentialWriteImplementation : public TwoDCWriteInterface {
   }
 
   std::unique_ptr <WriteRequestPB> GetNextWriteRequest() override {
+    if (records_.empty()) {
+      return nullptr;
+    }
     auto next_req = std::move(records_.front());
     records_.pop_front();
     return next_req;
   }
 
+  void WriteRequestDone(const std::string& tablet_id) override {
+  }
+
   bool HasMoreWrites() override {
     return records_.size() > 0;
   }
 
  private:
   std::deque <std::unique_ptr<WriteRequestPB>> records_;
-
 };
 
 // The BatchedWriteImplementation strategy batches together multiple records per WriteRequestPB.
 // Max number of records in a request is cdc_max_apply_batch_num_records, and max size of a request
 // is cdc_max_apply_batch_size_kb. Batches are not sent by opid order, since a GetChangesResponse
 // can contain interleaved records to multiple tablets. Rather, we send batches to each tablet
-// in order for that tablet, before moving on to the next tablet.
+// in order for that tablet, preferring the tablets with the fewest batches in flight. Several
+// batches to the same tablet could be in flight at the same time. Every key value pair is written
+// at the hybrid time of its record, so the result does not depend on the order in which the
+// batches are applied.
 class BatchedWriteImplementation : public TwoDCWriteInterface {
   ~BatchedWriteImplementation() = default;
 
@@ -137,15 +147,37 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
   }
 
   std::unique_ptr <WriteRequestPB> GetNextWriteRequest() override {
-    auto& queue = records_.begin()->second;
+    auto next_it = records_.end();
+    size_t next_in_flight = 0;
+    for (auto it = records_.begin(); it != records_.end(); ++it) {
+      auto in_flight_it = writes_in_flight_.find(it->first);
+      size_t in_flight = in_flight_it == writes_in_flight_.end() ? 0 : in_flight_it->second;
+      if (next_it == records_.end() || in_flight < next_in_flight) {
+        next_it = it;
+        next_in_flight = in_flight;
+      }
+    }
+    if (next_it == records_.end()) {
+      return nullptr;
+    }
+
+    auto& queue = next_it->second;
     auto next_req = std::move(queue.front());
     queue.pop_front();
     if (queue.size() == 0) {
-      records_.erase(next_req->tablet_id());
+      records_.erase(next_it);
     }
+    ++writes_in_flight_[next_req->tablet_id()];
     return next_req;
   }
 
+  void WriteRequestDone(const std::string& tablet_id) override {
+    auto it = writes_in_flight_.find(tablet_id);
+    if (it != writes_in_flight_.end() && --it->second == 0) {
+      writes_in_flight_.erase(it);
+    }
+  }
+
   bool HasMoreWrites() override {
     return records_.size() > 0;
   }
@@ -153,6 +185,9 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
  private:
   std::map <std::string, std::deque<std::unique_ptr < WriteRequestPB>>>
   records_;
+
+  // Number of write requests in flight, for tablets that have any.
+  std::unordered_map<std::string, size_t> writes_in_flight_;
 };
 
 void ResetWriteInterface(std::unique_ptr<TwoDCWriteInterface>* write_strategy) {
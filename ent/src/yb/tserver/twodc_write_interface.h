@@ -28,11 +28,22 @@ class WriteRequestPB;
 
 namespace enterprise {
 
+// Strategy that groups CDC records to write requests and decides which of them could be sent
+// concurrently. Not thread safe.
 class TwoDCWriteInterface {
  public:
   virtual ~TwoDCWriteInterface() {}
+
+  // Returns the next write request to send, or nullptr if all requests were already returned.
   virtual std::unique_ptr <WriteRequestPB> GetNextWriteRequest() = 0;
+
+  // Should be called when the write request to the tablet, returned by GetNextWriteRequest, is
+  // completed.
+  virtual void WriteRequestDone(const std::string& tablet_id) = 0;
+
   virtual void ProcessRecord(const std::string& tablet_id, const cdc::CDCRecordPB& record) = 0;
+
+  // Whether there are write requests that were not returned by GetNextWriteRequest yet.
   virtual bool HasMoreWrites() = 0;
 };
 
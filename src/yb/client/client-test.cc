@@ -31,9 +31,11 @@
 //
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <thread>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -1736,6 +1738,78 @@ TEST_F(ClientTest, TestMasterLookupPermits) {
             client_->data_->meta_cache_->master_lookup_sem_.GetValue());
 }
 
+// Measures throughput of cached tablet lookups by partition key, performed concurrently by a lot
+// of threads, like it happens in the CQL and Redis proxies.
+TEST_F(ClientTest, BenchmarkConcurrentLookupTabletByKey) {
+  const int kNumThreads = 32;
+  const int kLookupsPerThread = AllowSlowTests() ? 1000000 : 100000;
+
+  auto* meta_cache = client_->data_->meta_cache_.get();
+  const YBTable* table = client_table_.get();
+  const auto partitions = table->GetPartitions();
+  ASSERT_EQ(static_cast<size_t>(kNumTablets), partitions->size());
+
+  // Populate the cache, so all following lookups are served by the fast path.
+  for (const auto& partition : *partitions) {
+    ASSERT_RESULT(meta_cache->LookupTabletByKeyFuture(
+        table, partition, CoarseMonoClock::Now() + 10s).get());
+  }
+
+  // Runs lookup with all threads and returns the number of lookups per second.
+  auto measure = [&partitions, kNumThreads, kLookupsPerThread](
+      const char* name, const std::function<bool(const std::string&)>& lookup) {
+    std::atomic<int64_t> failed_lookups(0);
+    std::vector<std::thread> threads;
+    Stopwatch sw;
+    sw.start();
+    for (int i = 0; i != kNumThreads; ++i) {
+      threads.emplace_back([&partitions, &lookup, &failed_lookups, kLookupsPerThread] {
+        for (int j = 0; j != kLookupsPerThread; ++j) {
+          if (!lookup((*partitions)[j % partitions->size()])) {
+            failed_lookups.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    sw.stop();
+
+    EXPECT_EQ(0, failed_lookups.load()) << name;
+    const double total_lookups = static_cast<double>(kNumThreads) * kLookupsPerThread;
+    const double result = total_lookups / sw.elapsed().wall_seconds();
+    LOG(INFO) << Format("$0: $1 threads did $2 lookups in $3 seconds, $4 lookups per second",
+                        name, kNumThreads, total_lookups, sw.elapsed().wall_seconds(), result);
+    return result;
+  };
+
+  // The lookup under the shared MetaCache lock, that was used before snapshots were introduced.
+  const double locked_rate = measure(
+      "Locked", [meta_cache, table](const std::string& key) NO_THREAD_SAFETY_ANALYSIS {
+    std::shared_lock<boost::shared_mutex> lock(meta_cache->mutex_);
+    return meta_cache->LookupTabletByKeyFastPathUnlocked(
+        table, table->FindPartitionStart(key)) != nullptr;
+  });
+
+  std::atomic<int64_t> failed_lookups(0);
+  const double snapshot_rate = measure(
+      "Snapshot", [meta_cache, table, &failed_lookups](const std::string& key) {
+    meta_cache->LookupTabletByKey(
+        table, key, CoarseMonoClock::Now() + 10s,
+        [&failed_lookups](const Result<internal::RemoteTabletPtr>& result) {
+          if (!result.ok()) {
+            failed_lookups.fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+    return true;
+  });
+  ASSERT_EQ(0, failed_lookups.load());
+
+  LOG(INFO) << Format("Snapshot lookups are $0 times faster than locked lookups",
+                      snapshot_rate / locked_rate);
+}
+
 // Define callback for deadlock simulation, as well as various helper methods.
 namespace {
 
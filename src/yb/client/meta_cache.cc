@@ -109,6 +109,22 @@ const size_t kPartitionGroupSize = 64;
 const size_t kPartitionGroupSize = 4;
 #endif
 
+// Checks whether the tablet found by partition start could be used for the partition key.
+RemoteTabletPtr CheckFoundTablet(RemoteTabletPtr tablet, const std::string& partition_key) {
+  // Stale entries must be re-fetched.
+  if (tablet->stale()) {
+    return nullptr;
+  }
+
+  if (tablet->partition().partition_key_end().compare(partition_key) > 0 ||
+      tablet->partition().partition_key_end().empty()) {
+    // partition_key < partition.end OR tablet doesn't end.
+    return tablet;
+  }
+
+  return nullptr;
+}
+
 } // namespace
 
 ////////////////////////////////////////////////////////////
@@ -688,6 +704,8 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
   RemoteTabletPtr result;
   bool first = true;
   std::vector<std::pair<LookupTabletCallback, internal::RemoteTabletPtr>> to_notify;
+  std::unordered_map<TableId, TableData*> updated_tables;
+  TableSnapshotUpdates snapshot_updates;
 
   {
     std::lock_guard<decltype(mutex_)> l(mutex_);
@@ -719,7 +737,15 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
           remote = new RemoteTablet(tablet_id, partition);
 
           CHECK(tablets_by_id_.emplace(tablet_id, remote).second);
-          CHECK(tablets_by_key.emplace(partition.partition_key_start(), remote).second);
+          auto emplace_result = tablets_by_key.emplace(partition.partition_key_start(), remote);
+          if (!emplace_result.second) {
+            // The tablet with the same partition start was split, and replaced by the new one.
+            VLOG(1) << "Replacing tablet " << emplace_result.first->second->tablet_id()
+                    << " with " << tablet_id;
+            emplace_result.first->second->MarkStale();
+            emplace_result.first->second = remote;
+          }
+          updated_tables.emplace(table_id, &table_data);
         }
         remote->Refresh(ts_cache_, loc.replicas());
 
@@ -748,6 +774,22 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
         }
       }
     }
+
+    if (!updated_tables.empty()) {
+      ++last_snapshot_version_;
+      snapshot_updates.reserve(updated_tables.size());
+      for (const auto& table_id_and_data : updated_tables) {
+        snapshot_updates.emplace_back(table_id_and_data.first, TabletsByPartitionSnapshot {
+          last_snapshot_version_,
+          std::make_shared<const TabletsByPartition>(
+              table_id_and_data.second->tablets_by_partition)
+        });
+      }
+    }
+  }
+
+  if (!snapshot_updates.empty()) {
+    PublishTabletsByPartition(std::move(snapshot_updates));
   }
 
   for (const auto& callback_and_remote_tablet : to_notify) {
@@ -941,6 +983,23 @@ class LookupByKeyRpc : public LookupRpc {
   GetTableLocationsResponsePB resp_;
 };
 
+void MetaCache::PublishTabletsByPartition(TableSnapshotUpdates updates) {
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  TableSnapshots snapshots;
+  {
+    // The reference should be released before Set, since Set waits for all readers.
+    auto current_snapshots = table_snapshots_.get();
+    snapshots = *current_snapshots;
+  }
+  for (auto& update : updates) {
+    auto emplace_result = snapshots.emplace(update.first, update.second);
+    if (!emplace_result.second && emplace_result.first->second.version < update.second.version) {
+      emplace_result.first->second = std::move(update.second);
+    }
+  }
+  table_snapshots_.Set(std::move(snapshots));
+}
+
 RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* table,
                                                              const std::string& partition_key) {
   auto it = tables_.find(table->id());
@@ -956,20 +1015,30 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
     return nullptr;
   }
 
-  const auto& result = tablet_it->second;
+  return CheckFoundTablet(tablet_it->second, partition_key);
+}
 
-  // Stale entries must be re-fetched.
-  if (result->stale()) {
-    return nullptr;
-  }
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPath(const YBTable* table,
+                                                     const std::string& partition_key) {
+  RemoteTabletPtr result;
+  {
+    auto snapshots = table_snapshots_.get();
+    auto it = snapshots->find(table->id());
+    if (PREDICT_FALSE(it == snapshots->end())) {
+      // No cache available for this table.
+      return nullptr;
+    }
 
-  if (result->partition().partition_key_end().compare(partition_key) > 0 ||
-      result->partition().partition_key_end().empty()) {
-    // partition_key < partition.end OR tablet doesn't end.
-    return result;
+    const auto& tablets = *it->second.tablets;
+    auto tablet_it = tablets.find(partition_key);
+    if (PREDICT_FALSE(tablet_it == tablets.end())) {
+      // No tablets with a start partition key lower than 'partition_key'.
+      return nullptr;
+    }
+    result = tablet_it->second;
   }
 
-  return nullptr;
+  return CheckFoundTablet(std::move(result), partition_key);
 }
 
 // We disable thread safety analysis in this function due to manual conditional locking.
@@ -996,9 +1065,19 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
                                   const string& partition_key,
                                   CoarseTimePoint deadline,
                                   LookupTabletCallback callback) NO_THREAD_SAFETY_ANALYSIS {
-  const auto& partition_start = table->FindPartitionStart(partition_key);
+  const auto partitions = table->GetPartitions();
+  const auto& partition_start = YBTable::FindPartitionStart(*partitions, partition_key);
+
+  // Fast path: lookup in the snapshot, without taking mutex_.
+  {
+    auto result = LookupTabletByKeyFastPath(table, partition_start);
+    if (result && result->HasLeader()) {
+      VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
+      callback(result);
+      return;
+    }
+  }
 
-  rpc::Rpcs::Handle rpc;
   {
     std::shared_lock<boost::shared_mutex> lock(mutex_);
     if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
@@ -1006,8 +1085,8 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
     }
   }
 
-  const std::string& partition_group_start =
-      table->FindPartitionStart(partition_start, kPartitionGroupSize);
+  const auto& partition_group_start =
+      YBTable::FindPartitionStart(*partitions, partition_start, kPartitionGroupSize);
   {
     std::unique_lock<boost::shared_mutex> lock(mutex_);
     if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
@@ -1017,7 +1096,22 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
     auto& table_data = tables_[table->id()];
     auto& lookup = table_data.tablet_lookups_by_group[partition_group_start];
     bool was_empty = lookup.empty();
-    lookup[partition_start].push_back({std::move(callback), deadline});
+    // Table partitions could be outdated after a tablet split, in this case the found tablet
+    // covers only the beginning of the old partition. Its end is the start of the next partition,
+    // so repeat the lookup after learning it.
+    auto checked_callback = [meta_cache = scoped_refptr<MetaCache>(this), table, partition_key,
+                             deadline, callback = std::move(callback)](
+        const Result<RemoteTabletPtr>& result) {
+      if (result.ok() && !(*result)->partition().ContainsKey(partition_key) &&
+          !(*result)->partition().partition_key_end().empty() &&
+          partition_key >= (*result)->partition().partition_key_end()) {
+        table->AddPartitionStart((*result)->partition().partition_key_end());
+        meta_cache->LookupTabletByKey(table, partition_key, deadline, callback);
+        return;
+      }
+      callback(result);
+    };
+    lookup[partition_start].push_back({std::move(checked_callback), deadline});
     if (!was_empty) {
       return;
     }
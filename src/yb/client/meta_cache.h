@@ -58,6 +58,7 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/capabilities.h"
+#include "yb/util/concurrent_value.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 #include "yb/util/semaphore.h"
@@ -390,6 +391,7 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   friend class LookupByIdRpc;
 
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
+  FRIEND_TEST(client::ClientTest, BenchmarkConcurrentLookupTabletByKey);
 
   // Lookup the given tablet by key, only consulting local information.
   // Returns true and sets *remote_tablet if successful.
@@ -397,6 +399,17 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       const YBTable* table,
       const std::string& partition_key) REQUIRES_SHARED(mutex_);
 
+  // Same as LookupTabletByKeyFastPathUnlocked, but uses table_snapshots_, so does not require
+  // mutex_.
+  RemoteTabletPtr LookupTabletByKeyFastPath(const YBTable* table, const std::string& partition_key);
+
+  struct TabletsByPartitionSnapshot;
+  typedef std::vector<std::pair<TableId, TabletsByPartitionSnapshot>> TableSnapshotUpdates;
+
+  // Publishes snapshots taken under mutex_ to table_snapshots_. It waits for the readers of
+  // table_snapshots_, so it should be called after mutex_ is released.
+  void PublishTabletsByPartition(TableSnapshotUpdates updates) EXCLUDES(mutex_);
+
   RemoteTabletPtr LookupTabletByIdFastPath(const TabletId& tablet_id);
 
   // Update our information about the given tablet server.
@@ -449,13 +462,35 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   typedef std::string PartitionKey;
   typedef std::string PartitionGroupKey;
 
+  typedef std::unordered_map<PartitionKey, RemoteTabletPtr> TabletsByPartition;
+
+  // Immutable copy of tablets_by_partition of a table, taken under mutex_.
+  struct TabletsByPartitionSnapshot {
+    // Snapshots are published after mutex_ is released, so a snapshot could be published after a
+    // newer one. The version tells which one should be kept.
+    int64_t version;
+    std::shared_ptr<const TabletsByPartition> tablets;
+  };
+
   struct TableData {
-    std::unordered_map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+    TabletsByPartition tablets_by_partition;
     std::unordered_map<PartitionGroupKey, PartitionToLookupData> tablet_lookups_by_group;
   };
 
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Version of the last snapshot taken from tables_.
+  int64_t last_snapshot_version_ GUARDED_BY(mutex_) = 0;
+
+  // Snapshots of all tables that have cached tablets. Lookups by partition key are done on each
+  // operation applied to a session, so they use these snapshots instead of taking mutex_.
+  // Publishing copies only the map of tables, partition maps of the tables are shared.
+  typedef std::unordered_map<TableId, TabletsByPartitionSnapshot> TableSnapshots;
+  ConcurrentValue<TableSnapshots> table_snapshots_;
+
+  // Serializes publishers of table_snapshots_.
+  std::mutex publish_mutex_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<std::string, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
@@ -185,7 +185,7 @@ Result<int32_t> KeyValueTableTest::SelectRow(
 Result<std::map<int32_t, int32_t>> KeyValueTableTest::SelectAllRows(
     TableHandle* table, const YBSessionPtr& session) {
   std::vector<YBqlReadOpPtr> ops;
-  auto partitions = table->table()->GetPartitions();
+  auto partitions = *table->table()->GetPartitions();
   partitions.push_back(std::string()); // Upper bound for last partition.
 
   uint16_t prev_code = 0;
@@ -363,7 +363,7 @@ void QLStressTest::TestRetryWrites(bool restarts) {
       std::bind(&QLStressTest::CheckRetryableRequestsCounts, this, &total_entries, &total_leaders),
       15s, "Retryable requests cleanup"));
 
-  ASSERT_EQ(total_leaders, table_.table()->GetPartitions().size());
+  ASSERT_EQ(total_leaders, table_.table()->GetPartitions()->size());
 
   // We have 2 entries per row.
   if (FLAGS_detect_duplicates_for_retryable_requests) {
@@ -72,6 +72,7 @@ DECLARE_int32(tablet_inject_latency_on_apply_write_txn_ms);
 DECLARE_bool(TEST_log_cache_skip_eviction);
 DECLARE_uint64(sst_files_hard_limit);
 DECLARE_uint64(sst_files_soft_limit);
+DECLARE_bool(TEST_reject_tablet_split);
 
 namespace yb {
 namespace client {
@@ -1020,5 +1021,83 @@ TEST_F(QLTabletTest, OperationMemTracking) {
   ASSERT_TRUE(tracked_by_log_cache);
 }
 
+class QLTabletSplitTest : public QLTabletTest {
+ protected:
+  void FillAndFlushSingleTablet() {
+    CreateTable(kTable1Name, &table1_, 1);
+    FillTable(0, kTotalKeys, &table1_);
+    ASSERT_OK(cluster_->FlushTablets());
+  }
+
+  master::CatalogManager& catalog_manager() {
+    return *cluster_->leader_mini_master()->master()->catalog_manager();
+  }
+
+  CHECKED_STATUS WaitForSplit(const scoped_refptr<master::TabletInfo>& source_tablet) {
+    return WaitFor([this, &source_tablet] {
+      return source_tablet->LockForRead()->data().is_deleted() &&
+             GetTabletInfos(kTable1Name).size() == 2;
+    }, 30s * kTimeMultiplier, "Wait for tablet split");
+  }
+
+  // Split tablet rejects requests, so the client switches to the new tablets.
+  void VerifyAfterSplit() {
+    VerifyTable(0, kTotalKeys, &table1_);
+    {
+      auto session = CreateSession();
+      for (int i = kTotalKeys; i != 2 * kTotalKeys; ++i) {
+        SetValue(session, i, ValueForKey(i), &table1_);
+      }
+    }
+    VerifyTable(0, 2 * kTotalKeys, &table1_);
+  }
+};
+
+TEST_F(QLTabletSplitTest, SplitTablet) {
+  FillAndFlushSingleTablet();
+  auto tablets = GetTabletInfos(kTable1Name);
+  ASSERT_EQ(1, tablets.size());
+  const auto source_tablet = tablets[0];
+
+  ASSERT_OK(catalog_manager().SplitTablet(source_tablet->tablet_id()));
+  ASSERT_NOK(catalog_manager().SplitTablet(source_tablet->tablet_id()));
+  ASSERT_OK(WaitForSplit(source_tablet));
+
+  for (const auto& tablet : GetTabletInfos(kTable1Name)) {
+    auto lock = tablet->LockForRead();
+    ASSERT_TRUE(lock->data().is_running()) << tablet->ToString();
+    ASSERT_EQ(source_tablet->tablet_id(), lock->data().pb.split_parent_tablet_id());
+  }
+  ASSERT_NO_FATALS(VerifyAfterSplit());
+}
+
+TEST_F(QLTabletSplitTest, RollbackRejectedSplit) {
+  FillAndFlushSingleTablet();
+  auto tablets = GetTabletInfos(kTable1Name);
+  ASSERT_EQ(1, tablets.size());
+  const auto source_tablet = tablets[0];
+
+  FLAGS_TEST_reject_tablet_split = true;
+  ASSERT_OK(catalog_manager().SplitTablet(source_tablet->tablet_id()));
+  ASSERT_OK(WaitFor([&source_tablet] {
+    return !source_tablet->HasSplitTasks();
+  }, 30s * kTimeMultiplier, "Wait for split tasks"));
+
+  // Rejected split is rolled back, so the tablet continues to serve requests.
+  {
+    auto lock = source_tablet->LockForRead();
+    ASSERT_TRUE(lock->data().is_running());
+    ASSERT_EQ(0, lock->data().pb.split_tablet_ids_size());
+  }
+  ASSERT_EQ(1, GetTabletInfos(kTable1Name).size());
+  VerifyTable(0, kTotalKeys, &table1_);
+
+  // Tablet could be split again after the rollback.
+  FLAGS_TEST_reject_tablet_split = false;
+  ASSERT_OK(catalog_manager().SplitTablet(source_tablet->tablet_id()));
+  ASSERT_OK(WaitForSplit(source_tablet));
+  ASSERT_NO_FATALS(VerifyAfterSplit());
+}
+
 } // namespace client
 } // namespace yb
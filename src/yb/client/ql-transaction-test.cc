@@ -60,6 +60,7 @@ DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(delay_init_tablet_peer_ms);
 DECLARE_bool(fail_in_apply_if_no_metadata);
+DECLARE_int32(txn_max_apply_batch_records);
 
 namespace yb {
 namespace client {
@@ -103,6 +104,17 @@ TEST_F(QLTransactionTest, Simple) {
   CheckNoRunningTransactions();
 }
 
+// Apply and remove intents of each transaction in several small batches.
+TEST_F(QLTransactionTest, ApplyInBatches) {
+  FLAGS_txn_max_apply_batch_records = 3;
+  ASSERT_NO_FATALS(WriteData());
+  ASSERT_NO_FATALS(VerifyData());
+  ASSERT_OK(WaitIntentsCleaned());
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_NO_FATALS(VerifyData());
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, LookupTabletFailure) {
   FLAGS_master_inject_latency_on_transactional_tablet_lookups_ms =
       TransactionRpcTimeout().ToMilliseconds() + 500;
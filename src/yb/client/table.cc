@@ -74,7 +74,8 @@ YBTable::YBTable(client::YBClient* client, const YBTableInfo& info)
     : client_(client),
       // The table type is set after the table is opened.
       table_type_(YBTableType::UNKNOWN_TABLE_TYPE),
-      info_(info) {
+      info_(info),
+      partitions_(std::make_shared<const std::vector<std::string>>()) {
 }
 
 YBTable::~YBTable() {
@@ -123,8 +124,23 @@ const PartitionSchema& YBTable::partition_schema() const {
   return info_.partition_schema;
 }
 
-const std::vector<std::string>& YBTable::GetPartitions() const {
-  return partitions_;
+YBTable::PartitionsPtr YBTable::GetPartitions() const {
+  return *partitions_.get();
+}
+
+void YBTable::AddPartitionStart(const std::string& partition_start) const {
+  std::lock_guard<std::mutex> lock(partitions_update_mutex_);
+  auto current_partitions = GetPartitions();
+  auto it = std::lower_bound(
+      current_partitions->begin(), current_partitions->end(), partition_start);
+  if (it == current_partitions->end() || *it != partition_start) {
+    auto partitions = std::make_shared<std::vector<std::string>>();
+    partitions->reserve(current_partitions->size() + 1);
+    partitions->insert(partitions->end(), current_partitions->begin(), it);
+    partitions->push_back(partition_start);
+    partitions->insert(partitions->end(), it, current_partitions->end());
+    partitions_.Set(PartitionsPtr(std::move(partitions)));
+  }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -153,18 +169,25 @@ YBqlReadOp* YBTable::NewQLRead() {
   return new YBqlReadOp(shared_from_this());
 }
 
-const std::string& YBTable::FindPartitionStart(
+std::string YBTable::FindPartitionStart(
     const std::string& partition_key, size_t group_by) const {
-  auto it = std::lower_bound(partitions_.begin(), partitions_.end(), partition_key);
-  if (it == partitions_.end() || *it > partition_key) {
-    DCHECK(it != partitions_.begin());
+  auto partitions = partitions_.get();
+  return FindPartitionStart(**partitions, partition_key, group_by);
+}
+
+const std::string& YBTable::FindPartitionStart(
+    const std::vector<std::string>& partitions, const std::string& partition_key,
+    size_t group_by) {
+  auto it = std::lower_bound(partitions.begin(), partitions.end(), partition_key);
+  if (it == partitions.end() || *it > partition_key) {
+    DCHECK(it != partitions.begin());
     --it;
   }
   if (group_by <= 1) {
     return *it;
   }
-  size_t idx = (it - partitions_.begin()) / group_by * group_by;
-  return partitions_[idx];
+  size_t idx = (it - partitions.begin()) / group_by * group_by;
+  return partitions[idx];
 }
 
 Status YBTable::Open() {
@@ -244,13 +267,15 @@ Status YBTable::Open() {
     if (!s.ok()) {
       YB_LOG_EVERY_N_SECS(WARNING, 10) << "Error getting table locations: " << s << ", retrying.";
     } else if (resp.tablet_locations_size() > 0) {
-      DCHECK(partitions_.empty());
-      partitions_.clear();
-      partitions_.reserve(resp.tablet_locations().size());
+      auto partitions = std::make_shared<std::vector<std::string>>();
+      partitions->reserve(resp.tablet_locations().size());
       for (const auto& tablet_location : resp.tablet_locations()) {
-        partitions_.push_back(tablet_location.partition().partition_key_start());
+        partitions->push_back(tablet_location.partition().partition_key_start());
       }
-      std::sort(partitions_.begin(), partitions_.end());
+      std::sort(partitions->begin(), partitions->end());
+      std::lock_guard<std::mutex> lock(partitions_update_mutex_);
+      DCHECK(GetPartitions()->empty());
+      partitions_.Set(PartitionsPtr(std::move(partitions)));
       break;
     }
 
@@ -21,6 +21,8 @@
 #include "yb/common/index.h"
 #include "yb/common/partition.h"
 
+#include "yb/util/concurrent_value.h"
+
 DECLARE_int32(max_num_tablets_for_table);
 
 namespace yb {
@@ -78,7 +80,16 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
   const Schema& InternalSchema() const;
   const PartitionSchema& partition_schema() const;
 
-  const std::vector<std::string>& GetPartitions() const;
+  typedef std::shared_ptr<const std::vector<std::string>> PartitionsPtr;
+
+  // Returns the sorted partition starts. A tablet split replaces them with an extended list, so
+  // the returned list stays valid while the pointer is held, but is not updated.
+  PartitionsPtr GetPartitions() const;
+
+  // Adds the start of a partition created by a tablet split. Does nothing if it is already known.
+  // Partitions are a client side cache of the table state, so they could be updated for a const
+  // table.
+  void AddPartitionStart(const std::string& partition_start) const;
 
   // Indexes available on the table.
   const IndexMap& index_map() const;
@@ -102,9 +113,15 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
 
   // Finds partition start for specified partition_key.
   // Partitions could be groupped by group_by bunches, in this case start of such bunch is returned.
-  const std::string& FindPartitionStart(
+  std::string FindPartitionStart(
       const std::string& partition_key, size_t group_by = 1) const;
 
+  // Same as above, but in the given partitions, so a reference to the partition start could be
+  // returned.
+  static const std::string& FindPartitionStart(
+      const std::vector<std::string>& partitions, const std::string& partition_key,
+      size_t group_by = 1);
+
   //------------------------------------------------------------------------------------------------
   // Postgres support
   // Create a new QL operation for this table.
@@ -127,7 +144,12 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
   client::YBClient* const client_;
   YBTableType table_type_;
   YBTableInfo info_;
-  std::vector<std::string> partitions_;
+
+  // Sorted partition starts. Read on each tablet lookup, so they are published through
+  // ConcurrentValue to avoid taking a lock on this path. Writers are serialized by
+  // partitions_update_mutex_.
+  mutable ConcurrentValue<PartitionsPtr> partitions_;
+  mutable std::mutex partitions_update_mutex_;
 
   DISALLOW_COPY_AND_ASSIGN(YBTable);
 };
@@ -268,6 +268,18 @@ bool TabletInvoker::Done(Status* status) {
     *status = resp_error_status;
   }
 
+  // The tablet was split, so operations should be regrouped by the new tablets. Drop the cached
+  // tablet locations and ask the caller to retry, since this invoker is bound to the old tablet.
+  if (ErrorCode(rsp_err) == tserver::TabletServerErrorPB::TABLET_SPLIT) {
+    VLOG(1) << "Tablet " << tablet_id_ << " was split: " << *status;
+    if (tablet_) {
+      tablet_->MarkStale();
+    }
+    *status = STATUS_FORMAT(TryAgain, "Tablet $0 was split", tablet_id_);
+    rpc_->Failed(*status);
+    return true;
+  }
+
   // Oops, we failed over to a replica that wasn't a LEADER. Unlikely as
   // we're using consensus configuration information from the master, but still possible
   // (e.g. leader restarted and became a FOLLOWER). Try again.
@@ -555,6 +555,14 @@ YBPgsqlReadOp *YBPgsqlReadOp::NewSelect(const shared_ptr<YBTable>& table) {
   return op;
 }
 
+std::unique_ptr<YBPgsqlReadOp> YBPgsqlReadOp::DeepCopy() const {
+  std::unique_ptr<YBPgsqlReadOp> op(new YBPgsqlReadOp(table_));
+  *op->mutable_request() = request();
+  op->set_yb_consistency_level(yb_consistency_level_);
+  op->SetReadTime(read_time_);
+  return op;
+}
+
 std::string YBPgsqlReadOp::ToString() const {
   return "PGSQL_READ " + read_request_->DebugString();
 }
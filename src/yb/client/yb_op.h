@@ -459,6 +459,10 @@ class YBPgsqlReadOp : public YBPgsqlOp {
 
   static YBPgsqlReadOp *NewSelect(const std::shared_ptr<YBTable>& table);
 
+  // Create a new read operation on the same table with a copy of this operation's request,
+  // consistency level and read time. The response is not copied.
+  std::unique_ptr<YBPgsqlReadOp> DeepCopy() const;
+
   // Note: to avoid memory copy, this PgsqlReadRequestPB is moved into tserver ReadRequestPB
   // when the request is sent to tserver. It is restored after response is received from tserver
   // (see ReadRpc's constructor).
@@ -32,6 +32,7 @@
 #ifndef YB_CONSENSUS_CONSENSUS_H_
 #define YB_CONSENSUS_CONSENSUS_H_
 
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -350,6 +351,14 @@ class Consensus {
 
   virtual void UpdateCDCConsumerOpId(const yb::OpId& op_id) = 0;
 
+  // Registers a one-shot listener, that is invoked when an operation with index greater than
+  // 'min_index' becomes majority replicated. Returns 0 when such operation is already majority
+  // replicated and the listener was not registered, otherwise returns the listener id.
+  virtual int64_t AddMajorityReplicatedListener(
+      int64_t min_index, std::function<void()> listener) = 0;
+
+  virtual void RemoveMajorityReplicatedListener(int64_t listener_id) = 0;
+
  protected:
   friend class RefCountedThreadSafe<Consensus>;
   friend class tablet::TabletPeer;
@@ -35,6 +35,7 @@
 #include <shared_mutex>
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -614,6 +615,43 @@ void PeerMessageQueue::UpdateCDCConsumerOpId(const yb::OpId& op_id) {
   cdc_consumer_op_id_last_updated_ = CoarseMonoClock::Now();
 }
 
+int64_t PeerMessageQueue::AddMajorityReplicatedListener(
+    int64_t min_index, std::function<void()> listener) {
+  LockGuard lock(queue_lock_);
+  if (queue_state_.state == State::kQueueClosed ||
+      queue_state_.majority_replicated_opid.index() > min_index) {
+    return 0;
+  }
+  auto id = next_majority_replicated_listener_id_++;
+  majority_replicated_listeners_.emplace(
+      id, MajorityReplicatedListener{min_index, std::move(listener)});
+  return id;
+}
+
+void PeerMessageQueue::RemoveMajorityReplicatedListener(int64_t listener_id) {
+  LockGuard lock(queue_lock_);
+  majority_replicated_listeners_.erase(listener_id);
+}
+
+void PeerMessageQueue::NotifyMajorityReplicatedListeners(int64_t index) {
+  std::vector<std::function<void()>> callbacks;
+  {
+    LockGuard lock(queue_lock_);
+    for (auto it = majority_replicated_listeners_.begin();
+         it != majority_replicated_listeners_.end();) {
+      if (it->second.min_index < index) {
+        callbacks.push_back(std::move(it->second.callback));
+        it = majority_replicated_listeners_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto& callback : callbacks) {
+    callback();
+  }
+}
+
 yb::OpId PeerMessageQueue::GetCDCConsumerOpIdToEvict() {
   std::shared_lock<rw_spinlock> l(cdc_consumer_lock_);
   // For log cache eviction, we only want to include CDC consumers that are actively polling.
@@ -1111,8 +1149,12 @@ void PeerMessageQueue::ClearUnlocked() {
 
 void PeerMessageQueue::Close() {
   raft_pool_observers_token_->Shutdown();
-  LockGuard lock(queue_lock_);
-  ClearUnlocked();
+  {
+    LockGuard lock(queue_lock_);
+    ClearUnlocked();
+  }
+  // Wake up everybody still waiting for new operations, they will not be notified anymore.
+  NotifyMajorityReplicatedListeners(std::numeric_limits<int64_t>::max());
 }
 
 string PeerMessageQueue::ToString() const {
@@ -1219,6 +1261,8 @@ void PeerMessageQueue::NotifyObserversOfMajorityReplOpChangeTask(
       queue_state_.committed_index.CopyFrom(new_committed_index);
     }
   }
+
+  NotifyMajorityReplicatedListeners(majority_replicated_data.op_id.index());
 }
 
 void PeerMessageQueue::NotifyObserversOfTermChangeTask(int64_t term) {
@@ -33,6 +33,7 @@
 #ifndef YB_CONSENSUS_CONSENSUS_QUEUE_H_
 #define YB_CONSENSUS_CONSENSUS_QUEUE_H_
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -322,6 +323,15 @@ class PeerMessageQueue {
 
   void UpdateCDCConsumerOpId(const yb::OpId& op_id);
 
+  // Registers a listener that is invoked once, when an operation with index greater than
+  // 'min_index' is majority replicated or the queue is closed. Returns 0 without registering the
+  // listener if such an operation is already majority replicated, otherwise returns an id that
+  // could be used to remove the listener. The listener is invoked on the thread that notifies
+  // observers, so it should not block.
+  int64_t AddMajorityReplicatedListener(int64_t min_index, std::function<void()> listener);
+
+  void RemoveMajorityReplicatedListener(int64_t listener_id);
+
   // Get the maximum op ID that can be evicted for CDC consumer from log cache.
   yb::OpId GetCDCConsumerOpIdToEvict();
 
@@ -464,6 +474,10 @@ class PeerMessageQueue {
                                          int max_batch_size,
                                          const std::string& peer_uuid);
 
+  // Invokes and removes majority replicated listeners, that are waiting for operations with index
+  // less than or equal to 'index'.
+  void NotifyMajorityReplicatedListeners(int64_t index);
+
   std::vector<PeerMessageQueueObserver*> observers_;
 
   // The pool token which executes observer notifications.
@@ -499,6 +513,15 @@ class PeerMessageQueue {
 
   ConsensusContext* context_ = nullptr;
 
+  struct MajorityReplicatedListener {
+    int64_t min_index;
+    std::function<void()> callback;
+  };
+
+  // Protected by queue_lock_.
+  std::unordered_map<int64_t, MajorityReplicatedListener> majority_replicated_listeners_;
+  int64_t next_majority_replicated_listener_id_ = 1;
+
   // Used to protect cdc_consumer_op_id_ and cdc_consumer_op_id_last_updated_.
   mutable rw_spinlock cdc_consumer_lock_;
   yb::OpId cdc_consumer_op_id_ = yb::OpId::Max();
@@ -56,6 +56,7 @@ DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
+DECLARE_string(log_compression_type);
 
 namespace yb {
 namespace log {
@@ -207,6 +208,53 @@ TEST_F(LogTest, TestMultipleEntriesInABatch) {
   ASSERT_OK(log_->Close());
 }
 
+// Entries of segments written with a compression codec should be read back intact, and the codec
+// should be taken from the segment header rather than from the current flag value.
+TEST_F(LogTest, TestCompressedSegments) {
+  const int kNumEntries = 100;
+  const std::vector<std::string> kCompressionTypes = {
+      "SNAPPY_COMPRESSION", "LZ4_COMPRESSION", "NO_COMPRESSION"};
+
+  FLAGS_log_compression_type = kCompressionTypes[0];
+  BuildLog();
+
+  OpId opid = MakeOpId(1, 1);
+  for (const auto& compression_type : kCompressionTypes) {
+    FLAGS_log_compression_type = compression_type;
+    // Segments pick up the codec when they are allocated.
+    ASSERT_OK(log_->AllocateSegmentAndRollOver());
+    ASSERT_OK(AppendNoOps(&opid, kNumEntries));
+  }
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+
+  int64_t expected_index = 1;
+  std::vector<std::string> segment_compression_types;
+  for (const auto& segment : segments) {
+    auto read_entries = segment->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    if (read_entries.entries.empty()) {
+      continue;
+    }
+    segment_compression_types.push_back(
+        LogCompressionTypePB_Name(segment->header().compression_type()));
+    for (const auto& entry : read_entries.entries) {
+      ASSERT_EQ(expected_index, entry->replicate().id().index());
+      ++expected_index;
+    }
+  }
+  ASSERT_EQ(kCompressionTypes, segment_compression_types);
+  ASSERT_EQ(kNumEntries * static_cast<int64_t>(kCompressionTypes.size()) + 1, expected_index);
+
+  // Entries of compressed segments could also be looked up through the log index.
+  auto loaded_op = ASSERT_RESULT(log_->GetLogReader()->LookupOpId(kNumEntries / 2));
+  ASSERT_EQ(yb::OpId(1, kNumEntries / 2), loaded_op);
+
+  ASSERT_OK(log_->Close());
+}
+
 // Tests that everything works properly with fsync enabled:
 // This also tests SyncDir() (see KUDU-261), which is called whenever
 // a new log segment is initialized.
@@ -153,6 +153,23 @@ static bool ValidateLogsToRetain(const char* flagname, int value) {
 static bool dummy = google::RegisterFlagValidator(
     &FLAGS_log_min_segments_to_retain, &ValidateLogsToRetain);
 
+DEFINE_string(log_compression_type, "NO_COMPRESSION",
+              "Codec used to compress entry batches of new log segments: NO_COMPRESSION, "
+              "SNAPPY_COMPRESSION or LZ4_COMPRESSION. Each segment records its codec, so "
+              "existing segments stay readable when this is changed.");
+TAG_FLAG(log_compression_type, advanced);
+
+static bool ValidateLogCompressionType(const char* flagname, const std::string& value) {
+  yb::log::LogCompressionTypePB type;
+  if (yb::log::LogCompressionTypePB_Parse(value, &type)) {
+    return true;
+  }
+  LOG(ERROR) << strings::Substitute("$0 has invalid value $1", flagname, value);
+  return false;
+}
+static bool dummy_log_compression_type = google::RegisterFlagValidator(
+    &FLAGS_log_compression_type, &ValidateLogCompressionType);
+
 static const char kSegmentPlaceholderFileTemplate[] = ".tmp.newsegmentXXXXXX";
 
 namespace yb {
@@ -814,6 +831,13 @@ yb::OpId Log::GetLatestEntryOpId() const {
   return last_synced_entry_op_id_.load(boost::memory_order_acquire);
 }
 
+void Log::SetLatestEntryOpId(const yb::OpId& op_id) {
+  std::lock_guard<std::mutex> write_lock(last_synced_entry_op_id_mutex_);
+  last_appended_entry_op_id_ = op_id;
+  last_synced_entry_op_id_.store(op_id, boost::memory_order_release);
+  last_synced_entry_op_id_cond_.notify_all();
+}
+
 yb::OpId Log::WaitForSafeOpIdToApply(const yb::OpId& min_allowed, MonoDelta duration) {
   if (FLAGS_log_consider_all_ops_safe || all_op_ids_safe_) {
     return min_allowed;
@@ -1079,6 +1103,10 @@ Status Log::SwitchToAllocatedSegment() {
   header.set_minor_version(kLogMinorVersion);
   header.set_sequence_number(active_segment_sequence_number_);
   header.set_tablet_id(tablet_id_);
+  LogCompressionTypePB compression_type;
+  if (LogCompressionTypePB_Parse(FLAGS_log_compression_type, &compression_type)) {
+    header.set_compression_type(compression_type);
+  }
 
   // Set up the new footer. This will be maintained as the segment is written.
   footer_builder_.Clear();
@@ -1210,6 +1238,11 @@ Status LogEntryBatch::Serialize() {
   }
   DCHECK_NE(entry_batch_pb_.mono_time(), 0);
   total_size_bytes_ = entry_batch_pb_.ByteSize();
+  // Readers reject larger batches as corrupted, so they should never reach the log.
+  if (PREDICT_FALSE(total_size_bytes_ > MaxEntryBatchSize())) {
+    return STATUS_FORMAT(InvalidArgument, "Entry batch is too big: $0, max: $1",
+                         total_size_bytes_, MaxEntryBatchSize());
+  }
   buffer_.reserve(total_size_bytes_);
 
   if (!pb_util::AppendToString(entry_batch_pb_, &buffer_)) {
@@ -192,6 +192,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // returns (0, 0)
   yb::OpId GetLatestEntryOpId() const;
 
+  // Sets the last-used OpId, when entries of existing segments were not replayed through Append,
+  // e.g. when bootstrap restores the state recorded at clean shutdown.
+  void SetLatestEntryOpId(const yb::OpId& op_id);
+
   // Runs the garbage collector on the set of previous segments. Segments that only refer to in-mem
   // state that has been flushed are candidates for garbage collection.
   //
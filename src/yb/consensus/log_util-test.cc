@@ -14,8 +14,12 @@
 #include <gtest/gtest.h>
 
 #include "yb/consensus/log_util.h"
+#include "yb/util/coding.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_macros.h"
 
+DECLARE_int32(rpc_max_message_size);
+
 namespace yb {
 
 #if defined(__linux__)
@@ -47,4 +51,35 @@ TEST(TestLogUtil, TestModifyDurableWriteFlagIfNotODirectPositive) {
   FLAGS_durable_wal_write = false;
   ASSERT_OK(log::ModifyDurableWriteFlagIfNotODirect());
 }
+
+TEST(TestLogUtil, TestUncompressEntryBatchSizeLimit) {
+  gflags::FlagSaver flag_saver;
+  const std::string data(1000, 'x');
+  for (auto compression_type : {log::SNAPPY_COMPRESSION, log::LZ4_COMPRESSION}) {
+    faststring compressed;
+    ASSERT_OK(log::CompressEntryBatch(compression_type, data, &compressed));
+    faststring uncompressed;
+    ASSERT_OK(log::UncompressEntryBatch(compression_type, Slice(compressed), &uncompressed));
+    ASSERT_EQ(data, uncompressed.ToString());
+
+    // The uncompressed size is checked before the output buffer is allocated.
+    FLAGS_rpc_max_message_size = 999;
+    auto status = log::UncompressEntryBatch(compression_type, Slice(compressed), &uncompressed);
+    ASSERT_TRUE(status.IsCorruption()) << status;
+    FLAGS_rpc_max_message_size = 1000;
+
+    // Size prefix damaged to a huge value.
+    EncodeFixed32(compressed.data(), 0xffffffff);
+    status = log::UncompressEntryBatch(compression_type, Slice(compressed), &uncompressed);
+    ASSERT_TRUE(status.IsCorruption()) << status;
+    ASSERT_LT(uncompressed.capacity(), 1_MB);
+
+    // The writer does not produce batches that the reader would reject.
+    FLAGS_rpc_max_message_size = 999;
+    status = log::CompressEntryBatch(compression_type, data, &compressed);
+    ASSERT_TRUE(status.IsInvalidArgument()) << status;
+    FLAGS_rpc_max_message_size = 1000;
+  }
+}
+
 } // namespace yb
@@ -39,9 +39,12 @@
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
+#include <lz4.h>
+#include <snappy.h>
 
 #include "yb/consensus/opid_util.h"
 #include "yb/fs/fs_manager.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/split.h"
@@ -88,6 +91,7 @@ DEFINE_bool(log_async_preallocate_segments, true,
 TAG_FLAG(log_async_preallocate_segments, advanced);
 
 DECLARE_string(fs_data_dirs);
+DECLARE_int32(rpc_max_message_size);
 
 DEFINE_bool(require_durable_wal_write, false, "Whether durable WAL write is required."
     "In case you cannot write using O_DIRECT in WAL and data directories and this flag is set true"
@@ -122,11 +126,101 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 const size_t kEntryHeaderSize = 12;
 
 const int kLogMajorVersion = 1;
-const int kLogMinorVersion = 0;
+// Minor version 1 segments may have compressed entry batches, see
+// LogSegmentHeaderPB::compression_type.
+const int kLogMinorVersion = 1;
 
 // Maximum log segment header/footer size, in bytes (8 MB).
 const uint32_t kLogSegmentMaxHeaderOrFooterSize = 8 * 1024 * 1024;
 
+namespace {
+
+// Size of the uncompressed length prefix of a compressed entry batch.
+const size_t kUncompressedLengthSize = 4;
+
+} // namespace
+
+size_t MaxEntryBatchSize() {
+  return FLAGS_rpc_max_message_size;
+}
+
+Status CompressEntryBatch(LogCompressionTypePB compression_type, const Slice& data,
+                          faststring* out) {
+  if (data.size() > MaxEntryBatchSize()) {
+    return STATUS_FORMAT(InvalidArgument, "Entry batch is too big to compress: $0, max: $1",
+                         data.size(), MaxEntryBatchSize());
+  }
+  out->clear();
+  PutFixed32(out, data.size());
+  switch (compression_type) {
+    case SNAPPY_COMPRESSION: {
+      out->resize(kUncompressedLengthSize + snappy::MaxCompressedLength(data.size()));
+      size_t compressed_size = 0;
+      snappy::RawCompress(data.cdata(), data.size(),
+                          pointer_cast<char*>(out->data() + kUncompressedLengthSize),
+                          &compressed_size);
+      out->resize(kUncompressedLengthSize + compressed_size);
+      return Status::OK();
+    }
+    case LZ4_COMPRESSION: {
+      const int max_compressed_size = LZ4_compressBound(data.size());
+      out->resize(kUncompressedLengthSize + max_compressed_size);
+      const int compressed_size = LZ4_compress_default(
+          data.cdata(), pointer_cast<char*>(out->data() + kUncompressedLengthSize), data.size(),
+          max_compressed_size);
+      if (compressed_size <= 0) {
+        return STATUS_FORMAT(RuntimeError, "LZ4 failed to compress $0 bytes", data.size());
+      }
+      out->resize(kUncompressedLengthSize + compressed_size);
+      return Status::OK();
+    }
+    case NO_COMPRESSION:
+      break;
+  }
+  return STATUS_FORMAT(InvalidArgument, "Unexpected log compression type: $0",
+                       LogCompressionTypePB_Name(compression_type));
+}
+
+Status UncompressEntryBatch(LogCompressionTypePB compression_type, const Slice& data,
+                            faststring* out) {
+  if (data.size() < kUncompressedLengthSize) {
+    return STATUS_FORMAT(Corruption, "Compressed entry batch is too short: $0 bytes", data.size());
+  }
+  const uint32_t uncompressed_size = DecodeFixed32(data.data());
+  // The writer never stores a larger batch, so a larger length could only come from a corrupted
+  // segment. Check it before allocating the output buffer.
+  if (uncompressed_size > MaxEntryBatchSize()) {
+    return STATUS_FORMAT(Corruption, "Uncompressed entry batch size is too big: $0, max: $1",
+                         uncompressed_size, MaxEntryBatchSize());
+  }
+  const char* compressed = data.cdata() + kUncompressedLengthSize;
+  const size_t compressed_size = data.size() - kUncompressedLengthSize;
+  out->resize(uncompressed_size);
+  switch (compression_type) {
+    case SNAPPY_COMPRESSION: {
+      size_t expected_size = 0;
+      if (!snappy::GetUncompressedLength(compressed, compressed_size, &expected_size) ||
+          expected_size != uncompressed_size ||
+          !snappy::RawUncompress(compressed, compressed_size, pointer_cast<char*>(out->data()))) {
+        return STATUS(Corruption, "Failed to uncompress Snappy entry batch");
+      }
+      return Status::OK();
+    }
+    case LZ4_COMPRESSION: {
+      const int size = LZ4_decompress_safe(
+          compressed, pointer_cast<char*>(out->data()), compressed_size, uncompressed_size);
+      if (size < 0 || static_cast<uint32_t>(size) != uncompressed_size) {
+        return STATUS(Corruption, "Failed to uncompress LZ4 entry batch");
+      }
+      return Status::OK();
+    }
+    case NO_COMPRESSION:
+      break;
+  }
+  return STATUS_FORMAT(Corruption, "Unexpected log compression type: $0",
+                       LogCompressionTypePB_Name(compression_type));
+}
+
 LogOptions::LogOptions()
     : segment_size_bytes(FLAGS_log_segment_size_bytes == 0 ? FLAGS_log_segment_size_mb * 1_MB
                                                            : FLAGS_log_segment_size_bytes),
@@ -822,10 +916,19 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
   }
 
 
+  Slice entry_batch_data = entry_batch_slice;
+  faststring uncompressed_buf;
+  if (header_.compression_type() != NO_COMPRESSION) {
+    RETURN_NOT_OK_PREPEND(
+        UncompressEntryBatch(header_.compression_type(), entry_batch_slice, &uncompressed_buf),
+        Substitute("Could not read entry at offset $0 in $1", *offset, path_));
+    entry_batch_data = Slice(uncompressed_buf);
+  }
+
   LogEntryBatchPB read_entry_batch;
   s = pb_util::ParseFromArray(&read_entry_batch,
-                              entry_batch_slice.data(),
-                              header.msg_length);
+                              entry_batch_data.data(),
+                              entry_batch_data.size());
 
   if (!s.ok()) return STATUS(Corruption, Substitute("Could parse PB. Cause: $0",
                                                     s.ToString()));
@@ -896,9 +999,15 @@ Status WritableLogSegment::WriteFooterAndClose(const LogSegmentFooterPB& footer)
 }
 
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
+  Slice data = entry_batch_data;
+  if (header_.compression_type() != NO_COMPRESSION) {
+    RETURN_NOT_OK(CompressEntryBatch(header_.compression_type(), data, &compression_buf_));
+    data = Slice(compression_buf_);
+  }
+
   uint8_t header_buf[kEntryHeaderSize];
 
   // First encode the length of the message.
@@ -48,6 +48,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/atomic.h"
 #include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
@@ -217,6 +218,12 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
     return footer_.IsInitialized();
   }
 
+  // Returns true if the footer was not written when the segment was closed, but rebuilt by
+  // scanning the entries.
+  bool footer_was_rebuilt() const {
+    return footer_was_rebuilt_;
+  }
+
   // Returns this log segment's footer.
   //
   // If HasFooter() returns false this cannot be called.
@@ -447,6 +454,9 @@ class WritableLogSegment {
   // The offset where the last written entry ends.
   int64_t written_offset_;
 
+  // Reusable buffer for compressed entry batches, when the segment is compressed.
+  faststring compression_buf_;
+
   DISALLOW_COPY_AND_ASSIGN(WritableLogSegment);
 };
 
@@ -458,6 +468,18 @@ using consensus::ReplicateMsgs;
 // in some hot paths.
 LogEntryBatchPB CreateBatchFromAllocatedOperations(const ReplicateMsgs& msgs);
 
+// Maximum size of a serialized entry batch. Entry batches hold replicated operations, which are
+// bounded by the RPC message size.
+size_t MaxEntryBatchSize();
+
+// Stores 'data' compressed with 'compression_type' to 'out', prefixed with its uncompressed size.
+CHECKED_STATUS CompressEntryBatch(
+    LogCompressionTypePB compression_type, const Slice& data, faststring* out);
+
+// Reverses CompressEntryBatch. Returns Corruption if 'data' could not be uncompressed.
+CHECKED_STATUS UncompressEntryBatch(
+    LogCompressionTypePB compression_type, const Slice& data, faststring* out);
+
 // Checks if 'fname' is a correctly formatted name of log segment file.
 bool IsLogFileName(const std::string& fname);
 
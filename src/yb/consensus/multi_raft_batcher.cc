@@ -0,0 +1,218 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <gflags/gflags.h>
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_header.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+using namespace std::literals;
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Whether heartbeats of idle tablets that are sent to the same server should be "
+            "coalesced into a single RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_window_ms, 10,
+             "How long heartbeats are collected before a batch is sent to the remote server.");
+TAG_FLAG(multi_raft_heartbeat_window_ms, advanced);
+TAG_FLAG(multi_raft_heartbeat_window_ms, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger)
+    : hostport_(hostport),
+      messenger_(messenger),
+      consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB* request,
+                                                  ConsensusResponsePB* response,
+                                                  rpc::RpcController* controller,
+                                                  const rpc::ResponseCallback& callback) {
+  bool new_batch = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<Batch>();
+      new_batch = true;
+    }
+    // We use AddAllocated rather than copy, because the caller keeps the request alive until its
+    // callback is invoked, and requests are released from the batch before that.
+    current_batch_->request.mutable_consensus_request()->AddAllocated(
+        const_cast<ConsensusRequestPB*>(request));
+    current_batch_->response_data.push_back(ResponseData{request, response, controller, callback});
+  }
+
+  if (new_batch) {
+    // Batch is sent even if scheduler is shutting down, so pending callbacks are always invoked.
+    messenger_->scheduler().Schedule(
+        [self = shared_from_this()](const Status& status) {
+          self->SendBatch();
+        },
+        FLAGS_multi_raft_heartbeat_window_ms * 1ms);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch() {
+  BatchPtr batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch.swap(current_batch_);
+  }
+  if (!batch) {
+    return;
+  }
+
+  batch->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  consensus_proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      [self = shared_from_this(), batch] {
+        self->ProcessResponse(batch);
+      });
+}
+
+namespace {
+
+// Returns true if the batch RPC failed because the remote server does not support it.
+bool BatchNotSupported(const Status& status, const rpc::RpcController& controller) {
+  if (status.IsNotSupported()) {
+    return true;
+  }
+  if (!status.IsRemoteError()) {
+    return false;
+  }
+  const auto* error = controller.error_response();
+  return error && error->has_code() &&
+         (error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD ||
+          error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_SERVICE);
+}
+
+} // namespace
+
+void MultiRaftHeartbeatBatcher::ProcessResponse(const BatchPtr& batch) {
+  batch->ReleaseRequests();
+
+  auto status = batch->controller.status();
+  if (!status.ok()) {
+    if (BatchNotSupported(status, batch->controller)) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10)
+          << "Multi Raft heartbeat is not supported by " << hostport_ << ", sending "
+          << batch->response_data.size() << " heartbeats individually: " << status;
+      for (const auto& data : batch->response_data) {
+        SendIndividually(data);
+      }
+      return;
+    }
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "Multi Raft heartbeat of " << batch->response_data.size() << " heartbeats to "
+        << hostport_ << " failed: " << status;
+    for (const auto& data : batch->response_data) {
+      data.controller->ShareFinishedCall(batch->controller);
+      data.callback();
+    }
+    return;
+  }
+
+  if (implicit_cast<size_t>(batch->response.consensus_response_size()) !=
+          batch->response_data.size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses from $0: $1, expected: $2", hostport_,
+        batch->response.consensus_response_size(), batch->response_data.size());
+    LOG(DFATAL) << status;
+    for (const auto& data : batch->response_data) {
+      auto* error = data.response->mutable_error();
+      error->set_code(tserver::TabletServerErrorPB::UNKNOWN_ERROR);
+      StatusToPB(status, error->mutable_status());
+      data.callback();
+    }
+    return;
+  }
+
+  for (size_t i = 0; i != batch->response_data.size(); ++i) {
+    auto& data = batch->response_data[i];
+    data.response->Swap(batch->response.mutable_consensus_response(i));
+    data.callback();
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendIndividually(const ResponseData& data) {
+  data.controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  consensus_proxy_->UpdateConsensusAsync(
+      *data.request, data.response, data.controller, data.callback);
+}
+
+MultiRaftHeartbeatBatcher::Batch::~Batch() {
+  ReleaseRequests();
+}
+
+void MultiRaftHeartbeatBatcher::Batch::ReleaseRequests() {
+  request.mutable_consensus_request()->ExtractSubrange(
+      0, request.consensus_request_size(), nullptr /* elements */);
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = batchers_.find(hostport);
+  if (it != batchers_.end()) {
+    auto batcher = it->second.lock();
+    if (batcher) {
+      return batcher;
+    }
+  }
+
+  // Remove batchers of destinations that do not have peers anymore, so the registry does not grow
+  // with servers that left the cluster. Batchers are created rarely, so a full pass is cheap.
+  for (auto i = batchers_.begin(); i != batchers_.end();) {
+    if (i->second.expired()) {
+      i = batchers_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+
+  auto batcher = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+  batchers_[hostport] = batcher;
+  return batcher;
+}
+
+size_t MultiRaftManager::TEST_NumBatchers() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return batchers_.size();
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,118 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/consensus.pb.h"
+
+#include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+namespace consensus {
+
+// Coalesces heartbeats of idle tablets that are sent to the same server, so instead of one
+// UpdateConsensus RPC per tablet per heartbeat interval, a single MultiRaftUpdateConsensus RPC
+// is sent.
+//
+// When the remote server does not support the batch RPC, requests of the batch are sent
+// individually using UpdateConsensus. Other failures of the batch RPC are reported to every request
+// of the batch, as if its own RPC failed.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(
+      const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds request to the batch that will be sent after multi_raft_heartbeat_window_ms.
+  // The request should stay alive and unchanged until callback is invoked, since the batch refers
+  // to it instead of copying it. Response and controller are filled before callback is invoked.
+  void AddRequestToBatch(const ConsensusRequestPB* request,
+                         ConsensusResponsePB* response,
+                         rpc::RpcController* controller,
+                         const rpc::ResponseCallback& callback);
+
+ private:
+  struct ResponseData {
+    const ConsensusRequestPB* request;
+    ConsensusResponsePB* response;
+    rpc::RpcController* controller;
+    rpc::ResponseCallback callback;
+  };
+
+  struct Batch {
+    MultiRaftConsensusRequestPB request;
+    MultiRaftConsensusResponsePB response;
+    rpc::RpcController controller;
+    std::vector<ResponseData> response_data;
+
+    ~Batch();
+
+    // Removes requests of the batch from the batch RPC request without deleting them, since they
+    // are owned by callers.
+    void ReleaseRequests();
+  };
+
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void SendBatch();
+  void ProcessResponse(const BatchPtr& batch);
+  void SendIndividually(const ResponseData& data);
+
+  const HostPort hostport_;
+  rpc::Messenger* const messenger_;
+  ConsensusServiceProxyPtr consensus_proxy_;
+
+  std::mutex mutex_;
+  BatchPtr current_batch_;
+};
+
+// Server wide registry of heartbeat batchers, one per destination server.
+//
+// Batchers are owned by peer proxies that send to the destination server. The registry only keeps
+// weak references, so a batcher is destroyed once the last peer of its destination is closed, and
+// its entry is removed when next batcher is created.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  // Returns batcher for specified destination, creating it if necessary.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+  // Number of destinations with registered batchers, including destroyed ones that were not
+  // removed yet.
+  size_t TEST_NumBatchers();
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
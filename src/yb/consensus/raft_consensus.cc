@@ -225,9 +225,10 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests) {
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager) {
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
-      messenger, proxy_cache, local_peer_pb.cloud_info());
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager);
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -2940,6 +2941,15 @@ void RaftConsensus::UpdateCDCConsumerOpId(const yb::OpId& op_id) {
   return queue_->UpdateCDCConsumerOpId(op_id);
 }
 
+int64_t RaftConsensus::AddMajorityReplicatedListener(
+    int64_t min_index, std::function<void()> listener) {
+  return queue_->AddMajorityReplicatedListener(min_index, std::move(listener));
+}
+
+void RaftConsensus::RemoveMajorityReplicatedListener(int64_t listener_id) {
+  queue_->RemoveMajorityReplicatedListener(listener_id);
+}
+
 void RaftConsensus::RollbackIdAndDeleteOpId(const ReplicateMsgPtr& replicate_msg,
                                             bool should_exists) {
   std::unique_ptr<OpId> op_id(replicate_msg->release_id());
@@ -2958,6 +2968,10 @@ yb::OpId RaftConsensus::MinRetryableRequestOpId() {
   return state_->MinRetryableRequestOpId();
 }
 
+RestartSafeCoarseTimePoint RaftConsensus::RestartSafeNow() {
+  return state_->Clock().Now();
+}
+
 size_t RaftConsensus::LogCacheSize() {
   return queue_->LogCacheSize();
 }
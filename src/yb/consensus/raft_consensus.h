@@ -50,6 +50,7 @@
 
 #include "yb/util/opid.h"
 #include "yb/util/random.h"
+#include "yb/util/restart_safe_clock.h"
 #include "yb/util/result.h"
 
 DECLARE_int32(leader_lease_duration_ms);
@@ -109,7 +110,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests);
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager = nullptr);
 
   RaftConsensus(
     const ConsensusOptions& options,
@@ -227,6 +229,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   yb::OpId MinRetryableRequestOpId();
 
+  // Current time of the restart safe clock used to mark log entries.
+  RestartSafeCoarseTimePoint RestartSafeNow();
+
   CHECKED_STATUS StartElection(const LeaderElectionData& data) override {
     return DoStartElection(data, PreElected::kFalse);
   }
@@ -249,6 +254,11 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   void UpdateCDCConsumerOpId(const yb::OpId& op_id) override;
 
+  int64_t AddMajorityReplicatedListener(
+      int64_t min_index, std::function<void()> listener) override;
+
+  void RemoveMajorityReplicatedListener(int64_t listener_id) override;
+
   // Start memory tracking of following operation in case it is still present in our caches.
   void TrackOperationMemory(const yb::OpId& op_id);
 
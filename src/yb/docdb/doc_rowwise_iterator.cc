@@ -66,9 +66,23 @@ class ScanChoices {
   virtual CHECKED_STATUS SeekToCurrentTarget(IntentAwareIterator* db_iter) = 0;
 
  protected:
+  // Forward scan targets only increase, so once the iterator is positioned it is enough to seek
+  // forward to the next target. That does not seek at all when the iterator is already at the
+  // target and steps to nearby targets within the current data block instead of doing a full
+  // seek, so the targets of an IN list are reached in a single forward pass.
+  void SeekForwardToCurrentTarget(IntentAwareIterator* db_iter) {
+    if (iterator_positioned_) {
+      db_iter->SeekForward(&current_scan_target_);
+    } else {
+      db_iter->Seek(current_scan_target_);
+      iterator_positioned_ = true;
+    }
+  }
+
   const bool is_forward_scan_;
   KeyBytes current_scan_target_;
   bool finished_ = false;
+  bool iterator_positioned_ = false;
 };
 
 class DiscreteScanChoices : public ScanChoices {
@@ -281,7 +295,7 @@ Status DiscreteScanChoices::SeekToCurrentTarget(IntentAwareIterator* db_iter) {
   if (!FinishedWithScanChoices()) {
     if (is_forward_scan_) {
       VLOG(2) << __PRETTY_FUNCTION__ << " Seeking to " << current_scan_target_;
-      db_iter->Seek(current_scan_target_);
+      SeekForwardToCurrentTarget(db_iter);
     } else {
       auto tmp = current_scan_target_;
       tmp.AppendValueType(ValueType::kHighest);
@@ -1371,8 +1371,13 @@ CHECKED_STATUS IntentToWriteRequest(
   return Status::OK();
 }
 
-Status PrepareApplyIntentsBatch(
+std::string ApplyTransactionState::ToString() const {
+  return Format("{ key: $0 write_id: $1 }", Slice(key).ToDebugString(), write_id);
+}
+
+Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId &transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    const ApplyTransactionState* apply_state, size_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
   // regular_batch or intents_batch could be null. In this case we don't fill apply batch for
@@ -1400,11 +1405,20 @@ Status PrepareApplyIntentsBatch(
   txn_reverse_index_upperbound.AppendValueType(ValueType::kMaxByte);
   reverse_index_upperbound = txn_reverse_index_upperbound.AsSlice();
 
-  reverse_index_iter.Seek(txn_reverse_index_prefix.data());
+  IntraTxnWriteId write_id = 0;
+  // Metadata is the first record of the transaction, so it was seen if we continue applying.
+  bool has_metadata = false;
+  if (apply_state && apply_state->active()) {
+    reverse_index_iter.Seek(apply_state->key);
+    write_id = apply_state->write_id;
+    has_metadata = true;
+  } else {
+    reverse_index_iter.Seek(txn_reverse_index_prefix.data());
+  }
 
   DocHybridTimeBuffer doc_ht_buffer;
 
-  IntraTxnWriteId write_id = 0;
+  size_t num_records = 0;
   while (reverse_index_iter.Valid()) {
     rocksdb::Slice key_slice(reverse_index_iter.key());
 
@@ -1412,11 +1426,19 @@ Status PrepareApplyIntentsBatch(
       break;
     }
 
+    if (max_records && num_records >= max_records) {
+      ApplyTransactionState result;
+      result.key = key_slice.ToBuffer();
+      result.write_id = write_id;
+      return result;
+    }
+    ++num_records;
+
     VLOG(4) << "Apply reverse index record: "
             << EntryToString(reverse_index_iter, StorageDbType::kIntents);
 
     // If the key ends at the transaction id then it is transaction metadata (status tablet,
-    // isolation level etc.).
+    // isolation level etc.). It is removed after all other records of the transaction.
     if (key_slice.size() > txn_reverse_index_prefix.size()) {
       // Value of reverse index is a key of original intent record, so seek it and check match.
       if (regular_batch &&
@@ -1428,17 +1450,20 @@ Status PrepareApplyIntentsBatch(
 
       if (intents_batch) {
         intents_batch->SingleDelete(reverse_index_iter.value());
+        intents_batch->SingleDelete(reverse_index_iter.key());
       }
-    }
-
-    if (intents_batch) {
-      intents_batch->SingleDelete(reverse_index_iter.key());
+    } else {
+      has_metadata = true;
     }
 
     reverse_index_iter.Next();
   }
 
-  return Status::OK();
+  if (intents_batch && has_metadata) {
+    intents_batch->SingleDelete(txn_reverse_index_prefix.AsSlice());
+  }
+
+  return ApplyTransactionState();
 }
 
 }  // namespace docdb
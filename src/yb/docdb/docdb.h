@@ -179,8 +179,29 @@ void PrepareTransactionWriteBatch(
     PartialRangeKeyIntents partial_range_key_intents,
     IntraTxnWriteId* write_id);
 
-CHECKED_STATUS PrepareApplyIntentsBatch(
+// State of applying or removing intents of a transaction, that is split into several batches.
+struct ApplyTransactionState {
+  // Reverse index key of the first record, that was not processed yet.
+  std::string key;
+  // Write id of the last applied intent.
+  IntraTxnWriteId write_id = 0;
+
+  bool active() const {
+    return !key.empty();
+  }
+
+  std::string ToString() const;
+};
+
+// Fills batches to apply intents of the transaction to the regular DB and/or to remove them from
+// the intents DB, walking the reverse index of the transaction starting from apply_state.
+// When max_records is not 0, stops after that many reverse index records and returns the state
+// to continue from. Otherwise, or when all records were processed, returns inactive state.
+// Transaction metadata is removed only with the last batch, so the transaction is loaded again
+// after restart if its intents were not removed completely.
+Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    const ApplyTransactionState* apply_state, size_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
 
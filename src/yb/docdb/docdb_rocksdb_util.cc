@@ -16,6 +16,8 @@
 #include <thread>
 #include <memory>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include "yb/common/transaction.h"
 
 #include "yb/rocksdb/memtablerep.h"
@@ -29,6 +31,7 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
@@ -99,6 +102,59 @@ DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved smal
 DEFINE_bool(enable_ondisk_compression, true,
             "Determines whether SSTable compression is enabled or not.");
 
+DEFINE_string(sst_compression_type, "snappy",
+              "Compression algorithm used for SST files written by flushes and small compactions: "
+              "none, snappy, lz4 or zstd. Algorithms that are not available in this build, "
+              "currently zstd, are rejected. Dictionary compression is not supported. Ignored "
+              "when enable_ondisk_compression is false.");
+TAG_FLAG(sst_compression_type, advanced);
+
+DEFINE_string(sst_large_file_compression_type, "lz4",
+              "Compression algorithm used for SST files produced by compactions, whose estimated "
+              "output size is at least sst_large_file_compression_min_size_bytes. Accepts the "
+              "same values as sst_compression_type.");
+TAG_FLAG(sst_large_file_compression_type, advanced);
+
+DEFINE_uint64(sst_large_file_compression_min_size_bytes, 0,
+              "Minimal estimated compaction output size to use sst_large_file_compression_type "
+              "for it. 0 means that sst_compression_type is used for all SST files.");
+TAG_FLAG(sst_large_file_compression_min_size_bytes, advanced);
+
+static const std::pair<const char*, rocksdb::CompressionType> kSstCompressionTypes[] = {
+  {"none", rocksdb::kNoCompression},
+  {"snappy", rocksdb::kSnappyCompression},
+  {"lz4", rocksdb::kLZ4Compression},
+  {"zstd", rocksdb::kZSTDNotFinalCompression},
+};
+
+static bool ParseSstCompressionType(const std::string& value, rocksdb::CompressionType* type) {
+  for (const auto& name_and_type : kSstCompressionTypes) {
+    if (boost::iequals(value, name_and_type.first)) {
+      *type = name_and_type.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool ValidateSstCompressionType(const char* flagname, const std::string& value) {
+  rocksdb::CompressionType type;
+  if (!ParseSstCompressionType(value, &type)) {
+    LOG(ERROR) << strings::Substitute("$0 has invalid value $1", flagname, value);
+    return false;
+  }
+  if (!rocksdb::CompressionTypeSupported(type)) {
+    LOG(ERROR) << strings::Substitute(
+        "$0 has value $1, which is not supported by this build", flagname, value);
+    return false;
+  }
+  return true;
+}
+static bool dummy_sst_compression_type = google::RegisterFlagValidator(
+    &FLAGS_sst_compression_type, &ValidateSstCompressionType);
+static bool dummy_sst_large_file_compression_type = google::RegisterFlagValidator(
+    &FLAGS_sst_large_file_compression_type, &ValidateSstCompressionType);
+
 DEFINE_int32(priority_thread_pool_size, -1,
              "Max running workers in compaction thread pool. "
              "If -1 and max_background_compactions is specified - use max_background_compactions. "
@@ -456,6 +512,23 @@ void AutoInitRocksDBFlags(rocksdb::Options* options) {
   }
 }
 
+// Returns compression type configured by specified flag value, taking into account
+// enable_ondisk_compression. The flag validators reject algorithms that are not available in this
+// build. This RocksDB version has no dictionary compression, so blocks are always compressed
+// independently.
+rocksdb::CompressionType SstCompressionType(const std::string& flag_value) {
+  if (!FLAGS_enable_ondisk_compression) {
+    return rocksdb::kNoCompression;
+  }
+  rocksdb::CompressionType result = rocksdb::kNoCompression;
+  if (!ParseSstCompressionType(flag_value, &result) ||
+      !rocksdb::CompressionTypeSupported(result)) {
+    LOG(DFATAL) << "Invalid SST compression type: " << flag_value;
+    return rocksdb::kNoCompression;
+  }
+  return result;
+}
+
 } // namespace
 
 void InitRocksDBOptions(
@@ -487,8 +560,12 @@ void InitRocksDBOptions(
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
   }
 
-  options->compression = rocksdb::Snappy_Supported() && FLAGS_enable_ondisk_compression
-      ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  options->compression = SstCompressionType(FLAGS_sst_compression_type);
+  if (FLAGS_sst_large_file_compression_min_size_bytes != 0) {
+    options->large_compaction_output_compression =
+        SstCompressionType(FLAGS_sst_large_file_compression_type);
+    options->large_compaction_output_min_size = FLAGS_sst_large_file_compression_min_size_bytes;
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -13,6 +13,8 @@
 
 #include "yb/docdb/redis_operation.h"
 
+#include <numeric>
+
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/doc_write_batch_cache.h"
@@ -59,6 +61,9 @@ Status RedisWriteOperation::GetDocPaths(
     GetDocPathsMode mode, DocPathsToLock* paths, IsolationLevel *level) const {
   paths->push_back(DocKey::FromRedisKey(
       request_.key_value().hash_code(), request_.key_value().key()).EncodeAsRefCntPrefix());
+  for (const auto& kv : request_.extra_key_values()) {
+    paths->push_back(DocKey::FromRedisKey(kv.hash_code(), kv.key()).EncodeAsRefCntPrefix());
+  }
   *level = IsolationLevel::SNAPSHOT_ISOLATION;
 
   return Status::OK();
@@ -549,6 +554,9 @@ Result<RedisValue> RedisWriteOperation::GetValue(
 }
 
 Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
+  if (request_.extra_key_values_size() > 0) {
+    return ApplyMultiSet(data);
+  }
   const RedisKeyValuePB& kv = request_.key_value();
   const MonoDelta ttl = request_.set_request().has_ttl() ?
       MonoDelta::FromMilliseconds(request_.set_request().ttl()) : Value::kMaxTtl;
@@ -786,6 +794,28 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
   return Status::OK();
 }
 
+Status RedisWriteOperation::ApplyMultiSet(const DocOperationApplyData& data) {
+  auto apply = [this, &data](const RedisKeyValuePB& kv) -> Status {
+    if (kv.type() != REDIS_TYPE_STRING || kv.subkey_size() != 0 || kv.value_size() != 1) {
+      return STATUS_FORMAT(InvalidCommand,
+                           "MSET expects a single string value for each key, found: $0",
+                           kv.ShortDebugString());
+    }
+    return data.doc_write_batch->SetPrimitive(
+        DocPath::DocPathFromRedisKey(kv.hash_code(), kv.key()),
+        Value(PrimitiveValue(kv.value(0)), Value::kMaxTtl),
+        data.read_time, data.deadline, redis_query_id());
+  };
+
+  RETURN_NOT_OK(apply(request_.key_value()));
+  for (const auto& kv : request_.extra_key_values()) {
+    RETURN_NOT_OK(apply(kv));
+  }
+
+  response_.set_code(RedisResponsePB::OK);
+  return Status::OK();
+}
+
 Status RedisWriteOperation::ApplySetTtl(const DocOperationApplyData& data) {
   const RedisKeyValuePB& kv = request_.key_value();
 
@@ -1265,13 +1295,19 @@ Status RedisWriteOperation::ApplyRemove(const DocOperationApplyData& data) {
 
 Status RedisReadOperation::Execute() {
   SimulateTimeoutIfTesting(&deadline_);
-  SubDocKey doc_key(
-      DocKey::FromRedisKey(request_.key_value().hash_code(), request_.key_value().key()));
-  auto iter = yb::docdb::CreateIntentAwareIterator(
-      doc_db_, BloomFilterMode::USE_BLOOM_FILTER,
-      doc_key.Encode().AsSlice(),
-      redis_query_id(), /* txn_op_context */ boost::none, deadline_, read_time_);
-  iterator_ = std::move(iter);
+  if (request_.extra_key_values_size() > 0) {
+    // Bloom filter could be used only when all reads are for the same key.
+    iterator_ = yb::docdb::CreateIntentAwareIterator(
+        doc_db_, BloomFilterMode::DONT_USE_BLOOM_FILTER, /* user_key_for_filter */ boost::none,
+        redis_query_id(), /* txn_op_context */ boost::none, deadline_, read_time_);
+  } else {
+    SubDocKey doc_key(
+        DocKey::FromRedisKey(request_.key_value().hash_code(), request_.key_value().key()));
+    iterator_ = yb::docdb::CreateIntentAwareIterator(
+        doc_db_, BloomFilterMode::USE_BLOOM_FILTER,
+        doc_key.Encode().AsSlice(),
+        redis_query_id(), /* txn_op_context */ boost::none, deadline_, read_time_);
+  }
   deadline_info_.emplace(deadline_);
 
   switch (request_.request_case()) {
@@ -1762,7 +1798,7 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
       return Status::OK();
     }
     case RedisGetRequestPB::MGET: {
-      return STATUS(NotSupported, "MGET not yet supported");
+      return ExecuteMultiGet();
     }
     case RedisGetRequestPB::HMGET: {
       RedisDataType type = VERIFY_RESULT(GetValueType());
@@ -1832,6 +1868,49 @@ Status RedisReadOperation::ExecuteGet(const RedisGetRequestPB& get_request) {
   return Status::OK();
 }
 
+Status RedisReadOperation::ExecuteMultiGet() {
+  std::vector<const RedisKeyValuePB*> key_values;
+  key_values.reserve(request_.extra_key_values_size() + 1);
+  key_values.push_back(&request_.key_value());
+  for (const auto& kv : request_.extra_key_values()) {
+    key_values.push_back(&kv);
+  }
+
+  // Visit keys in the order of their doc keys, so the iterator is only moved forward.
+  std::vector<size_t> indices(key_values.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::sort(indices.begin(), indices.end(), [&key_values](size_t lhs, size_t rhs) {
+    const auto& lhs_kv = *key_values[lhs];
+    const auto& rhs_kv = *key_values[rhs];
+    if (lhs_kv.hash_code() != rhs_kv.hash_code()) {
+      return lhs_kv.hash_code() < rhs_kv.hash_code();
+    }
+    return lhs_kv.key() < rhs_kv.key();
+  });
+
+  auto* elements = response_.mutable_array_response()->mutable_elements();
+  elements->Reserve(key_values.size());
+  for (size_t i = 0; i != key_values.size(); ++i) {
+    elements->Add();
+  }
+  for (size_t i = 0; i != indices.size(); ++i) {
+    const auto& kv = *key_values[indices[i]];
+    if (i != 0 && kv.key() == key_values[indices[i - 1]]->key()) {
+      // Same key was requested again, value is already known.
+      *elements->Mutable(indices[i]) = elements->Get(indices[i - 1]);
+      continue;
+    }
+    auto value = VERIFY_RESULT(GetRedisValue(iterator_.get(), kv));
+    // MGET returns nil for keys that don't hold a string. Empty string is nil response.
+    if (value.type == REDIS_TYPE_STRING) {
+      *elements->Mutable(indices[i]) = std::move(value.value);
+    }
+  }
+
+  response_.set_code(RedisResponsePB::OK);
+  return Status::OK();
+}
+
 Status RedisReadOperation::ExecuteStrLen() {
   auto value = GetValue();
   response_.set_code(RedisResponsePB::OK);
@@ -65,6 +65,8 @@ class RedisWriteOperation :
 
   CHECKED_STATUS ApplySetTtl(const DocOperationApplyData& data);
   CHECKED_STATUS ApplySet(const DocOperationApplyData& data);
+  // Used for MSET, sets string values of all keys in the request.
+  CHECKED_STATUS ApplyMultiSet(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyGetSet(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyAppend(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyDel(const DocOperationApplyData& data);
@@ -112,6 +114,8 @@ class RedisReadOperation {
   CHECKED_STATUS ExecuteGet();
   CHECKED_STATUS ExecuteGet(const RedisGetRequestPB& get_request);
   CHECKED_STATUS ExecuteGet(RedisGetRequestPB::GetRequestType type);
+  // Used for MGET, reads values of all keys in the request in a single pass of the iterator.
+  CHECKED_STATUS ExecuteMultiGet();
   CHECKED_STATUS ExecuteGetForRename();
   CHECKED_STATUS ExecuteGetTtl();
   // Used to implement HGETALL, HKEYS, HVALS, SMEMBERS, HLEN, SCARD
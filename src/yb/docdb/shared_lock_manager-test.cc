@@ -28,6 +28,8 @@
 
 using namespace std::literals;
 
+DECLARE_int32(shared_lock_manager_num_stripes);
+
 using std::string;
 using std::vector;
 using std::stack;
@@ -184,5 +186,68 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+namespace {
+
+// Returns number of lock batches per second taken by num_threads threads, each locking batches of
+// a few keys from a small shared key set, so that batches of different threads often overlap.
+double LockThroughput(SharedLockManager* lm, int num_threads, MonoDelta duration) {
+  constexpr int kNumKeys = 1024;
+  constexpr int kKeysPerBatch = 4;
+  std::vector<RefCntPrefix> keys;
+  for (int i = 0; i != kNumKeys; ++i) {
+    keys.emplace_back(Format("key_$0", i));
+  }
+
+  std::atomic<bool> stop_requested{false};
+  std::atomic<size_t> total_batches{0};
+  std::vector<std::thread> threads;
+  for (int thread_idx = 0; thread_idx != num_threads; ++thread_idx) {
+    threads.emplace_back([lm, &keys, &stop_requested, &total_batches, thread_idx] {
+      std::mt19937_64 rng(thread_idx);
+      // Shared locks, so that threads only contend on lock manager internals.
+      const IntentTypeSet intent_types({IntentType::kWeakRead, IntentType::kWeakWrite});
+      size_t batches = 0;
+      LockBatchEntries entries;
+      while (!stop_requested.load(std::memory_order_acquire)) {
+        const auto first_key = rng() % (kNumKeys - kKeysPerBatch);
+        entries.clear();
+        for (int i = 0; i != kKeysPerBatch; ++i) {
+          entries.push_back(LockBatchEntry{keys[first_key + i], intent_types});
+        }
+        CHECK(lm->Lock(&entries, CoarseTimePoint::max()));
+        lm->Unlock(entries);
+        ++batches;
+      }
+      total_batches.fetch_add(batches, std::memory_order_acq_rel);
+    });
+  }
+
+  std::this_thread::sleep_for(duration.ToSteadyDuration());
+  stop_requested.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return total_batches.load(std::memory_order_acquire) / duration.ToSeconds();
+}
+
+} // namespace
+
+// Compares throughput of the lock manager with a single stripe, i.e. all lock entries guarded by
+// one mutex, and with the default number of stripes.
+TEST_F(SharedLockManagerTest, StripedThroughput) {
+  const auto kDuration = MonoDelta::FromMilliseconds(AllowSlowTests() ? 3000 : 300);
+  for (int num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    SharedLockManager single_stripe(1);
+    SharedLockManager striped;
+    const auto single_stripe_rate = LockThroughput(&single_stripe, num_threads, kDuration);
+    const auto striped_rate = LockThroughput(&striped, num_threads, kDuration);
+    LOG(INFO) << Format(
+        "Threads: $0, single stripe: $1 batches/s, $2 stripes: $3 batches/s, speedup: $4",
+        num_threads, static_cast<int64_t>(single_stripe_rate),
+        FLAGS_shared_lock_manager_num_stripes, static_cast<int64_t>(striped_rate),
+        striped_rate / single_stripe_rate);
+  }
+}
+
 } // namespace docdb
 } // namespace yb
@@ -13,12 +13,15 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <algorithm>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
 #include "yb/util/scope_exit.h"
@@ -27,6 +30,12 @@
 
 using std::string;
 
+DEFINE_int32(shared_lock_manager_num_stripes, 16,
+             "Number of stripes the lock entries of a tablet's shared lock manager are "
+             "partitioned into by key hash. Batches locking keys of different stripes do not "
+             "contend with each other.");
+TAG_FLAG(shared_lock_manager_num_stripes, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -107,8 +116,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the stripe this entry
+  // belongs to is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -130,32 +139,48 @@ struct LockedBatchEntry {
 
 class SharedLockManager::Impl {
  public:
+  explicit Impl(size_t num_stripes) : stripes_(num_stripes) {
+    CHECK_GT(num_stripes, 0);
+  }
+
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      LOG_IF(DFATAL, !stripe.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(stripe.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Part of the lock entries, selected by key hash.
+  struct Stripe {
+    // Should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  };
+
+  // Calls f(stripe, entry) for each entry of the batch, with the mutex of its stripe held.
+  // Stripes are visited in increasing order and each of them is locked once per batch.
+  template <class Batch, class F>
+  void ForEachEntryByStripe(Batch* batch, const F& f);
+
+  // Make sure the entries exist in the locks maps and store pointers to them in the batch,
+  // so we can access them without holding the stripe locks.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::vector<Stripe> stripes_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -273,22 +298,51 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
   return true;
 }
 
+template <class Batch, class F>
+void SharedLockManager::Impl::ForEachEntryByStripe(Batch* batch, const F& f) {
+  if (stripes_.size() == 1) {
+    std::lock_guard<std::mutex> lock(stripes_[0].mutex);
+    for (auto& entry : *batch) {
+      f(&stripes_[0], &entry);
+    }
+    return;
+  }
+
+  // Pairs of stripe index and entry index, ordered by stripe.
+  boost::container::small_vector<std::pair<size_t, size_t>, 16> order;
+  order.reserve(batch->size());
+  RefCntPrefixHash hash;
+  for (size_t i = 0; i != batch->size(); ++i) {
+    order.emplace_back(hash((*batch)[i].key) % stripes_.size(), i);
+  }
+  std::sort(order.begin(), order.end());
+
+  auto it = order.begin();
+  while (it != order.end()) {
+    auto& stripe = stripes_[it->first];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    const auto stripe_idx = it->first;
+    for (; it != order.end() && it->first == stripe_idx; ++it) {
+      f(&stripe, &(*batch)[it->second]);
+    }
+  }
+}
+
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
-  for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+  ForEachEntryByStripe(key_to_intent_type, [](Stripe* stripe, LockBatchEntry* entry) {
+    auto& value = stripe->locks[entry->key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!stripe->free_lock_entries.empty()) {
+        value = stripe->free_lock_entries.back();
+        stripe->free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        stripe->lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = stripe->lock_entries.back().get();
       }
     }
     value->ref_count++;
-    key_and_intent_type.locked = value;
-  }
+    entry->locked = value;
+  });
 }
 
 void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type) {
@@ -302,16 +356,19 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
-  for (const auto& item : key_to_intent_type) {
-    if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+  ForEachEntryByStripe(&key_to_intent_type, [](Stripe* stripe, const LockBatchEntry* item) {
+    if (--(item->locked->ref_count) == 0) {
+      stripe->locks.erase(item->key);
+      stripe->free_lock_entries.push_back(item->locked);
     }
-  }
+  });
+}
+
+SharedLockManager::SharedLockManager()
+    : SharedLockManager(std::max(FLAGS_shared_lock_manager_num_stripes, 1)) {
 }
 
-SharedLockManager::SharedLockManager() : impl_(new Impl) {
+SharedLockManager::SharedLockManager(size_t num_stripes) : impl_(new Impl(num_stripes)) {
 }
 
 SharedLockManager::~SharedLockManager() {}
@@ -34,9 +34,14 @@ namespace docdb {
 // - Multiple kStrongSerializableRead and kWeakSerializableRead
 // - Multiple kStrongSerializableWrite and kWeakSerializableWrite
 // - Multiple kWeakSnapshotWrite, kWeakSerializableRead, and kWeakSerializableWrite
+//
+// Lock entries are kept in maps partitioned into stripes by key hash, so concurrent batches only
+// contend on the stripes of their own keys.
 class SharedLockManager {
  public:
+  // Uses --shared_lock_manager_num_stripes stripes.
   SharedLockManager();
+  explicit SharedLockManager(size_t num_stripes);
   ~SharedLockManager();
 
   // Attempt to lock a batch of keys. The call may be blocked waiting for other locks to be
@@ -687,6 +687,149 @@ bool AsyncTruncate::SendRequest(int attempt) {
   return true;
 }
 
+// ============================================================================
+//  Class AsyncTabletSplitTask.
+// ============================================================================
+AsyncTabletSplitTask::AsyncTabletSplitTask(Master* master,
+                                           ThreadPool* callback_pool,
+                                           const scoped_refptr<TabletInfo>& tablet)
+    : RetryingTSRpcTask(master,
+                        callback_pool,
+                        gscoped_ptr<TSPicker>(new PickLeaderReplica(tablet)),
+                        tablet->table().get()),
+      tablet_(tablet) {
+  tablet_->SplitTaskStarted();
+}
+
+TabletId AsyncTabletSplitTask::tablet_id() const {
+  return tablet_->tablet_id();
+}
+
+TabletServerId AsyncTabletSplitTask::permanent_uuid() const {
+  return target_ts_desc_ != nullptr ? target_ts_desc_->permanent_uuid() : "";
+}
+
+void AsyncTabletSplitTask::UnregisterAsyncTaskCallback() {
+  // Task could be unregistered several times, e.g. after it was aborted.
+  if (!unregistered_.exchange(true, std::memory_order_acq_rel)) {
+    tablet_->SplitTaskFinished();
+  }
+}
+
+// ============================================================================
+//  Class AsyncGetSplitKey.
+// ============================================================================
+AsyncGetSplitKey::AsyncGetSplitKey(Master* master,
+                                   ThreadPool* callback_pool,
+                                   const scoped_refptr<TabletInfo>& tablet)
+    : AsyncTabletSplitTask(master, callback_pool, tablet) {
+}
+
+string AsyncGetSplitKey::description() const {
+  return tablet_->ToString() + " Get Split Key RPC";
+}
+
+void AsyncGetSplitKey::HandleResponse(int attempt) {
+  if (resp_.has_error()) {
+    const Status s = StatusFromPB(resp_.error().status());
+    const TabletServerErrorPB::Code code = resp_.error().code();
+    LOG(WARNING) << "TS " << permanent_uuid() << ": get split key failed for tablet "
+                 << tablet_id() << " with error code " << TabletServerErrorPB::Code_Name(code)
+                 << ": " << s.ToString();
+    // Tablet that could not be split now, will be considered again by the next split check.
+    if (code == TabletServerErrorPB::TABLET_NOT_FOUND || s.IsNotSupported() ||
+        s.IsIllegalState()) {
+      TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kFailed);
+    }
+    return;
+  }
+
+  VLOG(1) << "TS " << permanent_uuid() << ": got split key for tablet " << tablet_id();
+  TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kComplete);
+
+  const Status s = master_->catalog_manager()->DoSplitTablet(
+      tablet_, resp_.split_encoded_key(), resp_.split_partition_key());
+  WARN_NOT_OK(s, Format("Failed to split tablet $0", tablet_id()));
+}
+
+bool AsyncGetSplitKey::SendRequest(int attempt) {
+  tserver::GetSplitKeyRequestPB req;
+  req.set_dest_uuid(permanent_uuid());
+  req.set_tablet_id(tablet_id());
+  ts_admin_proxy_->GetSplitKeyAsync(req, &resp_, &rpc_, BindRpcCallback());
+  VLOG(1) << "Send get split key request to " << permanent_uuid()
+          << " (attempt " << attempt << "):\n"
+          << req.DebugString();
+  return true;
+}
+
+// ============================================================================
+//  Class AsyncSplitTablet.
+// ============================================================================
+AsyncSplitTablet::AsyncSplitTablet(Master* master,
+                                   ThreadPool* callback_pool,
+                                   const scoped_refptr<TabletInfo>& tablet,
+                                   const std::array<TabletId, 2>& new_tablet_ids,
+                                   const std::string& split_encoded_key,
+                                   const std::string& split_partition_key)
+    : AsyncTabletSplitTask(master, callback_pool, tablet) {
+  req_.set_tablet_id(tablet_->tablet_id());
+  req_.set_new_tablet1_id(new_tablet_ids[0]);
+  req_.set_new_tablet2_id(new_tablet_ids[1]);
+  req_.set_split_encoded_key(split_encoded_key);
+  req_.set_split_partition_key(split_partition_key);
+}
+
+string AsyncSplitTablet::description() const {
+  return Format("$0 Split Tablet RPC into $1 and $2",
+                tablet_->ToString(), req_.new_tablet1_id(), req_.new_tablet2_id());
+}
+
+void AsyncSplitTablet::HandleResponse(int attempt) {
+  server::UpdateClock(resp_, master_->clock());
+
+  if (!resp_.has_error()) {
+    VLOG(1) << "TS " << permanent_uuid() << ": split complete on tablet " << tablet_id();
+    TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kComplete);
+    return;
+  }
+
+  const Status s = StatusFromPB(resp_.error().status());
+  const TabletServerErrorPB::Code code = resp_.error().code();
+  LOG(WARNING) << "TS " << permanent_uuid() << ": split failed for tablet " << tablet_id()
+               << " with error code " << TabletServerErrorPB::Code_Name(code)
+               << ": " << s.ToString();
+  switch (code) {
+    case TabletServerErrorPB::TABLET_SPLIT: FALLTHROUGH_INTENDED;
+    case TabletServerErrorPB::TABLET_SPLIT_REJECTED: {
+      // The split was not replicated or the tablet was already split into other tablets, so the
+      // new tablets were not created by tablet servers.
+      TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kFailed);
+      const Status rollback_status = master_->catalog_manager()->RollbackTabletSplit(tablet_, s);
+      WARN_NOT_OK(rollback_status, Format("Failed to roll back split of tablet $0", tablet_id()));
+      return;
+    }
+    case TabletServerErrorPB::TABLET_NOT_FOUND:
+      // The split could be already replicated, so it is not rolled back. The background task
+      // resends the split request to the new leader until the new tablets are ready.
+      TransitionToTerminalState(MonitoredTaskState::kRunning, MonitoredTaskState::kFailed);
+      return;
+    default:
+      // Retry.
+      return;
+  }
+}
+
+bool AsyncSplitTablet::SendRequest(int attempt) {
+  req_.set_dest_uuid(permanent_uuid());
+  req_.set_propagated_hybrid_time(master_->clock()->Now().ToUint64());
+  ts_admin_proxy_->SplitTabletAsync(req_, &resp_, &rpc_, BindRpcCallback());
+  VLOG(1) << "Send split tablet request to " << permanent_uuid()
+          << " (attempt " << attempt << "):\n"
+          << req_.DebugString();
+  return true;
+}
+
 // ============================================================================
 //  Class CommonInfoForRaftTask.
 // ============================================================================
@@ -13,6 +13,7 @@
 #ifndef YB_MASTER_ASYNC_RPC_TASKS_H
 #define YB_MASTER_ASYNC_RPC_TASKS_H
 
+#include <array>
 #include <atomic>
 #include <string>
 
@@ -395,6 +396,73 @@ class AsyncTruncate : public RetryingTSRpcTask {
   tserver::TruncateResponsePB resp_;
 };
 
+// Base class of the tasks splitting a tablet. Registers the task in the tablet, so the number of
+// outstanding splits is limited per tablet rather than per table.
+class AsyncTabletSplitTask : public RetryingTSRpcTask {
+ public:
+  AsyncTabletSplitTask(Master* master,
+                       ThreadPool* callback_pool,
+                       const scoped_refptr<TabletInfo>& tablet);
+
+ protected:
+  TabletId tablet_id() const override;
+
+  TabletServerId permanent_uuid() const;
+
+  void UnregisterAsyncTaskCallback() override;
+
+  scoped_refptr<TabletInfo> tablet_;
+
+ private:
+  std::atomic<bool> unregistered_{false};
+};
+
+// Send a GetSplitKey() RPC request to the leader of the tablet, and start the tablet split
+// using the returned key.
+class AsyncGetSplitKey : public AsyncTabletSplitTask {
+ public:
+  AsyncGetSplitKey(Master* master,
+                   ThreadPool* callback_pool,
+                   const scoped_refptr<TabletInfo>& tablet);
+
+  Type type() const override { return ASYNC_GET_SPLIT_KEY; }
+
+  std::string type_name() const override { return "Get Tablet Split Key"; }
+
+  std::string description() const override;
+
+ protected:
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+
+  tserver::GetSplitKeyResponsePB resp_;
+};
+
+// Send a SplitTablet() RPC request to the leader of the tablet. The split is rolled back when the
+// leader rejects it before replicating, and is resent by the master background task otherwise.
+class AsyncSplitTablet : public AsyncTabletSplitTask {
+ public:
+  AsyncSplitTablet(Master* master,
+                   ThreadPool* callback_pool,
+                   const scoped_refptr<TabletInfo>& tablet,
+                   const std::array<TabletId, 2>& new_tablet_ids,
+                   const std::string& split_encoded_key,
+                   const std::string& split_partition_key);
+
+  Type type() const override { return ASYNC_SPLIT_TABLET; }
+
+  std::string type_name() const override { return "Split Tablet"; }
+
+  std::string description() const override;
+
+ protected:
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+
+  tserver::SplitTabletRequestPB req_;
+  tserver::SplitTabletResponsePB resp_;
+};
+
 class CommonInfoForRaftTask : public RetryingTSRpcTask {
  public:
   CommonInfoForRaftTask(
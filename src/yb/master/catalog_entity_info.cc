@@ -182,6 +182,22 @@ uint32_t TabletInfo::reported_schema_version() const {
   return reported_schema_version_;
 }
 
+void TabletInfo::SplitTaskStarted() {
+  std::lock_guard<simple_spinlock> l(lock_);
+  ++split_tasks_;
+}
+
+void TabletInfo::SplitTaskFinished() {
+  std::lock_guard<simple_spinlock> l(lock_);
+  DCHECK_GT(split_tasks_, 0);
+  --split_tasks_;
+}
+
+bool TabletInfo::HasSplitTasks() const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  return split_tasks_ != 0;
+}
+
 std::string TabletInfo::ToString() const {
   return Substitute("$0 (table $1)", tablet_id_,
                     (table_ != nullptr ? table_->ToString() : "MISSING"));
@@ -205,6 +205,11 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   bool set_reported_schema_version(uint32_t version);
   uint32_t reported_schema_version() const;
 
+  // Accessors for the number of running tasks splitting this tablet (in-memory only).
+  void SplitTaskStarted();
+  void SplitTaskFinished();
+  bool HasSplitTasks() const;
+
   // No synchronization needed.
   std::string ToString() const override;
 
@@ -246,6 +251,9 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   // Reported schema version (in-memory only).
   uint32_t reported_schema_version_ = 0;
 
+  // Number of running tasks splitting this tablet.
+  int split_tasks_ = 0;
+
   LeaderStepDownFailureTimes leader_stepdown_failure_times_;
 
   DISALLOW_COPY_AND_ASSIGN(TabletInfo);
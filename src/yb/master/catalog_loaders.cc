@@ -139,8 +139,12 @@ Status TabletLoader::Visit(const TabletId& tablet_id, const SysTabletsEntryPB& m
       return STATUS(Corruption, "Missing table for tablet: ", tablet_id);
     }
 
-    // Add the tablet to the Table.
-    if (!tablet_deleted) {
+    // Add the tablet to the Table. New tablets created by a split replace the split tablet in the
+    // table only after the split is completed.
+    const bool incomplete_split_tablet =
+        !metadata.split_parent_tablet_id().empty() &&
+        metadata.state() != SysTabletsEntryPB::RUNNING;
+    if (!tablet_deleted && !incomplete_split_tablet) {
       table->AddTablet(tablet);
     }
 
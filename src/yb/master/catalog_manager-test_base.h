@@ -184,6 +184,11 @@ class TestLoadBalancerBase {
     gflags::SetCommandLineOption("leader_balance_threshold", "0");
     PrepareTestState(ts_descs_multi_az);
     TestLeaderBlacklist();
+
+    gflags::SetCommandLineOption("load_balancer_balance_by_tablet_load", "true");
+    PrepareTestState(ts_descs_multi_az);
+    TestBalancingByTabletLoad();
+    gflags::SetCommandLineOption("load_balancer_balance_by_tablet_load", "false");
   }
 
  protected:
@@ -257,6 +262,49 @@ class TestLoadBalancerBase {
     LOG(INFO) << "Leader distribution: 2 1 1 -OR- 1 2 1";
   }
 
+  void TestBalancingByTabletLoad() {
+    LOG(INFO) << "Testing balancing by the load of the tablets";
+    PlacementInfoPB* cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kNumReplicas);
+
+    // Make tablet 1 hot, by reporting it with 10 load units of reads and writes on every TS.
+    google::protobuf::RepeatedPtrField<ReportedTabletLoadPB> tablet_loads;
+    auto* hot_tablet_load = tablet_loads.Add();
+    hot_tablet_load->set_tablet_id(tablets_[1]->tablet_id());
+    hot_tablet_load->set_read_ops_per_sec(800);
+    hot_tablet_load->set_write_ops_per_sec(200);
+    for (const auto& ts_desc : ts_descs_) {
+      ts_desc->UpdateTabletLoads(tablet_loads);
+    }
+
+    // Add an empty TS in the same AZ as ts0.
+    ts_descs_.push_back(SetupTS("3333", "a"));
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+
+    // Loads are ts0:14, ts1:14, ts2:14 and ts3:0. Moving any replica from the most loaded TS to
+    // the empty one lowers the spread, but the hot tablet balances the two TSs best. It is not the
+    // first candidate in the tablet order, so the replica count balancing would not pick it.
+    string expected_tablet_id = tablets_[1]->tablet_id();
+    string expected_from_ts = ts_descs_[2]->permanent_uuid();
+    string expected_to_ts = ts_descs_[3]->permanent_uuid();
+    TestAddLoad(expected_tablet_id, expected_from_ts, expected_to_ts);
+
+    // Leader load is 2 on ts0, 11 on ts1, which leads only the hot tablet, and 1 on ts2. Moving the
+    // hot leader to ts2 would only make ts2 the new hot spot, so no leader moves are expected.
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+    string placeholder;
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    // Forget the reported loads, as the tablet server descriptors are shared by the test cases.
+    tablet_loads.Clear();
+    for (const auto& ts_desc : ts_descs_) {
+      ts_desc->UpdateTabletLoads(tablet_loads);
+    }
+  }
+
   void TestWithBlacklist() {
     LOG(INFO) << "Testing with tablet servers with blacklist";
     // Setup cluster config.
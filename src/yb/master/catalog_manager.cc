@@ -58,6 +58,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <functional>
 #include <mutex>
@@ -260,6 +261,20 @@ DEFINE_test_flag(bool, return_error_if_namespace_not_found, false,
 DEFINE_test_flag(bool, simulate_crash_after_table_marked_deleting, false,
     "Crash yb-master after table's state is set to DELETING. This skips tablets deletion.");
 
+DEFINE_int64(tablet_split_size_threshold_bytes, 0,
+             "Tablets with SST files larger than this are automatically split by the master. "
+             "0 disables size based splitting.");
+TAG_FLAG(tablet_split_size_threshold_bytes, advanced);
+
+DEFINE_double(tablet_split_ops_per_sec_threshold, 0,
+              "Tablets serving more read and write operations per second than this are "
+              "automatically split by the master. 0 disables load based splitting.");
+TAG_FLAG(tablet_split_ops_per_sec_threshold, advanced);
+
+DEFINE_int32(max_outstanding_tablet_splits, 1,
+             "Max number of automatically started tablet splits in progress at the same time.");
+TAG_FLAG(max_outstanding_tablet_splits, advanced);
+
 namespace yb {
 namespace master {
 
@@ -440,6 +455,16 @@ size_t GetNameMapperIndex(YQLDatabase db_type) {
   return 0;
 }
 
+// New tablet created by a split is ready to replace the split tablet after its replicas reported
+// the committed Raft config with an elected leader.
+bool IsSplitTabletReady(const SysTabletsEntryPB& tablet_pb) {
+  if (!tablet_pb.has_committed_consensus_state()) {
+    return false;
+  }
+  return !FLAGS_catalog_manager_wait_for_new_tablets_to_elect_leader ||
+         tablet_pb.committed_consensus_state().has_leader_uuid();
+}
+
 }  // anonymous namespace
 
 ////////////////////////////////////////////////////////////
@@ -2647,6 +2672,454 @@ void CatalogManager::SendTruncateTabletRequest(const scoped_refptr<TabletInfo>&
   WARN_NOT_OK(status, Substitute("Failed to send truncate request for tablet $0", tablet->id()));
 }
 
+Status CatalogManager::SplitTablet(const TabletId& tablet_id) {
+  RETURN_NOT_OK(CheckOnline());
+
+  scoped_refptr<TabletInfo> tablet;
+  {
+    SharedLock<LockType> l(lock_);
+    tablet = FindPtrOrNull(*tablet_map_, tablet_id);
+  }
+  if (!tablet || !tablet->table()) {
+    return STATUS_FORMAT(NotFound, "Tablet $0 not found", tablet_id);
+  }
+
+  {
+    auto table_lock = tablet->table()->LockForRead();
+    auto tablet_lock = tablet->LockForRead();
+    RETURN_NOT_OK(CheckTabletSplittable(table_lock->data(), tablet_lock->data()));
+  }
+  if (tablet->HasSplitTasks()) {
+    return STATUS(IllegalState, "Tablet is already being split");
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Starting split of tablet " << tablet->ToString();
+  auto call = std::make_shared<AsyncGetSplitKey>(master_, worker_pool_.get(), tablet);
+  tablet->table()->AddTask(call);
+  return call->Run();
+}
+
+Status CatalogManager::CheckTabletSplittable(const PersistentTableInfo& table_data,
+                                             const PersistentTabletInfo& tablet_data) {
+  const auto& table_pb = table_data.pb;
+  const auto& tablet_pb = tablet_data.pb;
+  if (!table_data.is_running()) {
+    return STATUS_FORMAT(IllegalState, "Table $0 is not running", table_pb.name());
+  }
+  if (!tablet_data.is_running()) {
+    return STATUS(IllegalState, "Tablet is not running");
+  }
+  if (tablet_pb.split_tablet_ids_size() != 0) {
+    return STATUS(IllegalState, "Tablet is already being split");
+  }
+  if (tablet_pb.table_ids_size() > 1) {
+    return STATUS(NotSupported, "Tablets shared by multiple tables could not be split");
+  }
+  if (table_pb.table_type() != TableType::YQL_TABLE_TYPE &&
+      table_pb.table_type() != TableType::REDIS_TABLE_TYPE) {
+    return STATUS_FORMAT(NotSupported, "Tablets of $0 tables could not be split",
+                         TableType_Name(table_pb.table_type()));
+  }
+  if (!table_pb.partition_schema().has_hash_schema()) {
+    return STATUS(NotSupported, "Only tablets of hash partitioned tables could be split");
+  }
+  // Provisional records of the split tablet are not moved to the new tablets.
+  if (table_pb.schema().table_properties().is_transactional()) {
+    return STATUS(NotSupported, "Tablets of transactional tables could not be split");
+  }
+  return Status::OK();
+}
+
+Status CatalogManager::DoSplitTablet(const scoped_refptr<TabletInfo>& source_tablet,
+                                     const std::string& split_encoded_key,
+                                     const std::string& split_partition_key) {
+  RETURN_NOT_OK(CheckIsLeaderAndReady());
+
+  auto table = source_tablet->table();
+  std::array<scoped_refptr<TabletInfo>, 2> new_tablets;
+  {
+    auto table_lock = table->LockForRead();
+    auto source_lock = source_tablet->LockForWrite();
+    RETURN_NOT_OK(CheckTabletSplittable(table_lock->data(), source_lock->data()));
+
+    const auto& source_partition = source_lock->data().pb.partition();
+    if (split_partition_key <= source_partition.partition_key_start() ||
+        (!source_partition.partition_key_end().empty() &&
+         split_partition_key >= source_partition.partition_key_end())) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Split key $0 is out of tablet $1 partition $2",
+          Slice(split_partition_key).ToDebugHexString(), source_tablet->tablet_id(),
+          source_partition.ShortDebugString());
+    }
+
+    std::vector<TabletInfo*> added_tablets;
+    for (size_t i = 0; i != new_tablets.size(); ++i) {
+      PartitionPB partition = source_partition;
+      if (i == 0) {
+        partition.set_partition_key_end(split_partition_key);
+      } else {
+        partition.set_partition_key_start(split_partition_key);
+      }
+      new_tablets[i] = CreateTabletInfo(table.get(), partition);
+      auto* new_tablet_data = new_tablets[i]->mutable_metadata()->mutable_dirty();
+      new_tablet_data->set_state(
+          SysTabletsEntryPB::CREATING, Substitute("Split from $0", source_tablet->tablet_id()));
+      new_tablet_data->pb.set_split_parent_tablet_id(source_tablet->tablet_id());
+      source_lock->mutable_data()->pb.add_split_tablet_ids(new_tablets[i]->tablet_id());
+      added_tablets.push_back(new_tablets[i].get());
+    }
+    source_lock->mutable_data()->pb.set_split_encoded_key(split_encoded_key);
+
+    RETURN_NOT_OK(sys_catalog_->AddAndUpdateItems(
+        added_tablets, std::vector<TabletInfo*>{source_tablet.get()}, leader_ready_term_));
+
+    for (const auto& new_tablet : new_tablets) {
+      new_tablet->mutable_metadata()->CommitMutation();
+    }
+    source_lock->Commit();
+  }
+
+  // New tablets are not added to the table yet, so clients continue to use the source tablet
+  // until the split is completed.
+  {
+    std::lock_guard<LockType> l(lock_);
+    auto tablet_map_checkout = tablet_map_.CheckOut();
+    for (const auto& new_tablet : new_tablets) {
+      (*tablet_map_checkout)[new_tablet->tablet_id()] = new_tablet;
+    }
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Splitting tablet " << source_tablet->tablet_id() << " into "
+                        << new_tablets[0]->tablet_id() << " and " << new_tablets[1]->tablet_id();
+
+  return SendSplitTabletRequest(
+      source_tablet,
+      std::array<TabletId, 2>{new_tablets[0]->tablet_id(), new_tablets[1]->tablet_id()},
+      split_encoded_key, split_partition_key);
+}
+
+Status CatalogManager::SendSplitTabletRequest(const scoped_refptr<TabletInfo>& source_tablet,
+                                              const std::array<TabletId, 2>& new_tablet_ids,
+                                              const std::string& split_encoded_key,
+                                              const std::string& split_partition_key) {
+  auto call = std::make_shared<AsyncSplitTablet>(
+      master_, worker_pool_.get(), source_tablet, new_tablet_ids, split_encoded_key,
+      split_partition_key);
+  source_tablet->table()->AddTask(call);
+  return call->Run();
+}
+
+Status CatalogManager::ResumeTabletSplit(const scoped_refptr<TabletInfo>& source_tablet) {
+  std::array<TabletId, 2> new_tablet_ids;
+  std::string split_encoded_key;
+  {
+    auto source_lock = source_tablet->LockForRead();
+    const auto& source_pb = source_lock->data().pb;
+    if (source_lock->data().is_deleted() || source_pb.split_tablet_ids_size() == 0) {
+      return Status::OK();
+    }
+    if (source_pb.split_tablet_ids_size() != static_cast<int>(new_tablet_ids.size())) {
+      return STATUS_FORMAT(IllegalState, "Tablet $0 has unexpected number of split tablets: $1",
+                           source_tablet->tablet_id(), source_pb.split_tablet_ids_size());
+    }
+    std::copy(source_pb.split_tablet_ids().begin(), source_pb.split_tablet_ids().end(),
+              new_tablet_ids.begin());
+    split_encoded_key = source_pb.split_encoded_key();
+  }
+
+  // The second new tablet starts at the split partition key.
+  scoped_refptr<TabletInfo> second_tablet;
+  {
+    SharedLock<LockType> l(lock_);
+    second_tablet = FindPtrOrNull(*tablet_map_, new_tablet_ids[1]);
+  }
+  if (!second_tablet) {
+    return STATUS_FORMAT(NotFound, "Tablet $0 split from $1 not found",
+                         new_tablet_ids[1], source_tablet->tablet_id());
+  }
+  std::string split_partition_key;
+  {
+    auto second_lock = second_tablet->LockForRead();
+    if (IsSplitTabletReady(second_lock->data().pb)) {
+      // Split was already applied, waiting for the first new tablet.
+      return Status::OK();
+    }
+    split_partition_key = second_lock->data().pb.partition().partition_key_start();
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Resuming split of tablet " << source_tablet->tablet_id() << " into "
+                        << new_tablet_ids[0] << " and " << new_tablet_ids[1];
+  return SendSplitTabletRequest(
+      source_tablet, new_tablet_ids, split_encoded_key, split_partition_key);
+}
+
+Status CatalogManager::RollbackTabletSplit(const scoped_refptr<TabletInfo>& source_tablet,
+                                           const Status& reason) {
+  RETURN_NOT_OK(CheckIsLeaderAndReady());
+
+  std::vector<TabletId> new_tablet_ids;
+  {
+    auto source_lock = source_tablet->LockForRead();
+    const auto& split_tablet_ids = source_lock->data().pb.split_tablet_ids();
+    if (source_lock->data().is_deleted() || split_tablet_ids.empty()) {
+      return Status::OK();
+    }
+    new_tablet_ids.assign(split_tablet_ids.begin(), split_tablet_ids.end());
+  }
+
+  std::vector<scoped_refptr<TabletInfo>> new_tablets;
+  {
+    SharedLock<LockType> l(lock_);
+    for (const auto& new_tablet_id : new_tablet_ids) {
+      auto new_tablet = FindPtrOrNull(*tablet_map_, new_tablet_id);
+      if (new_tablet) {
+        new_tablets.push_back(std::move(new_tablet));
+      }
+    }
+  }
+
+  auto source_lock = source_tablet->LockForWrite();
+  const auto& split_tablet_ids = source_lock->data().pb.split_tablet_ids();
+  if (source_lock->data().is_deleted() ||
+      !std::equal(split_tablet_ids.begin(), split_tablet_ids.end(),
+                  new_tablet_ids.begin(), new_tablet_ids.end())) {
+    // Split was completed or rolled back concurrently.
+    return Status::OK();
+  }
+  std::vector<std::unique_ptr<TabletInfo::lock_type>> new_tablet_locks;
+  for (const auto& new_tablet : new_tablets) {
+    new_tablet_locks.push_back(new_tablet->LockForWrite());
+    // Tablet servers report the new tablets only after the split was applied.
+    if (new_tablet_locks.back()->data().pb.has_committed_consensus_state()) {
+      return STATUS_FORMAT(IllegalState, "Tablet $0 split from $1 was already created",
+                           new_tablet->tablet_id(), source_tablet->tablet_id());
+    }
+  }
+
+  const std::string rollback_msg = Format("Split rolled back: $0", reason);
+  std::vector<TabletInfo*> updated_tablets = { source_tablet.get() };
+  for (size_t i = 0; i != new_tablets.size(); ++i) {
+    new_tablet_locks[i]->mutable_data()->set_state(SysTabletsEntryPB::DELETED, rollback_msg);
+    updated_tablets.push_back(new_tablets[i].get());
+  }
+  source_lock->mutable_data()->pb.clear_split_tablet_ids();
+  source_lock->mutable_data()->pb.clear_split_encoded_key();
+  RETURN_NOT_OK(sys_catalog_->UpdateItems(updated_tablets, leader_ready_term_));
+
+  for (auto& lock : new_tablet_locks) {
+    lock->Commit();
+  }
+  source_lock->Commit();
+
+  LOG_WITH_PREFIX(INFO) << "Tablet " << source_tablet->tablet_id() << " " << rollback_msg;
+  return Status::OK();
+}
+
+Status CatalogManager::DeleteOrphanedSplitTablets(const TabletInfos& tablets) {
+  std::vector<TabletInfo*> deleted_tablets;
+  std::vector<std::unique_ptr<TabletInfo::lock_type>> tablet_locks;
+  for (const auto& tablet : tablets) {
+    auto tablet_lock = tablet->LockForWrite();
+    if (tablet_lock->data().is_deleted() || tablet_lock->data().is_running()) {
+      continue;
+    }
+    tablet_lock->mutable_data()->set_state(
+        SysTabletsEntryPB::DELETED,
+        Substitute("Split from $0 abandoned", tablet_lock->data().pb.split_parent_tablet_id()));
+    deleted_tablets.push_back(tablet.get());
+    tablet_locks.push_back(std::move(tablet_lock));
+  }
+  if (deleted_tablets.empty()) {
+    return Status::OK();
+  }
+  RETURN_NOT_OK(sys_catalog_->UpdateItems(deleted_tablets, leader_ready_term_));
+
+  for (size_t i = 0; i != deleted_tablets.size(); ++i) {
+    tablet_locks[i]->Commit();
+    LOG_WITH_PREFIX(INFO) << "Deleting tablet " << deleted_tablets[i]->tablet_id()
+                          << " of abandoned split";
+    // The split could be applied by tablet servers before the source tablet was deleted.
+    DeleteTabletReplicas(deleted_tablets[i], "Split abandoned");
+  }
+  return Status::OK();
+}
+
+Status CatalogManager::MaybeCompleteTabletSplit(const TabletId& source_tablet_id) {
+  scoped_refptr<TabletInfo> source_tablet;
+  {
+    SharedLock<LockType> l(lock_);
+    source_tablet = FindPtrOrNull(*tablet_map_, source_tablet_id);
+  }
+  if (!source_tablet) {
+    return STATUS_FORMAT(NotFound, "Split tablet $0 not found", source_tablet_id);
+  }
+
+  std::vector<TabletId> new_tablet_ids;
+  {
+    auto source_lock = source_tablet->LockForRead();
+    if (source_lock->data().is_deleted()) {
+      return Status::OK();
+    }
+    const auto& split_tablet_ids = source_lock->data().pb.split_tablet_ids();
+    new_tablet_ids.assign(split_tablet_ids.begin(), split_tablet_ids.end());
+  }
+  if (new_tablet_ids.size() != 2) {
+    return STATUS_FORMAT(IllegalState, "Tablet $0 has unexpected split tablets: $1",
+                         source_tablet_id, new_tablet_ids);
+  }
+
+  std::vector<scoped_refptr<TabletInfo>> new_tablets;
+  {
+    SharedLock<LockType> l(lock_);
+    for (const auto& new_tablet_id : new_tablet_ids) {
+      auto new_tablet = FindPtrOrNull(*tablet_map_, new_tablet_id);
+      if (!new_tablet) {
+        return STATUS_FORMAT(NotFound, "Tablet $0 split from $1 not found",
+                             new_tablet_id, source_tablet_id);
+      }
+      new_tablets.push_back(std::move(new_tablet));
+    }
+  }
+
+  auto source_lock = source_tablet->LockForWrite();
+  if (source_lock->data().is_deleted()) {
+    return Status::OK();
+  }
+  std::vector<std::unique_ptr<TabletInfo::lock_type>> new_tablet_locks;
+  for (const auto& new_tablet : new_tablets) {
+    new_tablet_locks.push_back(new_tablet->LockForWrite());
+    if (!IsSplitTabletReady(new_tablet_locks.back()->data().pb)) {
+      VLOG_WITH_PREFIX(1) << "Tablet " << new_tablet->tablet_id() << " split from "
+                          << source_tablet_id << " is not ready yet";
+      return Status::OK();
+    }
+  }
+
+  // The split tablet is replaced with the new ones atomically, so the table always covers the
+  // whole key space after a master failover.
+  const std::string split_msg = Format(
+      "Split into $0 and $1 at $2", new_tablet_ids[0], new_tablet_ids[1], LocalTimeAsString());
+  std::vector<TabletInfo*> updated_tablets = { source_tablet.get() };
+  for (size_t i = 0; i != new_tablets.size(); ++i) {
+    new_tablet_locks[i]->mutable_data()->set_state(
+        SysTabletsEntryPB::RUNNING, Substitute("Split from $0 completed", source_tablet_id));
+    updated_tablets.push_back(new_tablets[i].get());
+  }
+  source_lock->mutable_data()->set_state(SysTabletsEntryPB::DELETED, split_msg);
+  RETURN_NOT_OK(sys_catalog_->UpdateItems(updated_tablets, leader_ready_term_));
+
+  for (auto& lock : new_tablet_locks) {
+    lock->Commit();
+  }
+  source_lock->Commit();
+
+  // The first new tablet has the same partition start as the source tablet, so it replaces the
+  // source tablet in the table.
+  source_tablet->table()->AddTablets({ new_tablets[0].get(), new_tablets[1].get() });
+
+  LOG_WITH_PREFIX(INFO) << "Tablet " << source_tablet_id << " " << split_msg;
+  DeleteTabletReplicas(source_tablet.get(), split_msg);
+  return Status::OK();
+}
+
+void CatalogManager::StartTabletSplitsIfNeeded() {
+  const bool auto_split_enabled = FLAGS_tablet_split_size_threshold_bytes > 0 ||
+                                  FLAGS_tablet_split_ops_per_sec_threshold > 0;
+
+  TabletInfos tablets;
+  {
+    SharedLock<LockType> l(lock_);
+    for (const auto& entry : *tablet_map_) {
+      tablets.push_back(entry.second);
+    }
+  }
+
+  int outstanding_splits = 0;
+  TabletInfos tablets_to_split;
+  TabletInfos splits_to_resume;
+  TabletInfos orphaned_tablets;
+  for (const auto& tablet : tablets) {
+    if (!tablet->table()) {
+      continue;
+    }
+    if (tablet->HasSplitTasks()) {
+      ++outstanding_splits;
+      continue;
+    }
+    std::string split_parent_tablet_id;
+    {
+      auto table_lock = tablet->table()->LockForRead();
+      auto tablet_lock = tablet->LockForRead();
+      const auto& tablet_data = tablet_lock->data();
+      if (tablet_data.is_deleted()) {
+        continue;
+      }
+      if (tablet_data.pb.split_tablet_ids_size() != 0) {
+        // Split task failed, or was lost on master failover.
+        ++outstanding_splits;
+        splits_to_resume.push_back(tablet);
+        continue;
+      }
+      if (!tablet_data.pb.split_parent_tablet_id().empty()) {
+        if (!tablet_data.is_running()) {
+          split_parent_tablet_id = tablet_data.pb.split_parent_tablet_id();
+        }
+      } else if (!auto_split_enabled ||
+                 !CheckTabletSplittable(table_lock->data(), tablet_data).ok()) {
+        continue;
+      }
+    }
+    if (!split_parent_tablet_id.empty()) {
+      // Source tablet is deleted when the split is completed, so the new tablet that is not
+      // running yet was abandoned.
+      scoped_refptr<TabletInfo> parent;
+      {
+        SharedLock<LockType> l(lock_);
+        parent = FindPtrOrNull(*tablet_map_, split_parent_tablet_id);
+      }
+      if (!parent || parent->LockForRead()->data().is_deleted()) {
+        orphaned_tablets.push_back(tablet);
+      }
+      continue;
+    }
+
+    auto leader = tablet->GetLeader();
+    TSDescriptor::TabletLoad load;
+    if (!leader.ok() || !(*leader)->GetTabletLoad(tablet->tablet_id(), &load)) {
+      continue;
+    }
+    const double ops_per_sec = load.read_ops_per_sec + load.write_ops_per_sec;
+    if ((FLAGS_tablet_split_size_threshold_bytes > 0 &&
+         load.sst_file_size >= static_cast<uint64_t>(FLAGS_tablet_split_size_threshold_bytes)) ||
+        (FLAGS_tablet_split_ops_per_sec_threshold > 0 &&
+         ops_per_sec >= FLAGS_tablet_split_ops_per_sec_threshold)) {
+      VLOG_WITH_PREFIX(1) << "Tablet " << tablet->tablet_id() << " should be split, SST size: "
+                          << load.sst_file_size << ", ops/sec: " << ops_per_sec;
+      tablets_to_split.push_back(tablet);
+    }
+  }
+
+  for (const auto& tablet : splits_to_resume) {
+    WARN_NOT_OK(ResumeTabletSplit(tablet),
+                Format("Failed to resume split of tablet $0", tablet->tablet_id()));
+  }
+  WARN_NOT_OK(DeleteOrphanedSplitTablets(orphaned_tablets),
+              "Failed to delete tablets of abandoned splits");
+
+  for (const auto& tablet : tablets_to_split) {
+    if (outstanding_splits >= FLAGS_max_outstanding_tablet_splits) {
+      break;
+    }
+    const Status s = SplitTablet(tablet->tablet_id());
+    if (s.ok()) {
+      ++outstanding_splits;
+    } else {
+      LOG_WITH_PREFIX(WARNING) << "Failed to start split of tablet " << tablet->tablet_id()
+                               << ": " << s;
+    }
+  }
+}
+
 Status CatalogManager::IsTruncateTableDone(const IsTruncateTableDoneRequestPB* req,
                                            IsTruncateTableDoneResponsePB* resp) {
   LOG(INFO) << "Servicing IsTruncateTableDone request for table id " << req->table_id();
@@ -3667,6 +4140,7 @@ bool ShouldTransitionTabletToRunning(const ReportedTabletPB& report) {
   // Otherwise, we only transition to RUNNING once a leader is elected.
   return report.committed_consensus_state().has_leader_uuid();
 }
+
 }  // anonymous namespace
 
 Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
@@ -3702,6 +4176,7 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
   // to change the state. Can we change CowedObject to lazily do the copy?
   auto table_lock = tablet->table()->LockForRead();
   auto tablet_lock = tablet->LockForWrite();
+  const TabletId split_parent_tablet_id = tablet_lock->data().pb.split_parent_tablet_id();
 
   // If the TS is reporting a tablet which has been deleted, or a tablet from
   // a table which has been deleted, send it an RPC to delete it.
@@ -3794,7 +4269,9 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
     // could incorrectly consider a tablet created when only a minority of its replicas
     // were successful. In that case, the tablet would be stuck in this bad state
     // forever.
-    if (!tablet_lock->data().is_running() && ShouldTransitionTabletToRunning(report)) {
+    // New tablets created by a split are marked as RUNNING together, when the split completes.
+    if (!tablet_lock->data().is_running() && ShouldTransitionTabletToRunning(report) &&
+        split_parent_tablet_id.empty()) {
       DCHECK_EQ(SysTabletsEntryPB::CREATING, tablet_lock->data().pb.state())
           << "Tablet in unexpected state: " << tablet->ToString()
           << ": " << tablet_lock->data().pb.ShortDebugString();
@@ -3909,8 +4386,14 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
       return s;
     }
   }
+  const bool split_tablet_not_running =
+      !split_parent_tablet_id.empty() && !tablet_lock->data().is_running();
   tablet_lock->Commit();
 
+  if (split_tablet_not_running && ShouldTransitionTabletToRunning(report)) {
+    RETURN_NOT_OK(MaybeCompleteTabletSplit(split_parent_tablet_id));
+  }
+
   // Need to defer the AlterTable command to after we've committed the new tablet data,
   // since the tablet report may also be updating the raft config, and the Alter Table
   // request needs to know who the most recent leader is.
@@ -5206,6 +5689,11 @@ void CatalogManager::ExtractTabletsToProcess(
       continue;
     }
 
+    // New tablets created by a split are assigned by the tablet servers of the split tablet.
+    if (!tablet_lock->data().pb.split_parent_tablet_id().empty()) {
+      continue;
+    }
+
     // Running tablets.
     if (tablet_lock->data().is_running()) {
       // TODO: handle last update > not responding timeout?
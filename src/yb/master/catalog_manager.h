@@ -33,6 +33,7 @@
 #ifndef YB_MASTER_CATALOG_MANAGER_H
 #define YB_MASTER_CATALOG_MANAGER_H
 
+#include <array>
 #include <list>
 #include <map>
 #include <set>
@@ -235,6 +236,12 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Get the information about an in-progress truncate operation.
   CHECKED_STATUS IsTruncateTableDone(const IsTruncateTableDoneRequestPB* req,
                                      IsTruncateTableDoneResponsePB* resp);
+
+  // Start splitting the specified tablet into two tablets. The split key is chosen by the tablet
+  // leader, so the new tablets have approximately the same size. The split completes
+  // asynchronously, after both new tablets elect their leaders.
+  CHECKED_STATUS SplitTablet(const TabletId& tablet_id);
+
   // Delete the specified table.
   //
   // The RPC context is provided for logging/tracing purposes,
@@ -805,6 +812,42 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Loops through the "not created" tablets and sends a CreateTablet() request.
   CHECKED_STATUS ProcessPendingAssignments(const TabletInfos& tablets);
 
+  // Starts splits of the tablets that are larger or more loaded than the configured thresholds.
+  // Also resumes the splits whose tasks failed and deletes the new tablets of abandoned splits.
+  void StartTabletSplitsIfNeeded();
+
+  // Returns OK if the tablet could be split. Requires read locks on the table and the tablet.
+  CHECKED_STATUS CheckTabletSplittable(const PersistentTableInfo& table_data,
+                                       const PersistentTabletInfo& tablet_data);
+
+  // Creates the new tablets for the split of 'source_tablet' at the given key and sends the
+  // SplitTablet() RPC to the leader of the source tablet.
+  CHECKED_STATUS DoSplitTablet(const scoped_refptr<TabletInfo>& source_tablet,
+                               const std::string& split_encoded_key,
+                               const std::string& split_partition_key);
+
+  // Sends the SplitTablet() RPC to the leader of the source tablet.
+  CHECKED_STATUS SendSplitTabletRequest(const scoped_refptr<TabletInfo>& source_tablet,
+                                        const std::array<TabletId, 2>& new_tablet_ids,
+                                        const std::string& split_encoded_key,
+                                        const std::string& split_partition_key);
+
+  // Resends the SplitTablet() RPC for the split of 'source_tablet' that was started, but whose
+  // task failed or was lost on master failover.
+  CHECKED_STATUS ResumeTabletSplit(const scoped_refptr<TabletInfo>& source_tablet);
+
+  // Rolls back the split of 'source_tablet' that was rejected by its leader before the split was
+  // replicated. The new tablets are deleted, so the source tablet could be split again.
+  CHECKED_STATUS RollbackTabletSplit(const scoped_refptr<TabletInfo>& source_tablet,
+                                     const Status& reason);
+
+  // Deletes the new tablets whose split did not complete before the source tablet was deleted,
+  // e.g. because its table was dropped.
+  CHECKED_STATUS DeleteOrphanedSplitTablets(const TabletInfos& tablets);
+
+  // Replaces the split tablet with the new ones, when both of them are reported to be running.
+  CHECKED_STATUS MaybeCompleteTabletSplit(const TabletId& source_tablet_id);
+
   // Given 'two_choices', which should be a vector of exactly two elements, select which
   // one is the better choice for a new replica.
   std::shared_ptr<TSDescriptor> PickBetterReplicaLocation(const TSDescriptorVector& two_choices);
@@ -1104,6 +1147,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Async operations are accessing some private methods
   // (TODO: this stuff should be deferred and done in the background thread)
   friend class AsyncAlterTable;
+  friend class AsyncGetSplitKey;
+  friend class AsyncSplitTablet;
 
   // Number of live tservers metric.
   scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_servers_live_;
@@ -140,6 +140,7 @@ void CatalogManagerBgTasks::Run() {
         }
       } else {
         catalog_manager_->load_balance_policy_->RunLoadBalancer();
+        catalog_manager_->StartTabletSplitsIfNeeded();
       }
 
       if (!to_delete.empty()) {
@@ -14,6 +14,7 @@
 #include "yb/master/cluster_balance.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include <boost/thread/locks.hpp>
@@ -22,10 +23,13 @@
 #include "yb/master/master.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 
 #include "yb/master/catalog_entity_info.h"
 #include "yb/util/shared_lock.h"
 
+using namespace yb::size_literals;
+
 DEFINE_bool(enable_load_balancing,
             true,
             "Choose whether to enable the load balancing algorithm, to move tablets around.");
@@ -68,6 +72,26 @@ DEFINE_int32(load_balancer_num_idle_runs,
              5,
              "Number of idle runs of load balancer to deem it idle.");
 
+DEFINE_bool(load_balancer_balance_by_tablet_load, false,
+            "Balance the tablet and leader load reported by the tablet servers, instead of the "
+            "number of tablet replicas and leaders. The load of a replica is 1 plus its ops and "
+            "on-disk size, scaled by load_balancer_ops_per_load_unit and "
+            "load_balancer_sst_bytes_per_load_unit.");
+TAG_FLAG(load_balancer_balance_by_tablet_load, advanced);
+TAG_FLAG(load_balancer_balance_by_tablet_load, runtime);
+
+DEFINE_double(load_balancer_ops_per_load_unit, 100,
+              "Read plus write ops per second of a tablet replica, that are as costly as hosting "
+              "one more replica. Used when load_balancer_balance_by_tablet_load is set.");
+TAG_FLAG(load_balancer_ops_per_load_unit, advanced);
+TAG_FLAG(load_balancer_ops_per_load_unit, runtime);
+
+DEFINE_int64(load_balancer_sst_bytes_per_load_unit, 1_GB,
+             "SST files size of a tablet replica, that is as costly as hosting one more replica. "
+             "Used when load_balancer_balance_by_tablet_load is set.");
+TAG_FLAG(load_balancer_sst_bytes_per_load_unit, advanced);
+TAG_FLAG(load_balancer_sst_bytes_per_load_unit, runtime);
+
 DEFINE_test_flag(bool, load_balancer_handle_under_replicated_tablets_only, false,
                  "Limit the functionality of the load balancer during tests so tests can make "
                  "progress")
@@ -536,7 +560,7 @@ void ClusterLoadBalancer::DumpSortedLoad() const {
   out << "Table load: ";
   for (int left = 0; left <= last_pos; ++left) {
     const TabletServerId& uuid = state_->sorted_load_[left];
-    int load = state_->GetLoad(uuid);
+    double load = state_->GetLoad(uuid);
     out << uuid << ":" << load << " ";
   }
   VLOG(1) << out.str();
@@ -573,7 +597,7 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      int load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || load_variance < state_->options_->kMinLoadVarianceToBalance) {
@@ -650,6 +674,12 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
 
   bool same_placement = state_->per_ts_meta_[from_ts].descriptor->placement_id() ==
                         state_->per_ts_meta_[to_ts].descriptor->placement_id();
+  // When balancing by tablet load, any of the candidates below could be picked, so keep the one
+  // that leaves the two TSs closest in load. Moving a tablet only lowers the load of the busier of
+  // the two TSs if the tablet load is below the load difference between them.
+  const bool by_tablet_load = FLAGS_load_balancer_balance_by_tablet_load;
+  const double load_variance = state_->GetLoad(from_ts) - state_->GetLoad(to_ts);
+  double best_remaining_variance = load_variance;
   for (const auto& tablet_id : non_over_replicated_tablets) {
     const auto& placement_info = GetPlacementByTablet(tablet_id);
     // TODO(bogdan): this should be augmented as well to allow dropping by one replica, if still
@@ -669,11 +699,40 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
     // If we got here, it means we either have no placement, in which case we can pick any TS, or
     // we have placement and it's valid to move across these two tablet servers, so set the tablet
     // and leave.
-    *moving_tablet_id = tablet_id;
-    return true;
+    if (!by_tablet_load) {
+      *moving_tablet_id = tablet_id;
+      return true;
+    }
+    const double remaining_variance =
+        std::abs(load_variance - 2 * state_->GetTabletLoad(tablet_id));
+    if (remaining_variance < best_remaining_variance) {
+      best_remaining_variance = remaining_variance;
+      *moving_tablet_id = tablet_id;
+    }
   }
   // If we couldn't select a tablet above, we have to return failure.
-  return false;
+  return by_tablet_load && best_remaining_variance < load_variance;
+}
+
+void ClusterLoadBalancer::SortLeadersToMove(
+    double load_variance, bool from_leader_blacklisted, vector<TabletId>* tablet_ids) const {
+  // Moving a leader only lowers the leader load of the busier TS if the load of the leader is below
+  // the load difference, unless the leader has to be moved away from a leader blacklisted TS.
+  if (!from_leader_blacklisted) {
+    tablet_ids->erase(
+        std::remove_if(tablet_ids->begin(), tablet_ids->end(), [this, load_variance](
+            const TabletId& tablet_id) {
+          return state_->GetTabletLeaderLoad(tablet_id) >= load_variance;
+        }),
+        tablet_ids->end());
+  }
+  // Prefer the leaders that leave the two TSs closest in leader load.
+  std::stable_sort(
+      tablet_ids->begin(), tablet_ids->end(), [this, load_variance](
+          const TabletId& lhs, const TabletId& rhs) {
+        return std::abs(load_variance - 2 * state_->GetTabletLeaderLoad(lhs)) <
+               std::abs(load_variance - 2 * state_->GetTabletLeaderLoad(rhs));
+      });
 }
 
 Result<bool> ClusterLoadBalancer::GetLeaderToMove(
@@ -688,7 +747,7 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
     auto high_leader_blacklisted = (state_->leader_blacklisted_servers_.find(high_load_uuid) !=
       state_->leader_blacklisted_servers_.end());
     if (high_leader_blacklisted) {
-      int high_load = state_->GetLeaderLoad(high_load_uuid);
+      double high_load = state_->GetLeaderLoad(high_load_uuid);
       if (high_load > 0) {
         // Leader blacklisted tserver with a leader replica.
         break;
@@ -743,7 +802,7 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
       auto high_leader_blacklisted = (state_->leader_blacklisted_servers_.find(high_load_uuid) !=
           state_->leader_blacklisted_servers_.end());
-      int load_variance =
+      double load_variance =
           state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
 
       // Check for state change or end conditions.
@@ -762,9 +821,12 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       // If there are, we have a candidate we want, so fill in the output params and return.
       const set<TabletId>& leaders = state_->per_ts_meta_[high_load_uuid].leaders;
       const set<TabletId>& peers = state_->per_ts_meta_[low_load_uuid].running_tablets;
-      set<TabletId> intersection;
-      const auto& itr = std::inserter(intersection, intersection.begin());
+      vector<TabletId> intersection;
+      const auto& itr = std::back_inserter(intersection);
       std::set_intersection(leaders.begin(), leaders.end(), peers.begin(), peers.end(), itr);
+      if (FLAGS_load_balancer_balance_by_tablet_load) {
+        SortLeadersToMove(load_variance, high_leader_blacklisted, &intersection);
+      }
 
       for (const auto& tablet_id : intersection) {
         *moving_tablet_id = tablet_id;
@@ -823,12 +885,12 @@ Result<bool> ClusterLoadBalancer::HandleRemoveReplicas(
 
     const auto& tablet_meta = state_->per_tablet_meta_[tablet_id];
     const auto& tablet_servers = tablet_meta.over_replicated_tablet_servers;
-    auto comparator = ClusterLoadState::Comparator(state_.get());
     vector<TabletServerId> sorted_ts(tablet_servers.begin(), tablet_servers.end());
     if (sorted_ts.empty()) {
       return STATUS_SUBSTITUTE(IllegalState, "No tservers to remove from over-replicated "
                                              "tablet $0", tablet_id);
     }
+    auto comparator = ClusterLoadState::Comparator(state_.get(), sorted_ts);
     // Sort in reverse to first try to remove a replica from the highest loaded TS.
     sort(sorted_ts.rbegin(), sorted_ts.rend(), comparator);
     string remove_candidate = sorted_ts[0];
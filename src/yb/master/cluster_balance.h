@@ -225,6 +225,12 @@ class ClusterLoadBalancer {
   Result<bool> GetLeaderToMove(
       TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts);
 
+  // Used when balancing by tablet load. Drops the leaders which are too loaded to be moved between
+  // two TSs with the given leader load difference, and orders the rest by how well their move
+  // would balance the two TSs.
+  void SortLeadersToMove(
+      double load_variance, bool from_leader_blacklisted, std::vector<TabletId>* tablet_ids) const;
+
   // Issue the change config and modify the in-memory state for moving a replica from one tablet
   // server to another.
   CHECKED_STATUS MoveReplica(
@@ -48,6 +48,12 @@ DECLARE_int32(load_balancer_max_concurrent_removals);
 
 DECLARE_int32(load_balancer_max_concurrent_moves);
 
+DECLARE_bool(load_balancer_balance_by_tablet_load);
+
+DECLARE_double(load_balancer_ops_per_load_unit);
+
+DECLARE_int64(load_balancer_sst_bytes_per_load_unit);
+
 namespace yb {
 namespace master {
 
@@ -121,6 +127,11 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Estimated load of a replica and of the leader of this tablet, when balancing by tablet load.
+  // Both are 1, i.e. the same as for counting replicas, if no load was reported for the tablet.
+  double replica_load = 1;
+  double leader_load = 1;
+
   std::string ToString() const {
     return Format("{ running: $0 starting: $1 is_under_replicated: $2 "
                       "under_replicated_placements: $3 is_over_replicated: $4 "
@@ -192,8 +203,11 @@ class ClusterLoadState {
 
   // Comparators used for sorting by load.
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
-    int load_a = GetLoad(a);
-    int load_b = GetLoad(b);
+    return CompareByLoad(a, GetLoad(a), b, GetLoad(b));
+  }
+
+  bool CompareByLoad(const TabletServerId& a, double load_a,
+                     const TabletServerId& b, double load_b) const {
     if (load_a == load_b) {
       return a < b;
     } else {
@@ -205,24 +219,51 @@ class ClusterLoadState {
     return CompareByUuid(a.ts_desc->permanent_uuid(), b.ts_desc->permanent_uuid());
   }
 
+  // Loads of a set of TSs, computed once before sorting them. GetLoad and GetLeaderLoad iterate
+  // over all the tablets of a TS when balancing by tablet load, so they are too expensive to be
+  // called for every comparison.
+  typedef std::unordered_map<TabletServerId, double> TSLoads;
+
   // Comparator functor to be able to wrap around the public but non-static compare methods that
   // end up using internal state of the class.
   struct Comparator {
-    explicit Comparator(ClusterLoadState* state) : state_(state) {}
+    Comparator(ClusterLoadState* state, const std::vector<TabletServerId>& ts_uuids)
+        : state_(state), loads_(std::make_shared<TSLoads>()) {
+      loads_->reserve(ts_uuids.size());
+      for (const auto& ts_uuid : ts_uuids) {
+        loads_->emplace(ts_uuid, state_->GetLoad(ts_uuid));
+      }
+    }
+
     bool operator()(const TabletServerId& a, const TabletServerId& b) {
-      return state_->CompareByUuid(a, b);
+      return state_->CompareByLoad(a, GetLoad(a), b, GetLoad(b));
     }
 
     bool operator()(const TabletReplica& a, const TabletReplica& b) {
-      return state_->CompareByReplica(a, b);
+      return (*this)(a.ts_desc->permanent_uuid(), b.ts_desc->permanent_uuid());
+    }
+
+    // Falls back to computing the load of TSs that were not given at construction.
+    double GetLoad(const TabletServerId& ts_uuid) const {
+      auto it = loads_->find(ts_uuid);
+      return it != loads_->end() ? it->second : state_->GetLoad(ts_uuid);
     }
 
     ClusterLoadState* state_;
+    // Shared, as std::sort copies the comparator.
+    std::shared_ptr<TSLoads> loads_;
   };
 
   // Comparator to sort tablet servers' leader load.
   struct LeaderLoadComparator {
-    explicit LeaderLoadComparator(ClusterLoadState* state) : state_(state) {}
+    LeaderLoadComparator(ClusterLoadState* state, const std::vector<TabletServerId>& ts_uuids)
+        : state_(state), leader_loads_(std::make_shared<TSLoads>()) {
+      leader_loads_->reserve(ts_uuids.size());
+      for (const auto& ts_uuid : ts_uuids) {
+        leader_loads_->emplace(ts_uuid, state_->GetLeaderLoad(ts_uuid));
+      }
+    }
+
     bool operator()(const TabletServerId& a, const TabletServerId& b) {
       // Primary criteria: whether tserver is leader blacklisted.
       auto a_leader_blacklisted =
@@ -234,20 +275,58 @@ class ClusterLoadState {
       }
 
       // Secondary criteria: tserver leader load.
-      return state_->GetLeaderLoad(a) < state_->GetLeaderLoad(b);
+      return leader_loads_->at(a) < leader_loads_->at(b);
     }
     ClusterLoadState* state_;
+    // Shared, as std::sort copies the comparator.
+    std::shared_ptr<TSLoads> leader_loads_;
   };
 
   // Get the load for a certain TS.
-  int GetLoad(const TabletServerId& ts_uuid) const {
+  double GetLoad(const TabletServerId& ts_uuid) const {
     const auto& ts_meta = per_ts_meta_.at(ts_uuid);
-    return ts_meta.starting_tablets.size() + ts_meta.running_tablets.size();
+    if (!FLAGS_load_balancer_balance_by_tablet_load) {
+      return ts_meta.starting_tablets.size() + ts_meta.running_tablets.size();
+    }
+    double load = 0;
+    for (const auto& tablet_id : ts_meta.starting_tablets) {
+      load += GetTabletLoad(tablet_id);
+    }
+    for (const auto& tablet_id : ts_meta.running_tablets) {
+      load += GetTabletLoad(tablet_id);
+    }
+    return load;
   }
 
   // Get the load for a certain TS.
-  int GetLeaderLoad(const TabletServerId& ts_uuid) const {
-    return per_ts_meta_.at(ts_uuid).leaders.size();
+  double GetLeaderLoad(const TabletServerId& ts_uuid) const {
+    const auto& leaders = per_ts_meta_.at(ts_uuid).leaders;
+    if (!FLAGS_load_balancer_balance_by_tablet_load) {
+      return leaders.size();
+    }
+    double load = 0;
+    for (const auto& tablet_id : leaders) {
+      load += GetTabletLeaderLoad(tablet_id);
+    }
+    return load;
+  }
+
+  // Get the load that a replica of a certain tablet adds to the TS hosting it.
+  double GetTabletLoad(const TabletId& tablet_id) const {
+    if (!FLAGS_load_balancer_balance_by_tablet_load) {
+      return 1;
+    }
+    auto it = per_tablet_meta_.find(tablet_id);
+    return it != per_tablet_meta_.end() ? it->second.replica_load : 1;
+  }
+
+  // Get the load that the leader of a certain tablet adds to the TS hosting it.
+  double GetTabletLeaderLoad(const TabletId& tablet_id) const {
+    if (!FLAGS_load_balancer_balance_by_tablet_load) {
+      return 1;
+    }
+    auto it = per_tablet_meta_.find(tablet_id);
+    return it != per_tablet_meta_.end() ? it->second.leader_load : 1;
   }
 
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
@@ -267,6 +346,9 @@ class ClusterLoadState {
     // Get replicas for this tablet.
     TabletInfo::ReplicaMap replica_map;
     GetReplicaLocations(tablet, &replica_map);
+    if (FLAGS_load_balancer_balance_by_tablet_load) {
+      UpdateTabletLoad(tablet_id, replica_map, &tablet_meta);
+    }
     // Set state information for both the tablet and the tablet server replicas.
     for (const auto& replica : replica_map) {
       const auto& ts_uuid = replica.first;
@@ -396,6 +478,39 @@ class ClusterLoadState {
     return Status::OK();
   }
 
+  // Estimate the load of the tablet from the loads reported by the TSs hosting its replicas. Only
+  // the leader serves reads, so the busiest replica is used as the estimate of the load that any
+  // replica of this tablet would add, wherever it is placed.
+  void UpdateTabletLoad(const TabletId& tablet_id, const TabletInfo::ReplicaMap& replica_map,
+                        CBTabletMetadata* tablet_meta) {
+    double max_replica_load = 0;
+    double leader_load = 0;
+    for (const auto& replica : replica_map) {
+      TSDescriptor::TabletLoad load;
+      if (replica.second.ts_desc == nullptr ||
+          !replica.second.ts_desc->GetTabletLoad(tablet_id, &load)) {
+        continue;
+      }
+      double replica_load = 0;
+      if (FLAGS_load_balancer_ops_per_load_unit > 0) {
+        replica_load += (load.read_ops_per_sec + load.write_ops_per_sec) /
+                        FLAGS_load_balancer_ops_per_load_unit;
+      }
+      if (FLAGS_load_balancer_sst_bytes_per_load_unit > 0) {
+        replica_load += static_cast<double>(load.sst_file_size) /
+                        FLAGS_load_balancer_sst_bytes_per_load_unit;
+      }
+      max_replica_load = std::max(max_replica_load, replica_load);
+      if (replica.second.role == consensus::RaftPeerPB::LEADER &&
+          FLAGS_load_balancer_ops_per_load_unit > 0) {
+        leader_load = (load.read_ops_per_sec + load.write_ops_per_sec) /
+                      FLAGS_load_balancer_ops_per_load_unit;
+      }
+    }
+    tablet_meta->replica_load = 1 + max_replica_load;
+    tablet_meta->leader_load = 1 + leader_load;
+  }
+
   virtual void UpdateTabletServer(std::shared_ptr<TSDescriptor> ts_desc) {
     const auto& ts_uuid = ts_desc->permanent_uuid();
     // Set and get, so we can use this for both tablet servers we've added data to, as well as
@@ -585,7 +700,7 @@ class ClusterLoadState {
   }
 
   void SortLoad() {
-    auto comparator = Comparator(this);
+    auto comparator = Comparator(this, sorted_load_);
     sort(sorted_load_.begin(), sorted_load_.end(), comparator);
   }
 
@@ -605,7 +720,7 @@ class ClusterLoadState {
   }
 
   virtual void SortLeaderLoad() {
-    auto leader_count_comparator = LeaderLoadComparator(this);
+    auto leader_count_comparator = LeaderLoadComparator(this, sorted_leader_load_);
     sort(sorted_leader_load_.begin(), sorted_leader_load_.end(), leader_count_comparator);
   }
 
@@ -633,8 +748,10 @@ class ClusterLoadState {
   }
 
   inline bool IsLeaderLoadBelowThreshold(const TabletServerId& ts_uuid) {
+    // The threshold is a number of leaders, so it is not compared with the weighted leader load.
     return ((leader_balance_threshold_ > 0) &&
-            (GetLeaderLoad(ts_uuid) <= leader_balance_threshold_));
+            (static_cast<int>(per_ts_meta_.at(ts_uuid).leaders.size()) <=
+                leader_balance_threshold_));
   }
 
   void AdjustLeaderBalanceThreshold() {
@@ -182,6 +182,12 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     ts_desc->UpdateMetrics(req->metrics());
   }
 
+  // Tablet loads are reported along with the metrics, once per metrics interval, so keep the
+  // previous ones otherwise. A TS without tablets sends an empty list, which clears its loads.
+  if (req->has_metrics() && req->has_tablet_report()) {
+    ts_desc->UpdateTabletLoads(req->tablet_report().tablet_loads());
+  }
+
   if (req->has_tablet_report()) {
     s = server_->catalog_manager()->ProcessTabletReport(
       ts_desc.get(), req->tablet_report(), resp->mutable_tablet_report(), &rpc);
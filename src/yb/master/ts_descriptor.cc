@@ -259,6 +259,30 @@ void TSDescriptor::UpdateMetrics(const TServerMetricsPB& metrics) {
   ts_metrics_.uptime_seconds = metrics.uptime_seconds();
 }
 
+void TSDescriptor::UpdateTabletLoads(
+    const google::protobuf::RepeatedPtrField<ReportedTabletLoadPB>& tablet_loads) {
+  std::unordered_map<std::string, TabletLoad> new_loads;
+  new_loads.reserve(tablet_loads.size());
+  for (const auto& tablet_load : tablet_loads) {
+    auto& load = new_loads[tablet_load.tablet_id()];
+    load.read_ops_per_sec = tablet_load.read_ops_per_sec();
+    load.write_ops_per_sec = tablet_load.write_ops_per_sec();
+    load.sst_file_size = tablet_load.sst_file_size();
+  }
+  std::lock_guard<decltype(lock_)> l(lock_);
+  tablet_loads_.swap(new_loads);
+}
+
+bool TSDescriptor::GetTabletLoad(const std::string& tablet_id, TabletLoad* load) const {
+  SharedLock<decltype(lock_)> l(lock_);
+  auto it = tablet_loads_.find(tablet_id);
+  if (it == tablet_loads_.end()) {
+    return false;
+  }
+  *load = it->second;
+  return true;
+}
+
 bool TSDescriptor::HasTabletDeletePending() const {
   SharedLock<decltype(lock_)> l(lock_);
   return !tablets_pending_delete_.empty();
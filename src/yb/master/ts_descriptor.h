@@ -37,6 +37,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "yb/gutil/gscoped_ptr.h"
 
@@ -240,6 +241,21 @@ class TSDescriptor {
 
   void UpdateMetrics(const TServerMetricsPB& metrics);
 
+  // Load of a tablet replica hosted by this tablet server, as of the last tablet load report.
+  struct TabletLoad {
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+    uint64_t sst_file_size = 0;
+  };
+
+  // Replaces the known tablet loads with the ones from the given report. The report contains all
+  // the tablets of this tablet server, so tablets missing from it are forgotten.
+  void UpdateTabletLoads(
+      const google::protobuf::RepeatedPtrField<ReportedTabletLoadPB>& tablet_loads);
+
+  // Returns false if the load of the given tablet was not reported by this tablet server yet.
+  bool GetTabletLoad(const std::string& tablet_id, TabletLoad* load) const;
+
   void ClearMetrics() {
     ts_metrics_.ClearMetrics();
   }
@@ -349,6 +365,9 @@ class TSDescriptor {
   // Set of tablet uuids for which a delete is pending on this tablet server.
   std::set<std::string> tablets_pending_delete_;
 
+  // Map from tablet uuid to its load on this tablet server.
+  std::unordered_map<std::string, TabletLoad> tablet_loads_;
+
   // Capabilities of this tablet server.
   google::protobuf::RepeatedField<CapabilityId> capabilities_;
 
@@ -155,6 +155,17 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
   }
 }
 
+CompressionType GetCompressionTypeForOutputSize(const ImmutableCFOptions& ioptions,
+                                                int level, int base_level,
+                                                uint64_t estimated_output_size,
+                                                const bool enable_compression) {
+  if (enable_compression && ioptions.large_compaction_output_min_size != 0 &&
+      estimated_output_size >= ioptions.large_compaction_output_min_size) {
+    return ioptions.large_compaction_output_compression;
+  }
+  return GetCompressionType(ioptions, level, base_level, enable_compression);
+}
+
 CompactionPicker::CompactionPicker(const ImmutableCFOptions& ioptions,
                                    const InternalKeyComparator* icmp)
     : ioptions_(ioptions), icmp_(icmp) {}
@@ -500,6 +511,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
 
     std::vector<CompactionInputFiles> inputs(vstorage->num_levels() -
                                              start_level);
+    uint64_t estimated_total_size = 0;
     for (int level = start_level; level < vstorage->num_levels(); level++) {
       inputs[level - start_level].level = level;
       auto& files = inputs[level - start_level].files;
@@ -510,12 +522,13 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         *manual_conflict = true;
         return nullptr;
       }
+      estimated_total_size += TotalFileSize(files);
     }
     auto c = std::make_unique<Compaction>(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
         /* max_grandparent_overlap_bytes */ LLONG_MAX, output_path_id,
-        GetCompressionType(ioptions_, output_level, 1),
+        GetCompressionTypeForOutputSize(ioptions_, output_level, 1, estimated_total_size),
         /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ true);
     if (start_level == 0) {
       level0_compactions_in_progress_.insert(c.get());
@@ -1715,7 +1728,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, start_level, 1, enable_compression),
+      GetCompressionTypeForOutputSize(
+          ioptions_, start_level, 1, estimated_total_size, enable_compression),
       /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
       false /* deletion_compaction */, compaction_reason);
 }
@@ -1837,7 +1851,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
       vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
       /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, vstorage->num_levels() - 1, 1),
+      GetCompressionTypeForOutputSize(
+          ioptions_, vstorage->num_levels() - 1, 1, estimated_total_size),
       /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
       false /* deletion_compaction */,
       CompactionReason::kUniversalSizeAmplification);
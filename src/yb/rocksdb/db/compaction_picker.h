@@ -373,6 +373,13 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
                                    int level, int base_level,
                                    const bool enable_compression = true);
 
+// Same as GetCompressionType, but uses large_compaction_output_compression when estimated
+// output size of universal compaction is big enough.
+CompressionType GetCompressionTypeForOutputSize(const ImmutableCFOptions& ioptions,
+                                                int level, int base_level,
+                                                uint64_t estimated_output_size,
+                                                const bool enable_compression = true);
+
 }  // namespace rocksdb
 
 #endif // YB_ROCKSDB_DB_COMPACTION_PICKER_H
@@ -1474,6 +1474,58 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+TEST_F(DBTestUniversalCompaction, LargeCompactionOutputCompression) {
+  if (!Snappy_Supported()) {
+    return;
+  }
+
+  constexpr int kNumFiles = 4;
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.write_buffer_size = 100_KB;
+  options.level0_file_num_compaction_trigger = kNumFiles;
+  options = CurrentOptions(options);
+  options.compression = kNoCompression;
+  options.large_compaction_output_compression = kSnappyCompression;
+
+  auto check_compression = [this](const std::string& expected, size_t expected_num_files) {
+    TablePropertiesCollection props;
+    ASSERT_OK(db_->GetPropertiesOfAllTables(&props));
+    ASSERT_EQ(expected_num_files, props.size());
+    for (const auto& file_and_props : props) {
+      ASSERT_EQ(expected, file_and_props.second->compression_name) << file_and_props.first;
+    }
+  };
+
+  // Output of the compaction is smaller than the threshold, so it stays uncompressed.
+  // The second time the threshold is low enough, so compaction output is compressed.
+  for (uint64_t min_size : {1_GB, 1_KB}) {
+    options.large_compaction_output_min_size = min_size;
+    DestroyAndReopen(options);
+
+    Random rnd(301);
+    int key_idx = 0;
+    for (int num = 0; num < kNumFiles - 1; num++) {
+      for (int i = 0; i < 10; i++) {
+        ASSERT_OK(Put(Key(key_idx++), CompressibleString(&rnd, 1000)));
+      }
+      ASSERT_OK(Flush());
+    }
+    // Flushes always use options.compression.
+    check_compression(CompressionTypeToString(kNoCompression), kNumFiles - 1);
+
+    for (int i = 0; i < 10; i++) {
+      ASSERT_OK(Put(Key(key_idx++), CompressibleString(&rnd, 1000)));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+    ASSERT_EQ(1, NumSortedRuns());
+    check_compression(
+        CompressionTypeToString(min_size == 1_KB ? kSnappyCompression : kNoCompression), 1);
+  }
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
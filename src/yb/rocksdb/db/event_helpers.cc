@@ -71,7 +71,8 @@ void EventHelpers::LogAndNotifyTableFileCreation(
             << "num_filter_blocks" << info.table_properties.num_filter_blocks
             << "num_data_index_blocks" << info.table_properties.num_data_index_blocks
             << "filter_policy_name" <<
-                info.table_properties.filter_policy_name;
+                info.table_properties.filter_policy_name
+            << "compression" << info.table_properties.compression_name;
 
     // user collected properties
     for (const auto& prop : info.table_properties.readable_properties) {
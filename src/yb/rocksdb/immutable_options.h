@@ -109,6 +109,10 @@ struct ImmutableCFOptions {
 
   std::vector<CompressionType> compression_per_level;
 
+  CompressionType large_compaction_output_compression;
+
+  uint64_t large_compaction_output_min_size;
+
   CompressionOptions compression_opts;
 
   bool level_compaction_dynamic_level_bytes;
@@ -374,6 +374,20 @@ struct ColumnFamilyOptions {
   // change when data grows.
   std::vector<CompressionType> compression_per_level;
 
+  // Compression used for outputs of universal compactions, whose estimated size is at least
+  // large_compaction_output_min_size. It allows to use a fast algorithm for flushes and small
+  // compactions, and one with better compression ratio for large files, that hold most of the
+  // data and are rarely rewritten.
+  //
+  // Default: kNoCompression, not used while large_compaction_output_min_size is 0.
+  CompressionType large_compaction_output_compression;
+
+  // Minimal estimated output size of universal compaction, to use
+  // large_compaction_output_compression for it. 0 means that it is not used.
+  //
+  // Default: 0
+  uint64_t large_compaction_output_min_size;
+
   // different options for compression algorithms
   CompressionOptions compression_opts;
 
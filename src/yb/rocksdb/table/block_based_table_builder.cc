@@ -770,6 +770,7 @@ Status BlockBasedTableBuilder::Finish() {
       PropertyBlockBuilder property_block_builder;
       r->props.filter_policy_name = r->table_options.filter_policy != nullptr ?
           r->table_options.filter_policy->Name() : "";
+      r->props.compression_name = CompressionTypeToString(r->compression_type);
       r->props.data_index_size =
           r->data_index_builder->EstimatedSize() + kBlockTrailerSize;
 
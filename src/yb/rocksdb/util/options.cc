@@ -80,6 +80,8 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       use_fsync(options.use_fsync),
       compression(options.compression),
       compression_per_level(options.compression_per_level),
+      large_compaction_output_compression(options.large_compaction_output_compression),
+      large_compaction_output_min_size(options.large_compaction_output_min_size),
       compression_opts(options.compression_opts),
       level_compaction_dynamic_level_bytes(
           options.level_compaction_dynamic_level_bytes),
@@ -104,6 +106,8 @@ ColumnFamilyOptions::ColumnFamilyOptions()
       min_write_buffer_number_to_merge(1),
       max_write_buffer_number_to_maintain(0),
       compression(Snappy_Supported() ? kSnappyCompression : kNoCompression),
+      large_compaction_output_compression(kNoCompression),
+      large_compaction_output_min_size(0),
       prefix_extractor(nullptr),
       num_levels(7),
       level0_file_num_compaction_trigger(4),
@@ -162,6 +166,8 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
           options.max_write_buffer_number_to_maintain),
       compression(options.compression),
       compression_per_level(options.compression_per_level),
+      large_compaction_output_compression(options.large_compaction_output_compression),
+      large_compaction_output_min_size(options.large_compaction_output_min_size),
       compression_opts(options.compression_opts),
       prefix_extractor(options.prefix_extractor),
       num_levels(options.num_levels),
@@ -443,6 +449,12 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       RHEADER(log, "         Options.compression: %s",
           CompressionTypeToString(compression).c_str());
     }
+  if (large_compaction_output_min_size != 0) {
+    RHEADER(log, "  Options.large_compaction_output_compression: %s",
+        CompressionTypeToString(large_compaction_output_compression).c_str());
+    RHEADER(log, "     Options.large_compaction_output_min_size: %" PRIu64,
+        large_compaction_output_min_size);
+  }
   RHEADER(log, "      Options.prefix_extractor: %s",
       prefix_extractor == nullptr ? "nullptr" : prefix_extractor->Name());
   RHEADER(log, "            Options.num_levels: %d", num_levels);
@@ -0,0 +1,740 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/compressed_stream.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include <lz4.h>
+#include <snappy.h>
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/circular_read_buffer.h"
+#include "yb/rpc/outbound_data.h"
+
+#include "yb/util/coding.h"
+#include "yb/util/faststring.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/net/sockaddr.h"
+#include "yb/util/size_literals.h"
+
+using namespace std::literals;
+using namespace yb::size_literals;
+
+DEFINE_int32(stream_compression_algo, 2,
+             "Compression algorithm proposed by the client side of compressed connections: "
+             "0 - no compression, 1 - Snappy, 2 - LZ4.");
+TAG_FLAG(stream_compression_algo, advanced);
+
+DEFINE_int32(stream_compression_min_size_bytes, 1_KB,
+             "Outbound data smaller than this size is sent uncompressed over compressed "
+             "connections.");
+TAG_FLAG(stream_compression_min_size_bytes, advanced);
+
+DEFINE_int32(stream_compression_fallback_secs, 300,
+             "After a server rejected the compression handshake, connections to it are not "
+             "compressed for this number of seconds. Servers that do not listen with compression "
+             "reject the handshake.");
+TAG_FLAG(stream_compression_fallback_secs, advanced);
+
+DECLARE_int32(rpc_max_message_size);
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+// The handshake consists of the magic followed by one byte of StreamCompressionAlgo.
+// Regular YB connections start with "YB\1", so the third byte distinguishes them.
+const char kHandshakeMagic[] = { 'Y', 'B', 'Z' };
+constexpr size_t kHandshakeSize = sizeof(kHandshakeMagic) + 1;
+
+// Each frame starts with the fixed 32 bit size of its payload, followed by the fixed 32 bit size
+// of the uncompressed payload. The latter is zero when the payload is not compressed.
+constexpr size_t kFrameHeaderSize = 8;
+
+class CompressedOutboundData : public OutboundData {
+ public:
+  typedef boost::container::small_vector<RefCntBuffer, 4> Buffers;
+
+  CompressedOutboundData(Buffers buffers, OutboundDataPtr lower_data)
+      : buffers_(std::move(buffers)), lower_data_(std::move(lower_data)) {}
+
+  void Transferred(const Status& status, Connection* conn) override {
+    if (lower_data_) {
+      lower_data_->Transferred(status, conn);
+    }
+  }
+
+  bool DumpPB(const DumpRunningRpcsRequestPB& req, RpcCallInProgressPB* resp) override {
+    return false;
+  }
+
+  void Serialize(boost::container::small_vector_base<RefCntBuffer>* output) override {
+    for (auto& buffer : buffers_) {
+      output->push_back(std::move(buffer));
+    }
+  }
+
+  std::string ToString() const override {
+    return Format("Compressed[$0]", lower_data_);
+  }
+
+ private:
+  Buffers buffers_;
+  OutboundDataPtr lower_data_;
+};
+
+Result<StreamCompressionAlgo> ParseAlgo(int value) {
+  if (value < 0 || static_cast<size_t>(value) >= kStreamCompressionAlgoMapSize) {
+    return STATUS_FORMAT(InvalidArgument, "Unknown stream compression algorithm: $0", value);
+  }
+  return static_cast<StreamCompressionAlgo>(value);
+}
+
+// Remote endpoints that rejected the compression handshake, with the time until which connections
+// to them are not compressed.
+class UncompressedPeers {
+ public:
+  void Add(const Endpoint& remote) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    until_[remote] = CoarseMonoClock::Now() + FLAGS_stream_compression_fallback_secs * 1s;
+  }
+
+  bool Contains(const Endpoint& remote) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = until_.find(remote);
+    if (it == until_.end()) {
+      return false;
+    }
+    if (it->second <= CoarseMonoClock::Now()) {
+      until_.erase(it);
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<Endpoint, CoarseTimePoint, EndpointHash> until_;
+};
+
+IoVecs SkipPrefix(const IoVecs& data, size_t skip) {
+  IoVecs result;
+  for (const auto& iov : data) {
+    if (skip >= iov.iov_len) {
+      skip -= iov.iov_len;
+      continue;
+    }
+    result.push_back(iovec{static_cast<char*>(iov.iov_base) + skip, iov.iov_len - skip});
+    skip = 0;
+  }
+  return result;
+}
+
+class CompressedStream : public Stream, public StreamContext {
+ public:
+  CompressedStream(std::unique_ptr<Stream> lower_stream, size_t receive_buffer_size,
+                   const MemTrackerPtr& buffer_tracker,
+                   std::shared_ptr<UncompressedPeers> uncompressed_peers)
+      : lower_stream_(std::move(lower_stream)),
+        compressed_read_buffer_(receive_buffer_size, buffer_tracker),
+        uncompressed_peers_(std::move(uncompressed_peers)) {
+  }
+
+  CompressedStream(const CompressedStream&) = delete;
+  void operator=(const CompressedStream&) = delete;
+
+  size_t GetPendingWriteBytes() override {
+    return lower_stream_->GetPendingWriteBytes();
+  }
+
+ private:
+  CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
+  void Close() override;
+  void Shutdown(const Status& status) override;
+  size_t Send(OutboundDataPtr data) override;
+  CHECKED_STATUS TryWrite() override;
+  void ParseReceived() override;
+
+  void Cancelled(size_t handle) override {
+    LOG_WITH_PREFIX(DFATAL) << "Cancel is not supported for compressed stream: " << handle;
+  }
+
+  bool Idle(std::string* reason_not_idle) override;
+  bool IsConnected() override;
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
+
+  const Endpoint& Remote() override;
+  const Endpoint& Local() override;
+
+  const Protocol* GetProtocol() override {
+    return CompressedStreamProtocol();
+  }
+
+  // Implementation StreamContext
+  void UpdateLastActivity() override;
+  void UpdateLastRead() override;
+  void UpdateLastWrite() override;
+  void Transferred(const OutboundDataPtr& data, const Status& status) override;
+  void Destroy(const Status& status) override;
+  Result<ProcessDataResult> ProcessReceived(
+      const IoVecs& data, ReadBufferFull read_buffer_full) override;
+  void Connected() override;
+
+  StreamReadBuffer& ReadBuffer() override {
+    return compressed_read_buffer_;
+  }
+
+  // Processes handshake received from the other side. Returns true if handshake is complete.
+  Result<bool> ProcessHandshake(const IoVecs& data);
+
+  // Processes data that follows the handshake.
+  Result<ProcessDataResult> ProcessAfterHandshake(
+      const IoVecs& data, ReadBufferFull read_buffer_full);
+
+  // Processes received frames until the read buffer of the upper layer context is full.
+  // Returns the number of consumed bytes.
+  Result<size_t> ProcessFrames(const IoVecs& data);
+
+  // StartFrame, FinishFrame and Deliver return false when the read buffer of the upper layer
+  // context is full, so the rest of uncompressed data was kept in undelivered_.
+  Result<bool> StartFrame();
+  Result<bool> FinishFrame();
+
+  // Passes uncompressed data to the upper layer context.
+  Result<bool> Deliver(Slice data);
+
+  void SendHandshake(StreamCompressionAlgo algo);
+  void Established(CompressedStreamState state);
+
+  // Returns compressed frame for specified buffers, or empty buffer when compression does not
+  // reduce the size of data.
+  RefCntBuffer Compress(const CompressedOutboundData::Buffers& buffers, size_t size);
+  CHECKED_STATUS Uncompress(const Slice& input, char* output, size_t output_size);
+
+  std::string ToString() override;
+
+  std::unique_ptr<Stream> lower_stream_;
+  StreamContext* context_ = nullptr;
+  CompressedStreamState state_ = CompressedStreamState::kInitial;
+  StreamCompressionAlgo algo_ = StreamCompressionAlgo::kNone;
+  bool need_connect_ = false;
+  std::vector<OutboundDataPtr> pending_data_;
+
+  CircularReadBuffer compressed_read_buffer_;
+
+  // Header of the frame that is being received.
+  uint8_t frame_header_[kFrameHeaderSize];
+  size_t frame_header_size_ = 0;
+  // Number of payload bytes of the current frame that were not received yet.
+  size_t frame_left_ = 0;
+  // Uncompressed size of the current frame, zero if frame is not compressed.
+  size_t frame_uncompressed_size_ = 0;
+  // Received part of the current compressed frame.
+  faststring frame_data_;
+  faststring uncompressed_data_;
+  // Uncompressed data that did not fit into the read buffer of the upper layer context. Received
+  // data is not processed until it is delivered.
+  std::string undelivered_;
+
+  std::shared_ptr<UncompressedPeers> uncompressed_peers_;
+
+  faststring compress_input_;
+  faststring compress_output_;
+};
+
+Status CompressedStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context) {
+  context_ = context;
+  need_connect_ = connect;
+  return lower_stream_->Start(connect, loop, this);
+}
+
+void CompressedStream::Close() {
+  lower_stream_->Close();
+}
+
+void CompressedStream::Shutdown(const Status& status) {
+  for (auto& data : pending_data_) {
+    if (data) {
+      context_->Transferred(data, status);
+    }
+  }
+  pending_data_.clear();
+
+  lower_stream_->Shutdown(status);
+}
+
+size_t CompressedStream::Send(OutboundDataPtr data) {
+  switch (state_) {
+  case CompressedStreamState::kInitial:
+  case CompressedStreamState::kHandshake:
+    pending_data_.push_back(std::move(data));
+    return std::numeric_limits<size_t>::max();
+  case CompressedStreamState::kEnabled: {
+      CompressedOutboundData::Buffers buffers;
+      data->Serialize(&buffers);
+      size_t size = 0;
+      for (const auto& buffer : buffers) {
+        size += buffer.size();
+      }
+      CompressedOutboundData::Buffers output;
+      if (size >= static_cast<size_t>(FLAGS_stream_compression_min_size_bytes)) {
+        auto compressed = Compress(buffers, size);
+        if (compressed) {
+          output.push_back(std::move(compressed));
+        }
+      }
+      if (output.empty()) {
+        RefCntBuffer header(kFrameHeaderSize);
+        EncodeFixed32(header.udata(), static_cast<uint32_t>(size));
+        EncodeFixed32(header.udata() + 4, 0);
+        output.push_back(std::move(header));
+        for (auto& buffer : buffers) {
+          output.push_back(std::move(buffer));
+        }
+      }
+      lower_stream_->Send(std::make_shared<CompressedOutboundData>(
+          std::move(output), std::move(data)));
+    }
+    return std::numeric_limits<size_t>::max();
+  case CompressedStreamState::kDisabled:
+    return lower_stream_->Send(std::move(data));
+  }
+
+  return std::numeric_limits<size_t>::max();
+}
+
+RefCntBuffer CompressedStream::Compress(
+    const CompressedOutboundData::Buffers& buffers, size_t size) {
+  Slice input;
+  if (buffers.size() == 1) {
+    input = Slice(buffers[0].data(), buffers[0].size());
+  } else {
+    compress_input_.clear();
+    for (const auto& buffer : buffers) {
+      compress_input_.append(buffer.data(), buffer.size());
+    }
+    input = Slice(compress_input_);
+  }
+
+  size_t compressed_size = 0;
+  switch (algo_) {
+    case StreamCompressionAlgo::kSnappy:
+      compress_output_.resize(snappy::MaxCompressedLength(size));
+      snappy::RawCompress(
+          input.cdata(), input.size(), pointer_cast<char*>(compress_output_.data()),
+          &compressed_size);
+      break;
+    case StreamCompressionAlgo::kLz4: {
+      auto max_size = LZ4_compressBound(static_cast<int>(size));
+      compress_output_.resize(max_size);
+      auto result = LZ4_compress_default(
+          input.cdata(), pointer_cast<char*>(compress_output_.data()), static_cast<int>(size),
+          max_size);
+      if (result <= 0) {
+        return RefCntBuffer();
+      }
+      compressed_size = result;
+      break;
+    }
+    case StreamCompressionAlgo::kNone:
+      return RefCntBuffer();
+  }
+
+  if (compressed_size >= size) {
+    return RefCntBuffer();
+  }
+
+  RefCntBuffer result(kFrameHeaderSize + compressed_size);
+  EncodeFixed32(result.udata(), static_cast<uint32_t>(compressed_size));
+  EncodeFixed32(result.udata() + 4, static_cast<uint32_t>(size));
+  memcpy(result.udata() + kFrameHeaderSize, compress_output_.data(), compressed_size);
+  return result;
+}
+
+Status CompressedStream::Uncompress(const Slice& input, char* output, size_t output_size) {
+  switch (algo_) {
+    case StreamCompressionAlgo::kSnappy: {
+      size_t uncompressed_size = 0;
+      if (!snappy::GetUncompressedLength(input.cdata(), input.size(), &uncompressed_size) ||
+          uncompressed_size != output_size ||
+          !snappy::RawUncompress(input.cdata(), input.size(), output)) {
+        return STATUS_FORMAT(Corruption, "Failed to uncompress snappy frame of $0 bytes",
+                             input.size());
+      }
+      return Status::OK();
+    }
+    case StreamCompressionAlgo::kLz4: {
+      auto result = LZ4_decompress_safe(
+          input.cdata(), output, static_cast<int>(input.size()), static_cast<int>(output_size));
+      if (result != static_cast<int>(output_size)) {
+        return STATUS_FORMAT(Corruption, "Failed to uncompress LZ4 frame of $0 bytes: $1",
+                             input.size(), result);
+      }
+      return Status::OK();
+    }
+    case StreamCompressionAlgo::kNone:
+      break;
+  }
+
+  return STATUS_FORMAT(IllegalState, "Compressed frame received with algorithm: $0", algo_);
+}
+
+Status CompressedStream::TryWrite() {
+  return lower_stream_->TryWrite();
+}
+
+void CompressedStream::ParseReceived() {
+  if (!undelivered_.empty()) {
+    std::string undelivered;
+    undelivered.swap(undelivered_);
+    auto delivered = Deliver(undelivered);
+    if (!delivered.ok()) {
+      context_->Destroy(delivered.status());
+      return;
+    }
+    if (!*delivered) {
+      return;
+    }
+  }
+  lower_stream_->ParseReceived();
+}
+
+bool CompressedStream::Idle(std::string* reason) {
+  return lower_stream_->Idle(reason);
+}
+
+bool CompressedStream::IsConnected() {
+  return lower_stream_->IsConnected();
+}
+
+void CompressedStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
+  lower_stream_->DumpPB(req, resp);
+}
+
+const Endpoint& CompressedStream::Remote() {
+  return lower_stream_->Remote();
+}
+
+const Endpoint& CompressedStream::Local() {
+  return lower_stream_->Local();
+}
+
+std::string CompressedStream::ToString() {
+  return Format("COMPRESSED $0 $1 $2", state_, algo_, lower_stream_->ToString());
+}
+
+void CompressedStream::UpdateLastActivity() {
+  context_->UpdateLastActivity();
+}
+
+void CompressedStream::UpdateLastRead() {
+  context_->UpdateLastRead();
+}
+
+void CompressedStream::UpdateLastWrite() {
+  context_->UpdateLastWrite();
+}
+
+void CompressedStream::Transferred(const OutboundDataPtr& data, const Status& status) {
+  context_->Transferred(data, status);
+}
+
+void CompressedStream::Destroy(const Status& status) {
+  if (need_connect_ && state_ == CompressedStreamState::kHandshake) {
+    // Servers that do not listen with compression close the connection on our handshake.
+    LOG_WITH_PREFIX(INFO) << "Connection closed during compression handshake, next connections to "
+                          << Remote() << " are not compressed: " << status;
+    uncompressed_peers_->Add(Remote());
+  }
+  context_->Destroy(status);
+}
+
+Result<ProcessDataResult> CompressedStream::ProcessReceived(
+    const IoVecs& data, ReadBufferFull read_buffer_full) {
+  switch (state_) {
+    case CompressedStreamState::kInitial: {
+      if (need_connect_) {
+        return STATUS(NetworkError, "Data received before compression handshake was sent");
+      }
+      char header[kHandshakeSize];
+      auto header_size = std::min(IoVecsFullSize(data), kHandshakeSize);
+      IoVecsToBuffer(data, 0, header_size, header);
+      if (memcmp(header, kHandshakeMagic, std::min(header_size, sizeof(kHandshakeMagic))) != 0) {
+        // Peer does not use compression.
+        Established(CompressedStreamState::kDisabled);
+        return ProcessReceived(data, read_buffer_full);
+      }
+      if (!VERIFY_RESULT(ProcessHandshake(data))) {
+        return ProcessDataResult{0, Slice()};
+      }
+      return ProcessAfterHandshake(data, read_buffer_full);
+    }
+
+    case CompressedStreamState::kHandshake: {
+      if (!VERIFY_RESULT(ProcessHandshake(data))) {
+        return ProcessDataResult{0, Slice()};
+      }
+      return ProcessAfterHandshake(data, read_buffer_full);
+    }
+
+    case CompressedStreamState::kDisabled:
+      return context_->ProcessReceived(data, read_buffer_full);
+
+    case CompressedStreamState::kEnabled: {
+      if (!undelivered_.empty()) {
+        return ProcessDataResult{0, Slice()};
+      }
+      return ProcessDataResult{ VERIFY_RESULT(ProcessFrames(data)), Slice() };
+    }
+  }
+
+  return STATUS_FORMAT(IllegalState, "Unexpected state: $0", to_underlying(state_));
+}
+
+Result<bool> CompressedStream::ProcessHandshake(const IoVecs& data) {
+  if (IoVecsFullSize(data) < kHandshakeSize) {
+    return false;
+  }
+  char header[kHandshakeSize];
+  IoVecsToBuffer(data, 0, kHandshakeSize, header);
+  if (memcmp(header, kHandshakeMagic, sizeof(kHandshakeMagic)) != 0) {
+    return STATUS_FORMAT(NetworkError, "Invalid compression handshake: $0",
+                         Slice(header, kHandshakeSize).ToDebugHexString());
+  }
+  auto algo = ParseAlgo(static_cast<uint8_t>(header[sizeof(kHandshakeMagic)]));
+  if (algo.ok()) {
+    algo_ = *algo;
+  } else if (need_connect_) {
+    // Server replies with an algorithm that it accepted, so it should be known to us.
+    return algo.status();
+  } else {
+    // Use no compression when client proposed an algorithm that is not known to the server.
+    LOG_WITH_PREFIX(WARNING) << algo.status();
+    algo_ = StreamCompressionAlgo::kNone;
+  }
+  if (!need_connect_) {
+    SendHandshake(algo_);
+  }
+
+  Established(algo_ == StreamCompressionAlgo::kNone ? CompressedStreamState::kDisabled
+                                                    : CompressedStreamState::kEnabled);
+  return true;
+}
+
+Result<ProcessDataResult> CompressedStream::ProcessAfterHandshake(
+    const IoVecs& data, ReadBufferFull read_buffer_full) {
+  auto rest = SkipPrefix(data, kHandshakeSize);
+  if (rest.empty()) {
+    return ProcessDataResult{kHandshakeSize, Slice()};
+  }
+  auto result = VERIFY_RESULT(ProcessReceived(rest, read_buffer_full));
+  result.consumed += kHandshakeSize;
+  return result;
+}
+
+Result<size_t> CompressedStream::ProcessFrames(const IoVecs& data) {
+  size_t consumed = 0;
+  for (const auto& iov : data) {
+    Slice input(static_cast<const char*>(iov.iov_base), iov.iov_len);
+    while (!input.empty()) {
+      bool delivered = true;
+      if (frame_header_size_ < kFrameHeaderSize) {
+        auto len = std::min(input.size(), kFrameHeaderSize - frame_header_size_);
+        memcpy(frame_header_ + frame_header_size_, input.data(), len);
+        frame_header_size_ += len;
+        input.remove_prefix(len);
+        consumed += len;
+        if (frame_header_size_ == kFrameHeaderSize) {
+          delivered = VERIFY_RESULT(StartFrame());
+        }
+      } else {
+        auto len = std::min(input.size(), frame_left_);
+        Slice chunk(input.data(), len);
+        input.remove_prefix(len);
+        consumed += len;
+        frame_left_ -= len;
+        if (frame_uncompressed_size_ == 0) {
+          // Uncompressed frames are passed to the upper layer without buffering.
+          delivered = VERIFY_RESULT(Deliver(chunk));
+        } else {
+          frame_data_.append(chunk.data(), chunk.size());
+        }
+        if (frame_left_ == 0) {
+          delivered = VERIFY_RESULT(FinishFrame()) && delivered;
+        }
+      }
+      if (!delivered) {
+        // The rest of data is processed after the upper layer drains its read buffer.
+        return consumed;
+      }
+    }
+  }
+
+  return consumed;
+}
+
+Result<bool> CompressedStream::StartFrame() {
+  frame_left_ = DecodeFixed32(frame_header_);
+  frame_uncompressed_size_ = DecodeFixed32(frame_header_ + 4);
+  if (frame_uncompressed_size_ != 0) {
+    // Sender compresses data only when it reduces the size, so compressed frame could not be
+    // larger than uncompressed one.
+    if (frame_uncompressed_size_ > static_cast<size_t>(FLAGS_rpc_max_message_size) ||
+        frame_left_ >= frame_uncompressed_size_) {
+      return STATUS_FORMAT(
+          NetworkError, "Invalid compressed frame, size: $0, uncompressed size: $1, max: $2",
+          frame_left_, frame_uncompressed_size_, FLAGS_rpc_max_message_size);
+    }
+    frame_data_.clear();
+    frame_data_.reserve(frame_left_);
+  }
+  if (frame_left_ == 0) {
+    return FinishFrame();
+  }
+  return true;
+}
+
+Result<bool> CompressedStream::FinishFrame() {
+  frame_header_size_ = 0;
+  if (frame_uncompressed_size_ == 0) {
+    return true;
+  }
+  uncompressed_data_.resize(frame_uncompressed_size_);
+  RETURN_NOT_OK(Uncompress(
+      Slice(frame_data_), pointer_cast<char*>(uncompressed_data_.data()),
+      frame_uncompressed_size_));
+  VLOG_WITH_PREFIX(4) << "Uncompressed frame: " << frame_data_.size() << " => "
+                      << frame_uncompressed_size_;
+  frame_data_.clear();
+  return Deliver(Slice(uncompressed_data_));
+}
+
+Result<bool> CompressedStream::Deliver(Slice data) {
+  auto& read_buffer = context_->ReadBuffer();
+  while (!data.empty()) {
+    auto out = read_buffer.PrepareAppend();
+    if (!out.ok()) {
+      if (!out.status().IsBusy()) {
+        return out.status();
+      }
+      // The upper layer is still processing the data it received. It calls ParseReceived once it
+      // is done, and the rest of data is delivered from there.
+      VLOG_WITH_PREFIX(4) << "Read buffer is full, " << data.size() << " bytes left";
+      undelivered_.assign(data.cdata(), data.size());
+      return false;
+    }
+    size_t appended = 0;
+    for (const auto& iov : *out) {
+      auto len = std::min(iov.iov_len, data.size());
+      memcpy(iov.iov_base, data.data(), len);
+      appended += len;
+      data.remove_prefix(len);
+      if (data.empty()) {
+        break;
+      }
+    }
+    read_buffer.DataAppended(appended);
+    if (read_buffer.ReadyToRead()) {
+      auto temp = VERIFY_RESULT(context_->ProcessReceived(
+          read_buffer.AppendedVecs(), ReadBufferFull(read_buffer.Full())));
+      read_buffer.Consume(temp.consumed, temp.buffer);
+    }
+  }
+
+  return true;
+}
+
+void CompressedStream::Connected() {
+  if (need_connect_) {
+    if (uncompressed_peers_->Contains(Remote())) {
+      // The server rejected the handshake recently, so connect without compression.
+      Established(CompressedStreamState::kDisabled);
+      return;
+    }
+    auto algo = ParseAlgo(FLAGS_stream_compression_algo);
+    if (!algo.ok()) {
+      context_->Destroy(algo.status());
+      return;
+    }
+    state_ = CompressedStreamState::kHandshake;
+    ResetLogPrefix();
+    SendHandshake(*algo);
+  }
+}
+
+void CompressedStream::SendHandshake(StreamCompressionAlgo algo) {
+  RefCntBuffer buffer(kHandshakeSize);
+  memcpy(buffer.data(), kHandshakeMagic, sizeof(kHandshakeMagic));
+  buffer.data()[sizeof(kHandshakeMagic)] = static_cast<char>(algo);
+  CompressedOutboundData::Buffers buffers;
+  buffers.push_back(std::move(buffer));
+  lower_stream_->Send(std::make_shared<CompressedOutboundData>(std::move(buffers), nullptr));
+}
+
+void CompressedStream::Established(CompressedStreamState state) {
+  VLOG_WITH_PREFIX(4) << "Established with state: " << state << ", algo: " << algo_;
+
+  state_ = state;
+  ResetLogPrefix();
+  context_->Connected();
+  for (auto& data : pending_data_) {
+    Send(std::move(data));
+  }
+  pending_data_.clear();
+}
+
+} // namespace
+
+const Protocol* CompressedStreamProtocol() {
+  static Protocol result("tcpc");
+  return &result;
+}
+
+StreamFactoryPtr CompressedStreamFactory(
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker) {
+  class CompressedStreamFactory : public StreamFactory {
+   public:
+    CompressedStreamFactory(
+        StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker)
+        : lower_layer_factory_(std::move(lower_layer_factory)), buffer_tracker_(buffer_tracker),
+          uncompressed_peers_(std::make_shared<UncompressedPeers>()) {
+    }
+
+   private:
+    std::unique_ptr<Stream> Create(const StreamCreateData& data) override {
+      auto receive_buffer_size = data.socket->GetReceiveBufferSize();
+      if (!receive_buffer_size.ok()) {
+        LOG(WARNING) << "Compressed stream failure: " << receive_buffer_size.status();
+        receive_buffer_size = 256_KB;
+      }
+      auto lower_stream = lower_layer_factory_->Create(data);
+      return std::make_unique<CompressedStream>(
+          std::move(lower_stream), *receive_buffer_size, buffer_tracker_, uncompressed_peers_);
+    }
+
+    StreamFactoryPtr lower_layer_factory_;
+    MemTrackerPtr buffer_tracker_;
+    std::shared_ptr<UncompressedPeers> uncompressed_peers_;
+  };
+
+  return std::make_shared<CompressedStreamFactory>(std::move(lower_layer_factory), buffer_tracker);
+}
+
+} // namespace rpc
+} // namespace yb
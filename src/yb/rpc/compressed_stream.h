@@ -0,0 +1,44 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_COMPRESSED_STREAM_H
+#define YB_RPC_COMPRESSED_STREAM_H
+
+#include "yb/rpc/stream.h"
+
+#include "yb/util/enums.h"
+
+namespace yb {
+namespace rpc {
+
+YB_DEFINE_ENUM(CompressedStreamState, (kInitial)(kHandshake)(kEnabled)(kDisabled));
+
+// Compression algorithms that could be negotiated by the compressed stream.
+// Values are sent over the wire, so existing entries should not be reordered.
+YB_DEFINE_ENUM(StreamCompressionAlgo, (kNone)(kSnappy)(kLz4));
+
+// Stream that compresses data passed to the lower layer stream.
+//
+// The client side proposes an algorithm in a small header sent right after the connection is
+// established, and the server side replies with the algorithm it accepted. After that, each
+// outbound data is sent as a separate frame, that is compressed only when it is big enough.
+// The server side falls back to pass through mode when the connection does not start with the
+// compression header, so uncompressed clients could still connect to it.
+const Protocol* CompressedStreamProtocol();
+StreamFactoryPtr CompressedStreamFactory(
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker);
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_COMPRESSED_STREAM_H
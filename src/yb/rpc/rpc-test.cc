@@ -45,6 +45,7 @@
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/secure_stream.h"
 #include "yb/rpc/serialization.h"
 #include "yb/rpc/tcp_stream.h"
@@ -63,6 +64,7 @@ DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_int32(num_connections_to_server);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_int32(stream_compression_algo);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -884,5 +886,99 @@ TEST_F(TestRpcSecure, TLS) {
   ASSERT_EQ(30, resp.result());
 }
 
+class TestRpcCompression : public RpcTestBase {
+ public:
+  void SetUp() override {
+    RpcTestBase::SetUp();
+    TestServerOptions options;
+    StartTestServerWithGeneratedCode(
+        CreateCompressedMessenger("TestServer"), &server_hostport_, options);
+  }
+
+ protected:
+  std::unique_ptr<Messenger> CreateCompressedMessenger(const std::string& name) {
+    auto builder = CreateMessengerBuilder(name);
+    builder.SetListenProtocol(CompressedStreamProtocol());
+    builder.AddStreamFactory(
+        CompressedStreamProtocol(),
+        CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker()));
+    return EXPECT_RESULT(builder.Build());
+  }
+
+  void CheckCalls(Messenger* client_messenger, const Protocol* protocol) {
+    ProxyCache proxy_cache(client_messenger);
+    rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport_, protocol);
+
+    RpcController controller;
+    controller.set_timeout(5s);
+    rpc_test::AddRequestPB add_req;
+    add_req.set_x(10);
+    add_req.set_y(20);
+    rpc_test::AddResponsePB add_resp;
+    ASSERT_OK(p.Add(add_req, &add_resp, &controller));
+    ASSERT_EQ(30, add_resp.result());
+
+    // Payloads of different sizes, so both compressed and uncompressed frames are sent.
+    for (size_t size : {10, 10000, 1000000}) {
+      std::string data;
+      while (data.size() < size) {
+        data += "compressible payload " + std::to_string(data.size() % 100) + " ";
+      }
+      controller.Reset();
+      controller.set_timeout(5s);
+      rpc_test::EchoRequestPB echo_req;
+      echo_req.set_data(data);
+      rpc_test::EchoResponsePB echo_resp;
+      ASSERT_OK(p.Echo(echo_req, &echo_resp, &controller));
+      ASSERT_EQ(data, echo_resp.data());
+    }
+  }
+
+  HostPort server_hostport_;
+};
+
+TEST_F(TestRpcCompression, Compression) {
+  for (auto algo : {StreamCompressionAlgo::kNone, StreamCompressionAlgo::kSnappy,
+                    StreamCompressionAlgo::kLz4}) {
+    LOG(INFO) << "Algorithm: " << algo;
+    FLAGS_stream_compression_algo = to_underlying(algo);
+    auto client_messenger = CreateCompressedMessenger("Client");
+    CheckCalls(client_messenger.get(), CompressedStreamProtocol());
+    client_messenger->Shutdown();
+  }
+}
+
+TEST_F(TestRpcCompression, UncompressedClient) {
+  // Server should fall back to pass through mode for clients that do not use compression.
+  auto client_messenger = CreateMessenger("Client");
+  CheckCalls(client_messenger.get(), TcpStream::StaticProtocol());
+  client_messenger->Shutdown();
+}
+
+TEST_F(TestRpcCompression, UncompressedServer) {
+  // Restart server without compression, as servers that do not have it enabled yet.
+  TestServerOptions options;
+  StartTestServerWithGeneratedCode(CreateMessenger("TestServer"), &server_hostport_, options);
+
+  auto client_messenger = CreateCompressedMessenger("Client");
+  {
+    // The server rejects compression handshake, so the first connection fails.
+    ProxyCache proxy_cache(client_messenger.get());
+    rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport_, CompressedStreamProtocol());
+    RpcController controller;
+    controller.set_timeout(5s);
+    rpc_test::AddRequestPB add_req;
+    add_req.set_x(10);
+    add_req.set_y(20);
+    rpc_test::AddResponsePB add_resp;
+    auto status = p.Add(add_req, &add_resp, &controller);
+    LOG(INFO) << "First call status: " << status;
+  }
+
+  // Following connections fall back to no compression.
+  CheckCalls(client_messenger.get(), CompressedStreamProtocol());
+  client_messenger->Shutdown();
+}
+
 } // namespace rpc
 } // namespace yb
@@ -77,6 +77,10 @@ class RpcController {
   // etc) with another one.
   void Swap(RpcController* other);
 
+  // Makes this controller report the result of the finished call of other controller, so failure
+  // of a single call could be reported to several callers.
+  void ShareFinishedCall(const RpcController& other);
+
   // Reset this controller so it may be used with another call.
   // Note that reset doesn't reset controller's properties except the call itself.
   void Reset();
@@ -73,6 +73,8 @@ class MonitoredTask : public std::enable_shared_from_this<MonitoredTask> {
     ASYNC_SNAPSHOT_OP,
     ASYNC_COPARTITION_TABLE,
     ASYNC_FLUSH_TABLETS,
+    ASYNC_GET_SPLIT_KEY,
+    ASYNC_SPLIT_TABLET,
   };
 
   virtual Type type() const = 0;
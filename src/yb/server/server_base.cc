@@ -44,7 +44,9 @@
 #include "yb/gutil/strings/strcat.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/walltime.h"
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/messenger.h"
+#include "yb/rpc/tcp_stream.h"
 #include "yb/server/default-path-handlers.h"
 #include "yb/server/generic_service.h"
 #include "yb/server/glog_metrics.h"
@@ -81,6 +83,14 @@ TAG_FLAG(num_reactor_threads, advanced);
 
 DECLARE_bool(use_hybrid_clock);
 
+DEFINE_bool(enable_stream_compression, false,
+            "Whether RPC connections of this server should negotiate compression of call payloads. "
+            "Incoming uncompressed connections are still accepted. Servers without this flag "
+            "reject the compression handshake, after that connections to them are not compressed "
+            "for stream_compression_fallback_secs, so the flag could be enabled with a rolling "
+            "restart. Could not be used together with node to node encryption.");
+TAG_FLAG(enable_stream_compression, advanced);
+
 DEFINE_int32(generic_svc_num_threads, 10,
              "Number of RPC worker threads to run for the generic service");
 TAG_FLAG(generic_svc_num_threads, advanced);
@@ -234,6 +244,15 @@ Status RpcServerBase::SetupMessengerBuilder(rpc::MessengerBuilder* builder) {
   builder->set_metric_entity(metric_entity());
   builder->set_connection_keepalive_time(options_.rpc_opts.connection_keepalive_time_ms * 1ms);
 
+  if (FLAGS_enable_stream_compression) {
+    builder->SetListenProtocol(rpc::CompressedStreamProtocol());
+    builder->AddStreamFactory(
+        rpc::CompressedStreamProtocol(),
+        rpc::CompressedStreamFactory(
+            rpc::TcpStream::Factory(),
+            MemTracker::FindOrCreateTracker("Compressed Read Buffer", mem_tracker())));
+  }
+
   return Status::OK();
 }
 
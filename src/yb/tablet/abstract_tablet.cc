@@ -108,7 +108,11 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
   // Serializing data for PgGate API.
   CHECK(!pgsql_read_request.has_rsrow_desc()) << "Row description is not needed";
   TRACE("Start Serialize");
-  RETURN_NOT_OK(pggate::PgDocData::WriteTuples(resultset, &result->rows_data));
+  if (pgsql_read_request.columnar_result()) {
+    RETURN_NOT_OK(pggate::PgDocData::WriteColumnarTuples(resultset, &result->rows_data));
+  } else {
+    RETURN_NOT_OK(pggate::PgDocData::WriteTuples(resultset, &result->rows_data));
+  }
   TRACE("Done Serialize");
 
   return Status::OK();
@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/operations/split_operation.h"
+
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/server/hybrid_clock.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_splitter.h"
+#include "yb/tserver/tserver_admin.pb.h"
+#include "yb/util/trace.h"
+
+namespace yb {
+namespace tablet {
+
+using consensus::ReplicateMsg;
+using consensus::SPLIT_OP;
+
+void SplitOperationState::UpdateRequestFromConsensusRound() {
+  request_ = consensus_round()->replicate_msg()->mutable_split_request();
+}
+
+std::string SplitOperationState::ToString() const {
+  return Format("SplitOperationState [hybrid_time=$0, request=$1]",
+                hybrid_time_even_if_unset(),
+                request_ ? request_->ShortDebugString() : "<none>");
+}
+
+SplitOperation::SplitOperation(std::unique_ptr<SplitOperationState> state)
+    : Operation(std::move(state), OperationType::kSplit) {
+}
+
+consensus::ReplicateMsgPtr SplitOperation::NewReplicateMsg() {
+  auto result = std::make_shared<ReplicateMsg>();
+  result->set_op_type(SPLIT_OP);
+  result->mutable_split_request()->CopyFrom(*state()->request());
+  return result;
+}
+
+void SplitOperation::DoStart() {
+  state()->TrySetHybridTimeFromClock();
+  state()->tablet()->SetSplitStarted(true);
+
+  TRACE("START SPLIT: hybrid time: $0",
+        server::HybridClock::GetPhysicalValueMicros(state()->hybrid_time()));
+}
+
+Status SplitOperation::DoAborted(const Status& status) {
+  state()->tablet()->SetSplitStarted(false);
+  return status;
+}
+
+Status SplitOperation::DoReplicated(int64_t leader_term, Status* complete_status) {
+  TRACE("APPLY SPLIT: started");
+
+  RETURN_NOT_OK(state()->tablet_splitter()->ApplyTabletSplit(state()));
+
+  TRACE("APPLY SPLIT: finished");
+
+  return Status::OK();
+}
+
+std::string SplitOperation::ToString() const {
+  return Format("SplitOperation [state=$0]", state()->ToString());
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -0,0 +1,88 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_OPERATIONS_SPLIT_OPERATION_H
+#define YB_TABLET_OPERATIONS_SPLIT_OPERATION_H
+
+#include <string>
+
+#include "yb/gutil/macros.h"
+#include "yb/tablet/operations/operation.h"
+
+namespace yb {
+namespace tablet {
+
+class TabletSplitter;
+
+// Operation Context for the Split operation.
+// Keeps track of the Operation states (request, result, ...)
+class SplitOperationState : public OperationState {
+ public:
+  SplitOperationState(Tablet* tablet, TabletSplitter* tablet_splitter,
+                      const tserver::SplitTabletRequestPB* request = nullptr)
+      : OperationState(tablet), tablet_splitter_(tablet_splitter), request_(request) {}
+  ~SplitOperationState() {}
+
+  const tserver::SplitTabletRequestPB* request() const override { return request_; }
+
+  TabletSplitter* tablet_splitter() const { return tablet_splitter_; }
+
+  void UpdateRequestFromConsensusRound() override;
+
+  virtual std::string ToString() const override;
+
+ private:
+  TabletSplitter* const tablet_splitter_;
+
+  // The original RPC request.
+  const tserver::SplitTabletRequestPB* request_;
+
+  DISALLOW_COPY_AND_ASSIGN(SplitOperationState);
+};
+
+// Executes the split tablet operation.
+//
+// Once the operation is started the tablet rejects new writes, so no write could be replicated
+// after the split operation. When the operation is applied, the tablet data is split between two
+// new tablets sharing the tablet's SST files and the tablet itself stops serving reads and writes.
+class SplitOperation : public Operation {
+ public:
+  explicit SplitOperation(std::unique_ptr<SplitOperationState> operation_state);
+
+  SplitOperationState* state() override {
+    return down_cast<SplitOperationState*>(Operation::state());
+  }
+
+  const SplitOperationState* state() const override {
+    return down_cast<const SplitOperationState*>(Operation::state());
+  }
+
+  consensus::ReplicateMsgPtr NewReplicateMsg() override;
+
+  CHECKED_STATUS Prepare() override { return Status::OK(); }
+
+  std::string ToString() const override;
+
+ private:
+  // Starts the SplitOperation by assigning it a timestamp.
+  void DoStart() override;
+  CHECKED_STATUS DoReplicated(int64_t leader_term, Status* complete_status) override;
+  CHECKED_STATUS DoAborted(const Status& status) override;
+
+  DISALLOW_COPY_AND_ASSIGN(SplitOperation);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_OPERATIONS_SPLIT_OPERATION_H
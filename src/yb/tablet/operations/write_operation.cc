@@ -96,6 +96,12 @@ consensus::ReplicateMsgPtr WriteOperation::NewReplicateMsg() {
 
 Status WriteOperation::Prepare() {
   TRACE_EVENT0("txn", "WriteOperation::Prepare");
+  // Operations are prepared in the order of the Raft log, so writes prepared after the split
+  // operation was started would be replicated after it and lost, since new tablets are created
+  // from the state of this tablet at the split.
+  if (PREDICT_FALSE(state()->tablet()->IsSplitStarted())) {
+    return STATUS(ServiceUnavailable, "Tablet is being split");
+  }
   return Status::OK();
 }
 
@@ -183,6 +183,43 @@ TEST_F(TabletSplitTest,  v) {
   ASSERT_TRUE(source_docdb_dump.empty()) << boost::algorithm::join(source_docdb_dump, "\n");
 }
 
+TEST_F(TabletSplitTest, SplitKey) {
+  constexpr auto kNumRows = 10000;
+  constexpr auto kRowsPerFlush = kNumRows / 5;
+
+  std::vector<docdb::DocKeyHash> hash_codes;
+  {
+    LocalTabletWriter::Batch batch;
+    for (auto i = 1; i <= kNumRows; ++i) {
+      hash_codes.push_back(InsertRow(i, RandomHumanReadableString(100), &batch));
+      if (i % kRowsPerFlush == 0) {
+        ASSERT_OK(writer_->WriteBatch(&batch));
+        batch.Clear();
+        ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+      }
+    }
+  }
+
+  std::string partition_key;
+  std::string encoded_key;
+  ASSERT_OK(tablet()->GetSplitKey(&partition_key, &encoded_key));
+
+  const auto split_hash_code = PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+  docdb::KeyBytes expected_encoded_key;
+  docdb::DocKeyEncoderAfterCotableIdStep(&expected_encoded_key).Hash(
+      split_hash_code, std::vector<docdb::PrimitiveValue>());
+  ASSERT_EQ(expected_encoded_key.data(), encoded_key);
+
+  // Split key is based on approximate sizes, so just check that both parts have significant
+  // amount of rows.
+  const auto rows_before_split = std::count_if(
+      hash_codes.begin(), hash_codes.end(),
+      [split_hash_code](docdb::DocKeyHash hash_code) { return hash_code < split_hash_code; });
+  LOG(INFO) << "Split hash code: " << split_hash_code << ", rows before: " << rows_before_split;
+  ASSERT_GT(rows_before_split, kNumRows / 4);
+  ASSERT_LT(rows_before_split, kNumRows * 3 / 4);
+}
+
 // TODO: Need to test with distributed transactions both pending and committed
 // (but not yet applied) during split.
 // Split tablets should not return unexpected data for not yet applied, but committed transactions
@@ -104,6 +104,7 @@
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/snapshot_operation.h"
@@ -160,6 +161,12 @@ DEFINE_int32(num_raft_ops_to_force_idle_intents_db_to_flush, 1000,
              "the last write to the intents RocksDB "
              "is greater than this value, the intents RocksDB would be requested to flush.");
 
+DEFINE_int32(txn_max_apply_batch_records, 100000,
+             "Max number of intent records of a transaction, that are applied to the regular "
+             "RocksDB or removed from the intents RocksDB in a single write batch. Bigger "
+             "transactions are processed in several batches. 0 means no limit.");
+TAG_FLAG(txn_max_apply_batch_records, advanced);
+
 DEFINE_test_flag(
     bool, tablet_verify_flushed_frontier_after_modifying, false,
     "After modifying the flushed frontier in RocksDB, verify that the restored value of it "
@@ -385,7 +392,7 @@ Tablet::Tablet(
 
   if (transaction_participant_context && metadata->schema().table_properties().is_transactional()) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
-        transaction_participant_context, this, metric_entity_);
+        transaction_participant_context, this, metric_entity_, mem_tracker_);
     // Create transaction manager for secondary index update.
     if (!metadata_->index_map().empty()) {
       transaction_manager_.emplace(client_future_.get(),
@@ -746,7 +753,14 @@ void Tablet::StartOperation(WriteOperationState* operation_state) {
   }
 }
 
-Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
+HybridTime WriteRequestHybridTime(
+    const tserver::WriteRequestPB& request, HybridTime operation_hybrid_time) {
+  return request.has_external_hybrid_time() ? HybridTime(request.external_hybrid_time())
+                                            : operation_hybrid_time;
+}
+
+Status Tablet::ApplyRowOperations(
+    WriteOperationState* operation_state, rocksdb::WriteBatch* prepared_write_batch) {
   const KeyValueWriteBatchPB& put_batch =
       operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
           // Online case.
@@ -760,12 +774,11 @@ Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
   docdb::ConsensusFrontiers frontiers;
   set_op_id({operation_state->op_id().term(), operation_state->op_id().index()}, &frontiers);
 
-  auto hybrid_time = operation_state->request()->has_external_hybrid_time() ?
-      HybridTime(operation_state->request()->external_hybrid_time()) :
-      operation_state->hybrid_time();
+  auto hybrid_time = WriteRequestHybridTime(
+      *operation_state->request(), operation_state->hybrid_time());
 
   set_hybrid_time(hybrid_time, &frontiers);
-  return ApplyKeyValueRowOperations(put_batch, &frontiers, hybrid_time);
+  return ApplyKeyValueRowOperations(put_batch, &frontiers, hybrid_time, prepared_write_batch);
 }
 
 Status Tablet::CreateCheckpoint(const std::string& dir) {
@@ -846,7 +859,8 @@ Status Tablet::PrepareTransactionWriteBatch(
 
 Status Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
                                           const rocksdb::UserFrontiers* frontiers,
-                                          const HybridTime hybrid_time) {
+                                          const HybridTime hybrid_time,
+                                          rocksdb::WriteBatch* prepared_write_batch) {
   if (put_batch.write_pairs().empty() && put_batch.read_pairs().empty()) {
     return Status::OK();
   }
@@ -860,6 +874,8 @@ Status Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
     RequestScope request_scope(transaction_participant_.get());
     RETURN_NOT_OK(PrepareTransactionWriteBatch(put_batch, hybrid_time, &write_batch));
     WriteToRocksDB(frontiers, &write_batch, StorageDbType::kIntents);
+  } else if (prepared_write_batch) {
+    WriteToRocksDB(frontiers, prepared_write_batch, StorageDbType::kRegular);
   } else {
     PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
     WriteToRocksDB(frontiers, &write_batch, StorageDbType::kRegular);
@@ -1449,19 +1465,31 @@ void InitFrontiers(const Data& data, docdb::ConsensusFrontiers* frontiers) {
 // We apply intents by iterating over whole transaction reverse index.
 // Using value of reverse index record we find original intent record and apply it.
 // After that we delete both intent record and reverse index record.
-// TODO(dtxn) use multiple batches when applying really big transaction.
+// Big transactions are applied in several batches of txn_max_apply_batch_records records.
+// Only the last batch has frontiers, so if the tablet is restarted in the middle of apply,
+// regular DB flushed frontier is before this operation and the whole apply is replayed.
+// Replay writes the same records with the same hybrid times, so it is idempotent.
 Status Tablet::ApplyIntents(const TransactionApplyData& data) {
-  rocksdb::WriteBatch regular_write_batch;
-  RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-      data.transaction_id, data.commit_ht, &key_bounds_,
-      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
-
-  // data.hybrid_time contains transaction commit time.
-  // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
-  docdb::ConsensusFrontiers frontiers;
-  InitFrontiers(data, &frontiers);
-  WriteToRocksDB(&frontiers, &regular_write_batch, StorageDbType::kRegular);
-  return Status::OK();
+  docdb::ApplyTransactionState apply_state;
+  for (;;) {
+    rocksdb::WriteBatch regular_write_batch;
+    apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
+        data.transaction_id, data.commit_ht, &key_bounds_, &apply_state,
+        FLAGS_txn_max_apply_batch_records, &regular_write_batch, intents_db_.get(),
+        nullptr /* intents_write_batch */));
+    if (!apply_state.active()) {
+      // data.hybrid_time contains transaction commit time.
+      // We don't set transaction field of put_batch, otherwise we would write another bunch of
+      // intents.
+      docdb::ConsensusFrontiers frontiers;
+      InitFrontiers(data, &frontiers);
+      WriteToRocksDB(&frontiers, &regular_write_batch, StorageDbType::kRegular);
+      return Status::OK();
+    }
+    VLOG_WITH_PREFIX(2) << "Applied batch of " << data.transaction_id << ", continue from: "
+                        << apply_state.ToString();
+    WriteToRocksDB(nullptr /* frontiers */, &regular_write_batch, StorageDbType::kRegular);
+  }
 }
 
 template <class Ids>
@@ -1469,15 +1497,30 @@ CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Id
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
   RETURN_NOT_OK(scoped_read_operation);
 
+  docdb::ConsensusFrontiers frontiers;
+  InitFrontiers(data, &frontiers);
+  const size_t max_records = FLAGS_txn_max_apply_batch_records;
+
+  // Intents of several transactions are removed in the same batch, while it is not too big.
   rocksdb::WriteBatch intents_write_batch;
   for (const auto& id : ids) {
-    RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-        id, HybridTime() /* commit_ht */, &key_bounds_, nullptr /* regular_write_batch */,
-        intents_db_.get(), &intents_write_batch));
+    docdb::ApplyTransactionState apply_state;
+    for (;;) {
+      apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
+          id, HybridTime() /* commit_ht */, &key_bounds_, &apply_state, max_records,
+          nullptr /* regular_write_batch */, intents_db_.get(), &intents_write_batch));
+      if (!apply_state.active()) {
+        break;
+      }
+      WriteToRocksDB(&frontiers, &intents_write_batch, StorageDbType::kIntents);
+      intents_write_batch.Clear();
+    }
+    if (max_records && intents_write_batch.Count() >= max_records) {
+      WriteToRocksDB(&frontiers, &intents_write_batch, StorageDbType::kIntents);
+      intents_write_batch.Clear();
+    }
   }
 
-  docdb::ConsensusFrontiers frontiers;
-  InitFrontiers(data, &frontiers);
   WriteToRocksDB(&frontiers, &intents_write_batch, StorageDbType::kIntents);
   return Status::OK();
 }
@@ -2401,12 +2444,160 @@ Result<IsolationLevel> Tablet::GetIsolationLevel(const TransactionMetadataPB& tr
 }
 
 
+namespace {
+
+// Sub tablet has its own Raft log, so op id of the source tablet stored in the flushed frontier
+// should not be used during its bootstrap.
+Status ResetFlushedOpId(const std::string& db_dir, const rocksdb::Options& options) {
+  std::unique_ptr<rocksdb::DB> db = VERIFY_RESULT(rocksdb::DB::Open(options, db_dir));
+  auto flushed_frontier = db->GetFlushedFrontier();
+  if (!flushed_frontier) {
+    return Status::OK();
+  }
+  auto frontier = down_cast<docdb::ConsensusFrontier&>(*flushed_frontier);
+  frontier.set_op_id(OpId());
+  return db->ModifyFlushedFrontier(frontier.Clone(), rocksdb::FrontierModificationMode::kForce);
+}
+
+docdb::KeyBytes EncodeHashCode(uint32_t hash_code) {
+  docdb::KeyBytes result;
+  docdb::DocKeyEncoderAfterCotableIdStep(&result).Hash(
+      static_cast<docdb::DocKeyHash>(hash_code), std::vector<docdb::PrimitiveValue>());
+  return result;
+}
+
+} // namespace
+
 Status Tablet::CreateSubtablet(
     const TabletId& tablet_id, const Partition& partition,
     const docdb::KeyBounds& key_bounds) {
   auto metadata = VERIFY_RESULT(metadata_->CreateSubtabletMetadata(
       tablet_id, partition, key_bounds.lower.data(), key_bounds.upper.data()));
-  return CreateCheckpoint(metadata->rocksdb_dir());
+
+  // Clean up leftovers of the previous attempt, that could be interrupted by a crash.
+  auto* env = metadata->fs_manager()->env();
+  const auto db_dir = metadata->rocksdb_dir();
+  for (const auto& dir : {db_dir, db_dir + kIntentsDBSuffix}) {
+    if (env->FileExists(dir)) {
+      RETURN_NOT_OK(env->DeleteRecursively(dir));
+    }
+  }
+
+  RETURN_NOT_OK(CreateCheckpoint(db_dir));
+
+  rocksdb::Options rocksdb_options;
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, LogPrefix(), /* statistics */ nullptr, tablet_options_);
+  rocksdb_options.create_if_missing = false;
+  RETURN_NOT_OK(ResetFlushedOpId(db_dir, rocksdb_options));
+
+  metadata->set_tablet_data_state(TABLET_DATA_READY);
+  return metadata->Flush();
+}
+
+Status Tablet::Split(SplitOperationState* state) {
+  const auto& request = *state->request();
+  if (metadata_->IsSplitDone()) {
+    LOG_WITH_PREFIX(INFO) << "Tablet was already split: " << request.ShortDebugString();
+    return Status::OK();
+  }
+
+  PartitionPB partition_pb;
+  metadata_->partition().ToPB(&partition_pb);
+  const std::string lower_bound_key = metadata_->lower_bound_key();
+  const std::string upper_bound_key = metadata_->upper_bound_key();
+
+  Partition partition;
+  PartitionPB child_partition_pb = partition_pb;
+  child_partition_pb.set_partition_key_end(request.split_partition_key());
+  Partition::FromPB(child_partition_pb, &partition);
+  const TabletId* child_ids[] = { &request.new_tablet1_id(), &request.new_tablet2_id() };
+  const docdb::KeyBounds child_bounds[] = {
+      docdb::KeyBounds(lower_bound_key, request.split_encoded_key()),
+      docdb::KeyBounds(request.split_encoded_key(), upper_bound_key) };
+
+  for (int i = 0; i != 2; ++i) {
+    if (i == 1) {
+      child_partition_pb = partition_pb;
+      child_partition_pb.set_partition_key_start(request.split_partition_key());
+      Partition::FromPB(child_partition_pb, &partition);
+    }
+
+    // The split could be replayed after the new tablet was already created.
+    RaftGroupMetadataPtr existing_metadata;
+    if (RaftGroupMetadata::Load(metadata_->fs_manager(), *child_ids[i], &existing_metadata).ok() &&
+        existing_metadata->tablet_data_state() == TABLET_DATA_READY) {
+      LOG_WITH_PREFIX(INFO) << "Tablet " << *child_ids[i] << " already exists";
+      continue;
+    }
+
+    RETURN_NOT_OK_PREPEND(
+        CreateSubtablet(*child_ids[i], partition, child_bounds[i]),
+        Format("Failed to create tablet $0", *child_ids[i]));
+  }
+
+  metadata_->SetSplitDone(request.new_tablet1_id(), request.new_tablet2_id());
+  RETURN_NOT_OK(metadata_->Flush());
+
+  LOG_WITH_PREFIX(INFO) << "Tablet was split into " << request.new_tablet1_id() << " and "
+                        << request.new_tablet2_id();
+  return Status::OK();
+}
+
+Status Tablet::GetSplitKey(std::string* partition_key, std::string* encoded_key) {
+  ScopedPendingOperation pending_op(&pending_op_counter_);
+  RETURN_NOT_OK(pending_op);
+
+  if (!regular_db_) {
+    return STATUS(NotSupported, "Tablet does not have a RocksDB");
+  }
+  if (!metadata_->partition_schema().IsHashPartitioning()) {
+    return STATUS(NotSupported, "Only tablets of hash partitioned tables could be split");
+  }
+
+  // Hash codes covered by this tablet are [lower_hash, upper_hash).
+  const auto& partition = metadata_->partition();
+  const uint32_t lower_hash = partition.partition_key_start().empty()
+      ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+  const uint32_t upper_hash = partition.partition_key_end().empty()
+      ? PartitionSchema::kMaxPartitionKey + 1
+      : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end());
+  if (upper_hash - lower_hash < 2) {
+    return STATUS_FORMAT(IllegalState, "Tablet covers too few hash codes: [$0, $1)",
+                         lower_hash, upper_hash);
+  }
+
+  // Use approximate sizes calculated from SST files index, so we don't have to read the data.
+  const auto lower_key = EncodeHashCode(lower_hash);
+  auto size_before = [this, &lower_key](const Slice& key) {
+    rocksdb::Range range(lower_key.AsSlice(), key);
+    uint64_t size = 0;
+    regular_db_->GetApproximateSizes(&range, 1, &size);
+    return size;
+  };
+
+  const std::string max_key(1, docdb::ValueTypeAsChar::kMaxByte);
+  const auto total_size = size_before(max_key);
+  if (total_size == 0) {
+    return STATUS(IllegalState, "Tablet does not have data in SST files");
+  }
+
+  // Find the first hash code, so data before it is at least half of the total data size.
+  uint32_t low = lower_hash + 1;
+  uint32_t high = upper_hash - 1;
+  while (low < high) {
+    const uint32_t middle = low + (high - low) / 2;
+    if (size_before(EncodeHashCode(middle).AsSlice()) * 2 >= total_size) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+
+  *partition_key = PartitionSchema::EncodeMultiColumnHashValue(low);
+  *encoded_key = EncodeHashCode(low).data();
+  VLOG_WITH_PREFIX(1) << "Split hash code: " << low << ", total size: " << total_size;
+  return Status::OK();
 }
 
 Result<int64_t> Tablet::CountIntents() {
@@ -106,6 +106,10 @@ namespace server {
 class Clock;
 }
 
+namespace tserver {
+class WriteRequestPB;
+}
+
 class MaintenanceManager;
 class MaintenanceOp;
 class MaintenanceOpStats;
@@ -114,6 +118,7 @@ namespace tablet {
 
 class ChangeMetadataOperationState;
 class ScopedReadOperation;
+class SplitOperationState;
 struct TabletMetrics;
 struct TransactionApplyData;
 class TransactionCoordinator;
@@ -160,6 +165,11 @@ struct DocDbOpIds {
 
 typedef std::function<Status(const TableInfo&)> AddTableListener;
 
+// Hybrid time of the records written by the replicated write request, whose operation was assigned
+// operation_hybrid_time.
+HybridTime WriteRequestHybridTime(
+    const tserver::WriteRequestPB& request, HybridTime operation_hybrid_time);
+
 class Tablet : public AbstractTablet, public TransactionIntentApplier {
  public:
   class CompactionFaultHooks;
@@ -252,14 +262,19 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void StartOperation(WriteOperationState* operation_state);
 
   // Apply all of the row operations associated with this transaction.
-  CHECKED_STATUS ApplyRowOperations(WriteOperationState* operation_state);
+  // See ApplyKeyValueRowOperations for prepared_write_batch.
+  CHECKED_STATUS ApplyRowOperations(
+      WriteOperationState* operation_state,
+      rocksdb::WriteBatch* prepared_write_batch = nullptr);
 
   // Apply a set of RocksDB row operations.
-  // If rocksdb_write_batch is specified it could contain preencoded RocksDB operations.
+  // If prepared_write_batch is specified it contains non transactional operations of put_batch,
+  // already encoded by PrepareNonTransactionWriteBatch.
   CHECKED_STATUS ApplyKeyValueRowOperations(
       const docdb::KeyValueWriteBatchPB& put_batch,
       const rocksdb::UserFrontiers* frontiers,
-      HybridTime hybrid_time);
+      HybridTime hybrid_time,
+      rocksdb::WriteBatch* prepared_write_batch = nullptr);
 
   void WriteToRocksDB(
       const rocksdb::UserFrontiers* frontiers,
@@ -356,6 +371,21 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Truncate this tablet by resetting the content of RocksDB.
   CHECKED_STATUS Truncate(TruncateOperationState* state);
 
+  // Split this tablet into two new on-disk tablets sharing its SST files through hard links.
+  // Does nothing if the tablet was already split, so could be safely replayed during bootstrap.
+  CHECKED_STATUS Split(SplitOperationState* state);
+
+  // Finds a key that splits the tablet into two parts with approximately the same SST files size.
+  // Only tablets of hash partitioned tables are supported.
+  CHECKED_STATUS GetSplitKey(std::string* partition_key, std::string* encoded_key);
+
+  // Whether the split operation was started, so the tablet should not accept new writes.
+  bool IsSplitStarted() const { return split_started_.load(std::memory_order_acquire); }
+  void SetSplitStarted(bool value) { split_started_.store(value, std::memory_order_release); }
+
+  // Whether the tablet was split, so it does not serve reads and writes anymore.
+  bool IsSplitDone() const { return metadata_->IsSplitDone(); }
+
   // Verbosely dump this entire tablet to the logs. This is only
   // really useful when debugging unit tests failures where the tablet
   // has a very small number of rows.
@@ -712,6 +742,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::atomic<int64_t> last_committed_write_index_{0};
 
+  std::atomic<bool> split_started_{false};
+
   HybridTimeLeaseProvider ht_lease_provider_;
 
   // (end of protected section)
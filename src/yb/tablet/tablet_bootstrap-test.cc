@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <set>
 #include <vector>
 
 #include "yb/consensus/consensus_meta.h"
@@ -38,14 +39,21 @@
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/consensus-test-util.h"
+#include "yb/consensus/retryable_requests.h"
 #include "yb/server/logical_clock.h"
 #include "yb/server/metadata.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/util/coding.h"
+#include "yb/util/env.h"
+#include "yb/util/metrics.h"
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
 
+DECLARE_int32(tablet_bootstrap_replay_threads);
+
 using std::shared_ptr;
 using std::string;
 using std::vector;
@@ -115,6 +123,8 @@ class BootstrapTest : public LogTestBase {
   Status RunBootstrapOnTestTablet(const RaftGroupMetadataPtr& meta,
                                   shared_ptr<TabletClass>* tablet,
                                   ConsensusBootstrapInfo* boot_info) {
+    // Each bootstrap gets its own registry, so bootstrap metrics are not accumulated.
+    metric_registries_.push_back(std::make_unique<MetricRegistry>());
     gscoped_ptr<TabletStatusListener> listener(new TabletStatusListener(meta));
     scoped_refptr<LogAnchorRegistry> log_anchor_registry(new LogAnchorRegistry());
     // Now attempt to recover the log
@@ -125,7 +135,7 @@ class BootstrapTest : public LogTestBase {
         scoped_refptr<Clock>(LogicalClock::CreateStartingAt(HybridTime::kInitial)),
         shared_ptr<MemTracker>() /* mem_tracker */,
         shared_ptr<MemTracker>() /* block_based_table_mem_tracker */,
-        nullptr /* metric_registry */,
+        metric_registries_.back().get(),
         listener.get(),
         log_anchor_registry,
         tablet_options,
@@ -133,7 +143,8 @@ class BootstrapTest : public LogTestBase {
         nullptr, // transaction_participant_context
         client::LocalTabletFilter(),
         nullptr, // transaction_coordinator_context
-        append_pool_.get()};
+        append_pool_.get(),
+        retryable_requests_};
     RETURN_NOT_OK(BootstrapTablet(data, tablet, &log_, boot_info));
     return Status::OK();
   }
@@ -161,6 +172,104 @@ class BootstrapTest : public LogTestBase {
     return Status::OK();
   }
 
+  // Appends several log segments of writes, bootstraps the tablet and checks that all of them
+  // were replayed.
+  void TestBootstrapMultipleSegments() {
+    constexpr int kNumSegments = 3;
+    constexpr int kEntriesPerSegment = 5;
+    BuildLog();
+    std::set<int> keys;
+    for (int i = 0; i != kNumSegments; ++i) {
+      for (int j = 0; j != kEntriesPerSegment; ++j) {
+        const int index = static_cast<int>(current_index_);
+        keys.insert(index);
+        keys.insert(index <= 2 ? 3 : index / 2 + 1);
+      }
+      AppendReplicateBatchToLog(kEntriesPerSegment);
+      ASSERT_OK(RollLog());
+    }
+
+    shared_ptr<TabletClass> tablet;
+    ConsensusBootstrapInfo boot_info;
+    ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+    ASSERT_EQ(current_index_ - 1, boot_info.last_id.index());
+
+    vector<string> results;
+    IterateTabletRows(tablet.get(), &results);
+    ASSERT_EQ(keys.size(), results.size());
+  }
+
+  // Bootstraps the tablet, then flushes it and closes the log as the tablet peer does at clean
+  // shutdown. Fills the state the tablet peer records and, if requested, the path of the last
+  // log segment.
+  void BootstrapAndShutdownCleanly(CleanShutdownStatePB* state, vector<string>* results,
+                                   string* last_segment_path = nullptr) {
+    shared_ptr<TabletClass> tablet;
+    ConsensusBootstrapInfo boot_info;
+    ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+    IterateTabletRows(tablet.get(), results);
+
+    ASSERT_OK(tablet->Flush(FlushMode::kSync));
+    if (last_segment_path) {
+      log::SegmentSequence segments;
+      ASSERT_OK(log_->GetSegmentsSnapshot(&segments));
+      *last_segment_path = segments.back()->path();
+    }
+    ASSERT_OK(log_->Close());
+
+    state->Clear();
+    *state->mutable_last_op_id() = boot_info.last_id;
+    state->set_last_replicated_hybrid_time(
+        tablet->mvcc_manager()->LastReplicatedHybridTime().ToUint64());
+    state->set_restart_safe_time(restart_safe_coarse_mono_clock_.Now().ToUInt64());
+    tablet->Shutdown();
+  }
+
+  CHECKED_STATUS RecordCleanShutdownState(const CleanShutdownStatePB& state) {
+    RaftGroupMetadataPtr meta;
+    RETURN_NOT_OK(LoadTestRaftGroupMetadata(&meta));
+    meta->SetCleanShutdownState(state);
+    return meta->Flush();
+  }
+
+  // Truncates the footer of a closed log segment, as if the server crashed before closing it.
+  void RemoveSegmentFooter(const string& path) {
+    // The footer is followed by the footer magic (8 bytes) and the footer length (4 bytes).
+    constexpr size_t kFooterMagicAndLengthSize = 12;
+    faststring data;
+    ASSERT_OK(ReadFileToString(env_.get(), path, &data));
+    ASSERT_GT(data.size(), kFooterMagicAndLengthSize);
+    const auto footer_size = DecodeFixed32(data.data() + data.size() - 4);
+    data.resize(data.size() - kFooterMagicAndLengthSize - footer_size);
+    ASSERT_OK(WriteStringToFile(env_.get(), Slice(data), path));
+  }
+
+  // Appends committed writes with consecutive request ids of the same client.
+  void AppendRetryableWrites(int count) {
+    for (int i = 0; i != count; ++i) {
+      auto replicate = std::make_shared<ReplicateMsg>();
+      replicate->set_op_type(consensus::WRITE_OP);
+      const auto op_id = MakeOpId(1, current_index_);
+      *replicate->mutable_id() = op_id;
+      *replicate->mutable_committed_op_id() = op_id;
+      replicate->set_hybrid_time(clock_->Now().ToUint64());
+      auto* write_request = replicate->mutable_write_request();
+      write_request->set_tablet_id(log::kTestTablet);
+      write_request->set_client_id1(1);
+      write_request->set_client_id2(2);
+      write_request->set_request_id(current_index_);
+      write_request->set_min_running_request_id(1);
+      AddKVToPB(static_cast<int32_t>(current_index_), 0, "retryable",
+                write_request->mutable_write_batch());
+      AppendReplicateBatch(replicate);
+      ++current_index_;
+    }
+  }
+
+  int64_t SegmentsReplayed(TabletClass* tablet) {
+    return tablet->metrics()->bootstrap_segments_replayed->value();
+  }
+
   void IterateTabletRows(const Tablet* tablet,
                          vector<string>* results) {
     auto iter = tablet->NewRowIterator(schema_, boost::none);
@@ -170,6 +279,9 @@ class BootstrapTest : public LogTestBase {
       VLOG(1) << result;
     }
   }
+
+  std::vector<std::unique_ptr<MetricRegistry>> metric_registries_;
+  consensus::RetryableRequests* retryable_requests_ = nullptr;
 };
 
 // Tests a normal bootstrap scenario.
@@ -185,6 +297,15 @@ TEST_F(BootstrapTest, TestBootstrap) {
   IterateTabletRows(tablet.get(), &results);
 }
 
+TEST_F(BootstrapTest, TestBootstrapMultipleSegments) {
+  TestBootstrapMultipleSegments();
+}
+
+TEST_F(BootstrapTest, TestBootstrapMultipleSegmentsWithoutReadAhead) {
+  FLAGS_tablet_bootstrap_replay_threads = 0;
+  TestBootstrapMultipleSegments();
+}
+
 // Tests attempting a local bootstrap of a tablet that was in the middle of a remote bootstrap
 // before "crashing".
 TEST_F(BootstrapTest, TestIncompleteRemoteBootstrap) {
@@ -338,6 +459,137 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+// Tests that the log is not replayed after a clean shutdown.
+TEST_F(BootstrapTest, TestSkipReplayAfterCleanShutdown) {
+  BuildLog();
+  AppendReplicateBatchToLog(5);
+  ASSERT_OK(log_->Close());
+  const int64_t last_index = current_index_ - 1;
+
+  CleanShutdownStatePB state;
+  vector<string> results;
+  BootstrapAndShutdownCleanly(&state, &results);
+  ASSERT_OK(RecordCleanShutdownState(state));
+
+  shared_ptr<TabletClass> tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(0, SegmentsReplayed(tablet.get()));
+  ASSERT_EQ(last_index, boot_info.last_id.index());
+  ASSERT_EQ(last_index, boot_info.last_committed_id.index());
+  ASSERT_TRUE(boot_info.orphaned_replicates.empty());
+  ASSERT_EQ(last_index, log_->GetLatestEntryOpId().index);
+  ASSERT_FALSE(tablet->metadata()->TakeCleanShutdownState());
+
+  vector<string> restored_results;
+  IterateTabletRows(tablet.get(), &restored_results);
+  ASSERT_EQ(results, restored_results);
+}
+
+// Tests that retryable requests are rebuilt when log replay is skipped, so retried writes are not
+// applied twice.
+TEST_F(BootstrapTest, TestRetryableRequestsAfterCleanShutdown) {
+  constexpr int kNumWrites = 5;
+  BuildLog();
+  AppendRetryableWrites(kNumWrites);
+  ASSERT_OK(log_->Close());
+
+  CleanShutdownStatePB state;
+  vector<string> results;
+  BootstrapAndShutdownCleanly(&state, &results);
+  ASSERT_OK(RecordCleanShutdownState(state));
+
+  consensus::RetryableRequests retryable_requests;
+  retryable_requests_ = &retryable_requests;
+  shared_ptr<TabletClass> tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(0, SegmentsReplayed(tablet.get()));
+  ASSERT_EQ(current_index_ - 1, boot_info.last_id.index());
+
+  // Request ids are consecutive, so all writes are registered in a single range.
+  auto counts = retryable_requests.TEST_Counts();
+  ASSERT_EQ(0, counts.running);
+  ASSERT_EQ(1, counts.replicated);
+  ASSERT_GE(retryable_requests.Clock().Now().ToUInt64(), state.restart_safe_time());
+}
+
+// Tests that the log is replayed when a log segment was not closed after the clean shutdown state
+// was recorded.
+TEST_F(BootstrapTest, TestReplayAfterCleanShutdownWithUnclosedSegment) {
+  BuildLog();
+  AppendReplicateBatchToLog(5);
+  ASSERT_OK(log_->Close());
+
+  CleanShutdownStatePB state;
+  vector<string> results;
+  string last_segment_path;
+  BootstrapAndShutdownCleanly(&state, &results, &last_segment_path);
+  ASSERT_OK(RecordCleanShutdownState(state));
+  RemoveSegmentFooter(last_segment_path);
+
+  shared_ptr<TabletClass> tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_GT(SegmentsReplayed(tablet.get()), 0);
+  ASSERT_EQ(current_index_ - 1, boot_info.last_id.index());
+
+  vector<string> restored_results;
+  IterateTabletRows(tablet.get(), &restored_results);
+  ASSERT_EQ(results, restored_results);
+}
+
+// Tests that the log is replayed when entries were appended after the clean shutdown state was
+// recorded.
+TEST_F(BootstrapTest, TestReplayAfterCleanShutdownWithNewEntries) {
+  BuildLog();
+  AppendReplicateBatchToLog(5);
+  ASSERT_OK(log_->Close());
+
+  CleanShutdownStatePB state;
+  vector<string> results;
+  BootstrapAndShutdownCleanly(&state, &results);
+  ASSERT_OK(RecordCleanShutdownState(state));
+
+  BuildLog();
+  AppendReplicateBatchToLog(2);
+  ASSERT_OK(log_->Close());
+
+  shared_ptr<TabletClass> tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_GT(SegmentsReplayed(tablet.get()), 0);
+  ASSERT_EQ(current_index_ - 1, boot_info.last_id.index());
+
+  vector<string> restored_results;
+  IterateTabletRows(tablet.get(), &restored_results);
+  ASSERT_GT(restored_results.size(), results.size());
+}
+
+// Tests that the log is replayed when RocksDB has flushed operations after the last op id of the
+// clean shutdown state.
+TEST_F(BootstrapTest, TestReplayAfterCleanShutdownWithFlushedFrontierAhead) {
+  BuildLog();
+  AppendReplicateBatchToLog(5);
+  ASSERT_OK(log_->Close());
+
+  CleanShutdownStatePB state;
+  vector<string> results;
+  BootstrapAndShutdownCleanly(&state, &results);
+  state.mutable_last_op_id()->set_index(state.last_op_id().index() - 1);
+  ASSERT_OK(RecordCleanShutdownState(state));
+
+  shared_ptr<TabletClass> tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_GT(SegmentsReplayed(tablet.get()), 0);
+  ASSERT_EQ(current_index_ - 1, boot_info.last_id.index());
+
+  vector<string> restored_results;
+  IterateTabletRows(tablet.get(), &restored_results);
+  ASSERT_EQ(results, restored_results);
+}
+
 // Test that we don't overflow opids. Regression test for KUDU-1933.
 TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   // Start appending with a log index 3 under the int32 max value.
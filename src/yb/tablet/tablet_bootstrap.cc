@@ -31,15 +31,22 @@
 //
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <deque>
+#include <future>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/retryable_requests.h"
+#include "yb/docdb/docdb.h"
 
 #include "yb/server/hybrid_clock.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/tablet/tablet_splitter.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -48,7 +55,10 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/opid.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/env_util.h"
 #include "yb/consensus/log_index.h"
 #include "yb/docdb/consensus_frontier.h"
@@ -81,10 +91,25 @@ DEFINE_bool(skip_flushed_entries, true,
 
 DECLARE_int32(retryable_request_timeout_secs);
 
+DEFINE_int32(tablet_bootstrap_replay_threads, 2,
+             "Number of threads used by a tablet bootstrap to read and decode log segments ahead "
+             "of replay and to encode their write batches. It is also the number of segments read "
+             "ahead. Entries are always applied in log order. 0 disables reading ahead. Each "
+             "bootstrapping tablet keeps up to this number of decoded segments in memory in "
+             "addition to the replayed one, so up to num_tablets_to_open_simultaneously times "
+             "that many segments could be held at once.");
+TAG_FLAG(tablet_bootstrap_replay_threads, advanced);
+
+DEFINE_int64(tablet_bootstrap_prepared_write_batches_limit_mb, 256,
+             "Limit of memory used by write batches that all tablet bootstraps of this server "
+             "encoded ahead of replay. Writes over the limit are encoded when they are applied.");
+TAG_FLAG(tablet_bootstrap_prepared_write_batches_limit_mb, advanced);
+
 namespace yb {
 namespace tablet {
 
 using namespace std::literals; // NOLINT
+using namespace yb::size_literals;
 using namespace std::placeholders;
 using std::shared_ptr;
 
@@ -141,6 +166,135 @@ struct Entry {
 
 typedef std::map<int64_t, Entry> OpIndexToEntryMap;
 
+namespace {
+
+// Log segment read and decoded ahead of replay.
+struct PrefetchedSegment {
+  log::ReadEntriesResult read_result;
+
+  // Encoded write batches of non transactional writes, indexed as read_result.entries.
+  // Contains empty batches for other entries, or could be empty when nothing was encoded.
+  std::vector<PreparedWriteBatch> write_batches;
+};
+
+// Memory of write batches encoded in advance by all tablet bootstraps of this process.
+const MemTrackerPtr& PreparedWriteBatchesMemTracker() {
+  static const MemTrackerPtr tracker = MemTracker::FindOrCreateTracker(
+      FLAGS_tablet_bootstrap_prepared_write_batches_limit_mb * 1_MB,
+      "Bootstrap Prepared Write Batches");
+  return tracker;
+}
+
+// Encodes write batches of non transactional writes that were not flushed to RocksDB yet.
+// Does the same as Tablet::ApplyKeyValueRowOperations, but could be done in parallel, since it
+// depends only on the replicated entry.
+size_t PrepareWriteBatches(int64_t regular_flushed_index, PrefetchedSegment* segment) {
+  const auto& tracker = PreparedWriteBatchesMemTracker();
+  size_t result = 0;
+  const auto& entries = segment->read_result.entries;
+  segment->write_batches.resize(entries.size());
+  for (size_t i = 0; i != entries.size(); ++i) {
+    const auto& entry = *entries[i];
+    if (entry.type() != log::REPLICATE) {
+      continue;
+    }
+    const auto& replicate = entry.replicate();
+    if (replicate.op_type() != consensus::WRITE_OP ||
+        replicate.id().index() <= regular_flushed_index) {
+      continue;
+    }
+    const auto& write = replicate.write_request();
+    const auto& put_batch = write.write_batch();
+    if (put_batch.has_transaction() || put_batch.write_pairs().empty() ||
+        !put_batch.read_pairs().empty()) {
+      continue;
+    }
+    auto hybrid_time = WriteRequestHybridTime(write, HybridTime(replicate.hybrid_time()));
+    auto write_batch = std::make_unique<rocksdb::WriteBatch>();
+    docdb::PrepareNonTransactionWriteBatch(put_batch, hybrid_time, write_batch.get());
+    // Batches over the limit are dropped, and encoded again when applied.
+    const auto size = write_batch->GetDataSize();
+    if (!tracker->TryConsume(size)) {
+      continue;
+    }
+    auto& prepared = segment->write_batches[i];
+    prepared.batch = std::move(write_batch);
+    prepared.consumption = ScopedTrackedConsumption(tracker, size, AlreadyConsumed::kTrue);
+    ++result;
+  }
+  return result;
+}
+
+// Reads log segments in order, keeping up to max_segments_ahead segments being read on the
+// thread pool. Segments are read synchronously when there is no thread pool.
+class SegmentPrefetcher {
+ public:
+  SegmentPrefetcher(log::SegmentSequence::const_iterator begin,
+                    log::SegmentSequence::const_iterator end,
+                    int64_t regular_flushed_index,
+                    ThreadPool* pool,
+                    size_t max_segments_ahead,
+                    TabletMetrics* metrics)
+      : next_(begin), end_(end), regular_flushed_index_(regular_flushed_index), pool_(pool),
+        max_segments_ahead_(max_segments_ahead), metrics_(metrics) {
+    Fill();
+  }
+
+  // Returns the next segment in log order, waiting for it to be read if necessary.
+  PrefetchedSegment Next() {
+    PrefetchedSegment result;
+    if (pending_.empty()) {
+      DCHECK(next_ != end_);
+      result.read_result = (*next_)->ReadEntries();
+      ++next_;
+      return result;
+    }
+    result = pending_.front().get();
+    pending_.pop_front();
+    Fill();
+    return result;
+  }
+
+ private:
+  void Fill() {
+    if (!pool_) {
+      return;
+    }
+    while (pending_.size() < max_segments_ahead_ && next_ != end_) {
+      auto promise = std::make_shared<std::promise<PrefetchedSegment>>();
+      auto future = promise->get_future();
+      auto status = pool_->SubmitFunc(
+          [segment = *next_, regular_flushed_index = regular_flushed_index_,
+           metrics = metrics_, promise] {
+        PrefetchedSegment result;
+        result.read_result = segment->ReadEntries();
+        auto prepared = PrepareWriteBatches(regular_flushed_index, &result);
+        if (metrics) {
+          metrics->bootstrap_write_batches_prepared->IncrementBy(prepared);
+        }
+        promise->set_value(std::move(result));
+      });
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to submit log segment read, reading synchronously: " << status;
+        pool_ = nullptr;
+        return;
+      }
+      pending_.push_back(std::move(future));
+      ++next_;
+    }
+  }
+
+  log::SegmentSequence::const_iterator next_;
+  const log::SegmentSequence::const_iterator end_;
+  const int64_t regular_flushed_index_;
+  ThreadPool* pool_;
+  const size_t max_segments_ahead_;
+  TabletMetrics* const metrics_;
+  std::deque<std::future<PrefetchedSegment>> pending_;
+};
+
+} // namespace
+
 // State kept during replay.
 struct ReplayState {
   ReplayState(const consensus::OpId& regular_op_id, const consensus::OpId& intents_op_id);
@@ -349,6 +503,13 @@ Status TabletBootstrap::Bootstrap(shared_ptr<TabletClass>* rebuilt_tablet,
 
   bool needs_recovery;
   RETURN_NOT_OK(PrepareToReplay(&needs_recovery));
+
+  // The clean shutdown state describes the log as it was at shutdown, so it is cleared before
+  // anything could be appended to the log.
+  auto clean_shutdown_state = meta_->TakeCleanShutdownState();
+  if (clean_shutdown_state) {
+    RETURN_NOT_OK(meta_->Flush());
+  }
   if (needs_recovery && !skip_wal_rewrite_) {
     RETURN_NOT_OK(OpenLogReader());
   }
@@ -374,7 +535,13 @@ Status TabletBootstrap::Bootstrap(shared_ptr<TabletClass>* rebuilt_tablet,
                                            tablet_id));
   }
 
-  RETURN_NOT_OK_PREPEND(PlaySegments(consensus_info), "Failed log replay. Reason");
+  bool restored = false;
+  if (clean_shutdown_state) {
+    restored = VERIFY_RESULT(RestoreCleanShutdownState(*clean_shutdown_state, consensus_info));
+  }
+  if (!restored) {
+    RETURN_NOT_OK_PREPEND(PlaySegments(consensus_info), "Failed log replay. Reason");
+  }
 
   if (cmeta_->current_term() < consensus_info->last_id.term()) {
     cmeta_->set_current_term(consensus_info->last_id.term());
@@ -700,6 +867,9 @@ Status TabletBootstrap::HandleOperation(consensus::OperationType op_type,
     case consensus::TRUNCATE_OP:
       return PlayTruncateRequest(replicate);
 
+    case consensus::SPLIT_OP:
+      return PlaySplitRequest(replicate);
+
     case consensus::NO_OP:
       return PlayNoOpRequest(replicate);
 
@@ -849,8 +1019,10 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
 
   // Open a new log. If skip_wal_rewrite is false, append each replayed entry to this new log.
   // Otherwise, defer appending to this log until bootstrap is finished to preserve the state of
-  // old log.
-  RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
+  // old log. The log could be already opened by RestoreCleanShutdownState.
+  if (!log_) {
+    RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
+  }
 
   log::SegmentSequence segments;
   RETURN_NOT_OK(log_->GetSegmentsSnapshot(&segments));
@@ -901,15 +1073,33 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
       }
   }
 
+  auto* metrics = tablet_->metrics();
+  std::unique_ptr<ThreadPool> replay_pool;
+  if (FLAGS_tablet_bootstrap_replay_threads > 0) {
+    RETURN_NOT_OK(ThreadPoolBuilder("bootstrap-replay")
+                      .set_min_threads(0)
+                      .set_max_threads(FLAGS_tablet_bootstrap_replay_threads)
+                      .Build(&replay_pool));
+  }
+  SegmentPrefetcher prefetcher(
+      iter, segments.end(), state.regular_stored_op_id.index(), replay_pool.get(),
+      std::max(FLAGS_tablet_bootstrap_replay_threads, 0), metrics);
+
   int segment_count = 0;
   yb::OpId last_committed_op_id;
   RestartSafeCoarseTimePoint last_entry_time;
   for (; iter != segments.end(); ++iter) {
     const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-    auto read_result = segment->ReadEntries();
+    auto prefetched_segment = prefetcher.Next();
+    auto& read_result = prefetched_segment.read_result;
+    auto& write_batches = prefetched_segment.write_batches;
     last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
     for (int entry_idx = 0; entry_idx < read_result.entries.size(); ++entry_idx) {
+      if (entry_idx < write_batches.size() && write_batches[entry_idx].batch) {
+        const auto& op_id = read_result.entries[entry_idx]->replicate().id();
+        prepared_write_batches_[yb::OpId::FromPB(op_id)] = std::move(write_batches[entry_idx]);
+      }
       Status s = HandleEntry(
           read_result.entry_metadata[entry_idx], &state, &read_result.entries[entry_idx]);
       if (!s.ok()) {
@@ -947,6 +1137,10 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
                                         segment_count + 1, segments.size(),
                                         stats_.ToString(),
                                         state.pending_replicates.size()));
+    if (metrics) {
+      metrics->bootstrap_segments_replayed->Increment();
+      metrics->bootstrap_ops_read->IncrementBy(read_result.entries.size());
+    }
     segment_count++;
   }
 
@@ -976,6 +1170,12 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     }
   }
 
+  // Batches of overwritten and not committed entries are not used.
+  prepared_write_batches_.clear();
+  if (metrics) {
+    metrics->bootstrap_ops_applied->IncrementBy(state.num_entries_applied_to_rocksdb);
+  }
+
   LOG_WITH_PREFIX(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
   DumpReplayStateToLog(state);
 
@@ -1006,6 +1206,110 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   return Status::OK();
 }
 
+Result<bool> TabletBootstrap::RestoreCleanShutdownState(
+    const CleanShutdownStatePB& state, ConsensusBootstrapInfo* consensus_info) {
+  if (!skip_wal_rewrite_ || FLAGS_force_recover_flushed_frontier) {
+    return false;
+  }
+
+  const auto last_op_id = yb::OpId::FromPB(state.last_op_id());
+  const auto flushed_op_id = VERIFY_RESULT(tablet_->MaxPersistentOpId());
+  if (flushed_op_id.regular > last_op_id || flushed_op_id.intents > last_op_id) {
+    LOG_WITH_PREFIX(WARNING)
+        << "Flushed op ids " << flushed_op_id.ToString() << " are after the last op id "
+        << last_op_id << " recorded at clean shutdown, replaying log";
+    return false;
+  }
+
+  RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
+
+  // Only footers of the segments are checked, the last segment is the one just opened.
+  log::SegmentSequence segments;
+  RETURN_NOT_OK(log_->GetSegmentsSnapshot(&segments));
+  int64_t max_replicate_index = -1;
+  for (size_t i = 0; i + 1 < segments.size(); ++i) {
+    if (!segments[i]->HasFooter() || segments[i]->footer_was_rebuilt()) {
+      LOG_WITH_PREFIX(WARNING) << "Log segment " << segments[i]->path()
+                               << " was not closed after clean shutdown, replaying log";
+      return false;
+    }
+    max_replicate_index = std::max(max_replicate_index,
+                                   segments[i]->footer().max_replicate_index());
+  }
+  if (max_replicate_index != last_op_id.index) {
+    LOG_WITH_PREFIX(WARNING)
+        << "Last log index " << max_replicate_index << " does not match the last op id "
+        << last_op_id << " recorded at clean shutdown, replaying log";
+    return false;
+  }
+
+  size_t segments_read = 0;
+  if (data_.retryable_requests) {
+    const auto restart_safe_time = RestartSafeCoarseTimePoint::FromUInt64(
+        state.restart_safe_time());
+    segments_read = VERIFY_RESULT(BootstrapRetryableRequests(
+        segments, last_op_id, restart_safe_time));
+    data_.retryable_requests->Clock().Adjust(restart_safe_time);
+  }
+
+  log_->SetLatestEntryOpId(last_op_id);
+  UpdateClock(state.last_replicated_hybrid_time());
+  tablet_->mvcc_manager()->SetLastReplicated(HybridTime(state.last_replicated_hybrid_time()));
+  consensus_info->last_id = last_op_id.ToPB<consensus::OpId>();
+  consensus_info->last_committed_id = consensus_info->last_id;
+
+  LOG_WITH_PREFIX(INFO) << "Skipped log replay after clean shutdown, last op id: " << last_op_id
+                        << ", segments read for retryable requests: " << segments_read;
+  listener_->StatusMessage(Substitute(
+      "Skipped replay of $0 log segments after clean shutdown, read $1 for retryable requests",
+      segments.size() - 1, segments_read));
+  return true;
+}
+
+Result<size_t> TabletBootstrap::BootstrapRetryableRequests(
+    const log::SegmentSequence& segments, const yb::OpId& last_op_id,
+    RestartSafeCoarseTimePoint restart_safe_time) {
+  // Same window as in PlaySegments: starting from the last segment whose first entry is older than
+  // the retryable request timeout. The last segment is the one just opened.
+  const RestartSafeCoarseDuration retain_limit =
+      std::chrono::seconds(GetAtomicFlag(&FLAGS_retryable_request_timeout_secs));
+  auto end = segments.end() - 1;
+  auto iter = end;
+  while (iter != segments.begin()) {
+    --iter;
+    auto first_entry = (**iter).ReadFirstEntryMetadata();
+    if (first_entry.ok() && first_entry->second <= restart_safe_time - retain_limit) {
+      break;
+    }
+  }
+
+  // Entries could be overwritten by a later leader, so only the last entry with each index is
+  // kept, as in ReplayState.
+  std::map<int64_t, std::pair<std::unique_ptr<LogEntryPB>, RestartSafeCoarseTimePoint>> writes;
+  const size_t segments_read = end - iter;
+  for (; iter != end; ++iter) {
+    auto read_result = (**iter).ReadEntries();
+    RETURN_NOT_OK_PREPEND(read_result.status, Format("Failed to read $0", (**iter).path()));
+    for (size_t i = 0; i != read_result.entries.size(); ++i) {
+      auto& entry = read_result.entries[i];
+      if (!entry->has_replicate()) {
+        continue;
+      }
+      const auto index = entry->replicate().id().index();
+      writes.erase(writes.lower_bound(index), writes.end());
+      if (entry->replicate().has_write_request() && index <= last_op_id.index) {
+        writes.emplace(index, std::make_pair(
+            std::move(entry), read_result.entry_metadata[i].entry_time));
+      }
+    }
+  }
+
+  for (const auto& write : writes) {
+    data_.retryable_requests->Bootstrap(write.second.first->replicate(), write.second.second);
+  }
+  return segments_read;
+}
+
 void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   DCHECK(replicate_msg->has_hybrid_time());
 
@@ -1025,7 +1329,15 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   // Use committed OpId for mem store anchoring.
   operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
 
-  WARN_NOT_OK(tablet_->ApplyRowOperations(&operation_state), "ApplyRowOperations failed: ");
+  PreparedWriteBatch prepared_write_batch;
+  auto it = prepared_write_batches_.find(yb::OpId::FromPB(replicate_msg->id()));
+  if (it != prepared_write_batches_.end()) {
+    prepared_write_batch = std::move(it->second);
+    prepared_write_batches_.erase(it);
+  }
+
+  WARN_NOT_OK(tablet_->ApplyRowOperations(&operation_state, prepared_write_batch.batch.get()),
+              "ApplyRowOperations failed: ");
 
   tablet_->mvcc_manager()->Replicated(hybrid_time);
 }
@@ -1104,6 +1416,20 @@ Status TabletBootstrap::PlayTruncateRequest(ReplicateMsg* replicate_msg) {
   return Status::OK();
 }
 
+Status TabletBootstrap::PlaySplitRequest(ReplicateMsg* replicate_msg) {
+  SplitOperationState operation_state(
+      tablet_.get(), data_.tablet_splitter, replicate_msg->mutable_split_request());
+
+  // Without the tablet splitter we still split the tablet data, so the tablet stops serving
+  // reads and writes, but new tablets are not started.
+  Status s = data_.tablet_splitter ? data_.tablet_splitter->ApplyTabletSplit(&operation_state)
+                                   : tablet_->Split(&operation_state);
+
+  RETURN_NOT_OK_PREPEND(s, "Failed to Split:");
+
+  return Status::OK();
+}
+
 Status TabletBootstrap::PlayUpdateTransactionRequest(
     ReplicateMsg* replicate_msg, AlreadyApplied already_applied) {
   DCHECK(replicate_msg->has_hybrid_time());
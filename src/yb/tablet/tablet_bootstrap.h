@@ -32,20 +32,36 @@
 #ifndef YB_TABLET_TABLET_BOOTSTRAP_H
 #define YB_TABLET_TABLET_BOOTSTRAP_H
 
+#include <unordered_map>
+
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/opid.h"
 #include "yb/util/threadpool.h"
 
+namespace rocksdb {
+class WriteBatch;
+}
+
 namespace yb {
 namespace tablet {
 
 struct ReplayState;
+class CleanShutdownStatePB;
 class WriteOperationState;
 
 YB_STRONGLY_TYPED_BOOL(AlreadyApplied);
 
+// Write batch encoded ahead of replay, with its memory accounted in a process wide tracker, so
+// the total size of such batches is limited.
+struct PreparedWriteBatch {
+  std::unique_ptr<rocksdb::WriteBatch> batch;
+  ScopedTrackedConsumption consumption;
+};
+
 // Bootstraps an existing tablet by opening the metadata from disk, and rebuilding soft state by
 // playing log segments. A bootstrapped tablet can then be added to an existing consensus
 // configuration as a LEARNER, which will bring its state up to date with the rest of the consensus
@@ -109,8 +125,25 @@ class TabletBootstrap {
   // Plays the log segments into the tablet being built.  The process of playing the segments
   // generates a new log that can be continued later on when then tablet is rebuilt and starts
   // accepting writes from clients.
+  //
+  // Segments are read, decoded and have their non transactional write batches encoded on a
+  // thread pool, ahead of the segment being replayed. Entries are still applied in log order by
+  // the calling thread.
   CHECKED_STATUS PlaySegments(consensus::ConsensusBootstrapInfo* results);
 
+  // Opens the log without replaying it, using the state recorded at clean shutdown, when all log
+  // entries were applied and flushed. Returns false if the log or the tablet does not match the
+  // recorded state, so segments should be played instead.
+  Result<bool> RestoreCleanShutdownState(
+      const CleanShutdownStatePB& state, consensus::ConsensusBootstrapInfo* results);
+
+  // Registers writes of the segments that fall into the retryable request timeout before
+  // restart_safe_time, so requests retried by clients after restart are not applied twice.
+  // Returns the number of segments read.
+  Result<size_t> BootstrapRetryableRequests(
+      const log::SegmentSequence& segments, const yb::OpId& last_op_id,
+      RestartSafeCoarseTimePoint restart_safe_time);
+
   void PlayWriteRequest(consensus::ReplicateMsg* replicate_msg);
 
   CHECKED_STATUS PlayUpdateTransactionRequest(
@@ -124,6 +157,8 @@ class TabletBootstrap {
 
   CHECKED_STATUS PlayTruncateRequest(consensus::ReplicateMsg* replicate_msg);
 
+  CHECKED_STATUS PlaySplitRequest(consensus::ReplicateMsg* replicate_msg);
+
   CHECKED_STATUS PlayTabletSnapshotOpRequest(consensus::ReplicateMsg* replicate_msg);
 
   void DumpReplayStateToLog(const ReplayState& state);
@@ -196,6 +231,10 @@ class TabletBootstrap {
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
 
+  // Write batches of replicated writes, encoded in advance by the replay thread pool.
+  // Consumed by PlayWriteRequest.
+  std::unordered_map<yb::OpId, PreparedWriteBatch, yb::OpIdHash> prepared_write_batches_;
+
   bool skip_wal_rewrite_;
 
  private:
@@ -74,6 +74,7 @@ class Clock;
 namespace tablet {
 class Tablet;
 class RaftGroupMetadata;
+class TabletSplitter;
 class TransactionCoordinatorContext;
 class TransactionParticipantContext;
 struct TabletOptions;
@@ -128,6 +129,7 @@ struct BootstrapTabletData {
   TransactionCoordinatorContext* transaction_coordinator_context;
   ThreadPool* append_pool;
   consensus::RetryableRequests* retryable_requests;
+  TabletSplitter* tablet_splitter;
 };
 
 // Bootstraps a tablet, initializing it with the provided metadata. If the tablet
@@ -526,6 +526,11 @@ Status RaftGroupMetadata::LoadFromSuperBlock(const RaftGroupReplicaSuperBlockPB&
     } else {
       tombstone_last_logged_opid_ = OpId();
     }
+
+    split_child_tablet_ids_.assign(
+        superblock.split_child_tablet_ids().begin(), superblock.split_child_tablet_ids().end());
+
+    clean_shutdown_state_ = superblock.clean_shutdown_state();
   }
 
   return Status::OK();
@@ -605,6 +610,12 @@ void RaftGroupMetadata::ToSuperBlockUnlocked(RaftGroupReplicaSuperBlockPB* super
   if (tombstone_last_logged_opid_) {
     tombstone_last_logged_opid_.ToPB(pb.mutable_tombstone_last_logged_opid());
   }
+  for (const auto& child_tablet_id : split_child_tablet_ids_) {
+    pb.add_split_child_tablet_ids(child_tablet_id);
+  }
+  if (clean_shutdown_state_.has_last_op_id()) {
+    *pb.mutable_clean_shutdown_state() = clean_shutdown_state_;
+  }
 
   pb.set_primary_table_id(primary_table_id_);
 
@@ -752,10 +763,43 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateSubtabletMetadata(
   metadata->kv_store_.upper_bound_key = upper_bound_key;
   metadata->kv_store_.rocksdb_dir = JoinPathSegments(DirName(kv_store_.rocksdb_dir), tablet_dir);
   metadata->partition_ = partition;
+  metadata->tablet_data_state_ = TABLET_DATA_COPYING;
+  metadata->split_child_tablet_ids_.clear();
+  metadata->clean_shutdown_state_.Clear();
   RETURN_NOT_OK(metadata->Flush());
   return metadata;
 }
 
+std::vector<TabletId> RaftGroupMetadata::split_child_tablet_ids() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  return split_child_tablet_ids_;
+}
+
+void RaftGroupMetadata::SetSplitDone(const TabletId& child1, const TabletId& child2) {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  split_child_tablet_ids_ = {child1, child2};
+}
+
+bool RaftGroupMetadata::IsSplitDone() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  return !split_child_tablet_ids_.empty();
+}
+
+void RaftGroupMetadata::SetCleanShutdownState(const CleanShutdownStatePB& state) {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  clean_shutdown_state_ = state;
+}
+
+boost::optional<CleanShutdownStatePB> RaftGroupMetadata::TakeCleanShutdownState() {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  if (!clean_shutdown_state_.has_last_op_id()) {
+    return boost::none;
+  }
+  boost::optional<CleanShutdownStatePB> result(std::move(clean_shutdown_state_));
+  clean_shutdown_state_.Clear();
+  return result;
+}
+
 
 namespace {
 // MigrateSuperblockForDXXXX functions are only needed for backward compatibility with
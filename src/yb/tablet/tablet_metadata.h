@@ -376,6 +376,20 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   yb::OpId tombstone_last_logged_opid() const { return tombstone_last_logged_opid_; }
 
+  // Ids of the tablets this Raft group was split into, empty if the Raft group was not split.
+  std::vector<TabletId> split_child_tablet_ids() const;
+
+  // Records that this Raft group was split into the specified tablets. Does not flush metadata.
+  void SetSplitDone(const TabletId& child1, const TabletId& child2);
+
+  bool IsSplitDone() const;
+
+  // Records the state of a clean shutdown, see CleanShutdownStatePB. Does not flush metadata.
+  void SetCleanShutdownState(const CleanShutdownStatePB& state);
+
+  // Returns the state recorded at clean shutdown, if any, and clears it. Does not flush metadata.
+  boost::optional<CleanShutdownStatePB> TakeCleanShutdownState();
+
   // Loads the currently-flushed superblock from disk into the given protobuf.
   CHECKED_STATUS ReadSuperBlockFromDisk(RaftGroupReplicaSuperBlockPB* superblock) const;
 
@@ -387,6 +401,7 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   // Creates a new Raft group metadata for the part of existing tablet contained in this Raft group.
   // Assigns specified Raft group ID, partition and key bounds for a new tablet.
+  // The new tablet is in TABLET_DATA_COPYING state until the caller populates its data.
   Result<RaftGroupMetadataPtr> CreateSubtabletMetadata(
       const RaftGroupId& raft_group_id, const Partition& partition,
       const std::string& lower_bound_key, const std::string& upper_bound_key) const;
@@ -491,6 +506,12 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // non-tombstoned tablets.
   yb::OpId tombstone_last_logged_opid_;
 
+  // Ids of the tablets this Raft group was split into.
+  std::vector<TabletId> split_child_tablet_ids_;
+
+  // State recorded at clean shutdown, empty if the Raft group was not shut down cleanly.
+  CleanShutdownStatePB clean_shutdown_state_;
+
   DISALLOW_COPY_AND_ASSIGN(RaftGroupMetadata);
 };
 
@@ -134,6 +134,26 @@ METRIC_DEFINE_counter(tablet, restart_read_requests,
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_counter(tablet, bootstrap_segments_replayed,
+  "Bootstrap Log Segments Replayed",
+  yb::MetricUnit::kUnits,
+  "Number of log segments replayed by the tablet bootstrap.");
+
+METRIC_DEFINE_counter(tablet, bootstrap_ops_read,
+  "Bootstrap Log Entries Read",
+  yb::MetricUnit::kEntries,
+  "Number of log entries read by the tablet bootstrap.");
+
+METRIC_DEFINE_counter(tablet, bootstrap_ops_applied,
+  "Bootstrap Operations Applied",
+  yb::MetricUnit::kOperations,
+  "Number of operations applied to RocksDB by the tablet bootstrap.");
+
+METRIC_DEFINE_counter(tablet, bootstrap_write_batches_prepared,
+  "Bootstrap Write Batches Prepared",
+  yb::MetricUnit::kOperations,
+  "Number of write batches encoded ahead of replay by the tablet bootstrap.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -152,7 +172,11 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
     MINIT(restart_read_requests),
-    MINIT(rows_inserted) {
+    MINIT(rows_inserted),
+    MINIT(bootstrap_segments_replayed),
+    MINIT(bootstrap_ops_read),
+    MINIT(bootstrap_ops_applied),
+    MINIT(bootstrap_write_batches_prepared) {
 }
 #undef MINIT
 
@@ -68,6 +68,11 @@ struct TabletMetrics {
   scoped_refptr<Counter> restart_read_requests;
 
   scoped_refptr<Counter> rows_inserted;
+
+  scoped_refptr<Counter> bootstrap_segments_replayed;
+  scoped_refptr<Counter> bootstrap_ops_read;
+  scoped_refptr<Counter> bootstrap_ops_applied;
+  scoped_refptr<Counter> bootstrap_write_batches_prepared;
 };
 
 class ScopedTabletMetricsTracker {
@@ -31,6 +31,7 @@ class Env;
 namespace tablet {
 
 YB_STRONGLY_TYPED_BOOL(IsDropTable);
+YB_STRONGLY_TYPED_BOOL(RecordCleanShutdown);
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
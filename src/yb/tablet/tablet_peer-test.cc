@@ -44,6 +44,7 @@
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/retryable_requests.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/gutil/macros.h"
 #include "yb/rpc/messenger.h"
@@ -53,6 +54,8 @@
 #include "yb/tablet/operations/operation.h"
 #include "yb/tablet/operations/operation_driver.h"
 #include "yb/tablet/operations/write_operation.h"
+#include "yb/tablet/tablet_bootstrap_if.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_peer_mm_ops.h"
 #include "yb/tablet/tablet-test-util.h"
@@ -452,6 +455,62 @@ TEST_P(TabletPeerTest, TestGCEmptyLog) {
   ASSERT_OK(tablet_peer_->RunLogGC());
 }
 
+// Tests that shutdown records the clean shutdown state, and that the next bootstrap uses it.
+TEST_P(TabletPeerTest, TestRecordCleanShutdown) {
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+  ASSERT_OK(ExecuteInsertsAndRollLogs(3));
+
+  const auto last_op_id = tablet_peer_->log()->GetLatestEntryOpId();
+  ASSERT_TRUE(tablet_peer_->StartShutdown());
+  tablet_peer_->CompleteShutdown(IsDropTable::kFalse, RecordCleanShutdown::kTrue);
+
+  RaftGroupReplicaSuperBlockPB superblock;
+  ASSERT_OK(tablet()->metadata()->ReadSuperBlockFromDisk(&superblock));
+  ASSERT_TRUE(superblock.has_clean_shutdown_state());
+  const auto& state = superblock.clean_shutdown_state();
+  ASSERT_EQ(last_op_id, yb::OpId::FromPB(state.last_op_id()));
+  ASSERT_NE(0, state.last_replicated_hybrid_time());
+  ASSERT_NE(0, state.restart_safe_time());
+
+  RaftGroupMetadataPtr meta;
+  ASSERT_OK(RaftGroupMetadata::Load(tablet()->metadata()->fs_manager(), tablet()->tablet_id(),
+                                    &meta));
+  TabletStatusListener listener(meta);
+  MetricRegistry metric_registry;
+  consensus::RetryableRequests retryable_requests;
+  BootstrapTabletData data = {
+      meta,
+      std::shared_future<client::YBClient*>(),
+      scoped_refptr<Clock>(clock()),
+      shared_ptr<MemTracker>() /* mem_tracker */,
+      shared_ptr<MemTracker>() /* block_based_table_mem_tracker */,
+      &metric_registry,
+      &listener,
+      make_scoped_refptr(new LogAnchorRegistry()),
+      TabletOptions(),
+      std::string() /* log_prefix_suffix */,
+      nullptr /* transaction_participant_context */,
+      client::LocalTabletFilter(),
+      nullptr /* transaction_coordinator_context */,
+      append_pool_.get(),
+      &retryable_requests};
+  shared_ptr<TabletClass> tablet;
+  scoped_refptr<Log> log;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTablet(data, &tablet, &log, &boot_info));
+  ASSERT_EQ(0, tablet->metrics()->bootstrap_segments_replayed->value());
+  ASSERT_EQ(last_op_id, yb::OpId::FromPB(boot_info.last_id));
+  ASSERT_EQ(last_op_id, yb::OpId::FromPB(boot_info.last_committed_id));
+  std::vector<std::string> rows;
+  ASSERT_OK(DumpTablet(*tablet, *tablet->schema(), &rows));
+  ASSERT_EQ(insert_counter_, static_cast<int32_t>(rows.size()));
+  ASSERT_FALSE(meta->TakeCleanShutdownState());
+
+  ASSERT_OK(log->Close());
+  tablet->Shutdown();
+}
+
 INSTANTIATE_TEST_CASE_P(Rocks, TabletPeerTest, ::testing::Values(YQL_TABLE_TYPE));
 
 } // namespace tablet
@@ -72,6 +72,7 @@
 
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/operation_driver.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
@@ -144,7 +145,8 @@ TabletPeer::TabletPeer(
     const scoped_refptr<server::Clock> &clock,
     const std::string& permanent_uuid,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
-    MetricRegistry* metric_registry)
+    MetricRegistry* metric_registry,
+    TabletSplitter* tablet_splitter)
   : meta_(meta),
     tablet_id_(meta->raft_group_id()),
     local_peer_pb_(local_peer_pb),
@@ -155,7 +157,8 @@ TabletPeer::TabletPeer(
     log_anchor_registry_(new LogAnchorRegistry()),
     mark_dirty_clbk_(std::move(mark_dirty_clbk)),
     permanent_uuid_(permanent_uuid),
-    metric_registry_(metric_registry) {}
+    metric_registry_(metric_registry),
+    tablet_splitter_(tablet_splitter) {}
 
 TabletPeer::~TabletPeer() {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -173,7 +176,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
                                   const scoped_refptr<MetricEntity> &metric_entity,
                                   ThreadPool* raft_pool,
                                   ThreadPool* tablet_prepare_pool,
-                                  consensus::RetryableRequests* retryable_requests) {
+                                  consensus::RetryableRequests* retryable_requests,
+                                  consensus::MultiRaftManager* multi_raft_manager) {
 
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -251,7 +255,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
@@ -388,7 +393,8 @@ bool TabletPeer::StartShutdown() {
   return true;
 }
 
-void TabletPeer::CompleteShutdown(IsDropTable is_drop_table) {
+void TabletPeer::CompleteShutdown(
+    IsDropTable is_drop_table, RecordCleanShutdown record_clean_shutdown) {
   auto wait_start = CoarseMonoClock::now();
   auto last_report = wait_start;
   while (preparing_operations_.load(std::memory_order_acquire) != 0) {
@@ -415,6 +421,10 @@ void TabletPeer::CompleteShutdown(IsDropTable is_drop_table) {
     WARN_NOT_OK(log_->Close(), LogPrefix() + "Error closing the Log");
   }
 
+  if (record_clean_shutdown && !is_drop_table) {
+    WARN_NOT_OK(DoRecordCleanShutdown(), LogPrefix() + "Failed to record clean shutdown");
+  }
+
   VLOG_WITH_PREFIX(1) << "Shut down!";
 
   if (tablet_) {
@@ -442,6 +452,42 @@ void TabletPeer::CompleteShutdown(IsDropTable is_drop_table) {
   }
 }
 
+Status TabletPeer::DoRecordCleanShutdown() {
+  if (!tablet_ || !consensus_ || !log_) {
+    return Status::OK();
+  }
+  // State of the transaction coordinator is recovered from the log only.
+  if (tablet_->transaction_coordinator()) {
+    return Status::OK();
+  }
+
+  auto last_op_id = log_->GetLatestEntryOpId();
+  auto committed_op_id = consensus_->GetLastCommittedOpId();
+  if (last_op_id != committed_op_id) {
+    LOG_WITH_PREFIX(INFO) << "Log has not committed entries, last: " << last_op_id
+                          << ", committed: " << committed_op_id << ", replay will be required";
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK(tablet_->Flush(FlushMode::kSync));
+  auto oldest_memtable_write = VERIFY_RESULT(tablet_->OldestMutableMemtableWriteHybridTime());
+  if (oldest_memtable_write != HybridTime::kMax) {
+    return STATUS_FORMAT(IllegalState, "Memtable is not empty after flush: $0",
+                         oldest_memtable_write);
+  }
+
+  CleanShutdownStatePB state;
+  last_op_id.ToPB(state.mutable_last_op_id());
+  state.set_last_replicated_hybrid_time(
+      tablet_->mvcc_manager()->LastReplicatedHybridTime().ToUint64());
+  state.set_restart_safe_time(consensus_->RestartSafeNow().ToUInt64());
+  meta_->SetCleanShutdownState(state);
+  RETURN_NOT_OK(meta_->Flush());
+
+  LOG_WITH_PREFIX(INFO) << "Recorded clean shutdown: " << state.ShortDebugString();
+  return Status::OK();
+}
+
 void TabletPeer::WaitUntilShutdown() {
   const MonoDelta kSingleWait = 10ms;
   const MonoDelta kReportInterval = 5s;
@@ -666,6 +712,9 @@ consensus::OperationType MapOperationTypeToPB(OperationType operation_type) {
     case OperationType::kTruncate:
       return consensus::TRUNCATE_OP;
 
+    case OperationType::kSplit:
+      return consensus::SPLIT_OP;
+
     case OperationType::kEmpty:
       LOG(FATAL) << "OperationType::kEmpty cannot be converted to consensus::OperationType";
   }
@@ -839,6 +888,13 @@ std::unique_ptr<Operation> TabletPeer::CreateOperation(consensus::ReplicateMsg*
       return std::make_unique<SnapshotOperation>(
           std::make_unique<SnapshotOperationState>(tablet()));
 
+    case consensus::SPLIT_OP:
+      DCHECK(replicate_msg->has_split_request()) << "SPLIT_OP replica"
+          " operation must receive an SplitTabletRequestPB";
+      LOG_IF_WITH_PREFIX(DFATAL, !tablet_splitter_) << "Split operation without tablet splitter";
+      return std::make_unique<SplitOperation>(
+          std::make_unique<SplitOperationState>(tablet(), tablet_splitter_));
+
     case consensus::UNKNOWN_OP: FALLTHROUGH_INTENDED;
     case consensus::NO_OP: FALLTHROUGH_INTENDED;
     case consensus::CHANGE_CONFIG_OP:
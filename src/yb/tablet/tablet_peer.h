@@ -86,6 +86,7 @@ class ThreadPool;
 namespace tablet {
 
 class Operation;
+class TabletSplitter;
 
 // A peer in a tablet consensus configuration, which coordinates writes to tablets.
 // Each time Write() is called this class appends a new entry to a replicated
@@ -104,7 +105,8 @@ class TabletPeer : public consensus::ConsensusContext,
              const scoped_refptr<server::Clock> &clock,
              const std::string& permanent_uuid,
              Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
-             MetricRegistry* metric_registry);
+             MetricRegistry* metric_registry,
+             TabletSplitter* tablet_splitter = nullptr);
 
   ~TabletPeer();
 
@@ -119,7 +121,8 @@ class TabletPeer : public consensus::ConsensusContext,
                                 const scoped_refptr<MetricEntity> &metric_entity,
                                 ThreadPool* raft_pool,
                                 ThreadPool* tablet_prepare_pool,
-                                consensus::RetryableRequests* retryable_requests);
+                                consensus::RetryableRequests* retryable_requests,
+                                consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -130,7 +133,10 @@ class TabletPeer : public consensus::ConsensusContext,
   // Returns true if shutdown was just initiated, false if shutdown was already running.
   MUST_USE_RESULT bool StartShutdown();
   // Completes shutdown process and waits for it's completeness.
-  void CompleteShutdown(IsDropTable is_drop_table = IsDropTable::kFalse);
+  // When record_clean_shutdown is set and the whole WAL was applied, flushes the tablet and records
+  // it in the metadata, so the next bootstrap could skip log replay.
+  void CompleteShutdown(IsDropTable is_drop_table = IsDropTable::kFalse,
+                        RecordCleanShutdown record_clean_shutdown = RecordCleanShutdown::kFalse);
 
   void Shutdown(IsDropTable is_drop_table = IsDropTable::kFalse);
 
@@ -426,6 +432,8 @@ class TabletPeer : public consensus::ConsensusContext,
  private:
   HybridTime ReportReadRestart() override;
 
+  CHECKED_STATUS DoRecordCleanShutdown();
+
   HybridTime HybridTimeLease(MicrosTime min_allowed, CoarseTimePoint deadline);
   HybridTime PropagatedSafeTime() override;
   void MajorityReplicated() override;
@@ -434,6 +442,9 @@ class TabletPeer : public consensus::ConsensusContext,
 
   MetricRegistry* metric_registry_;
 
+  // Applies replicated split operations, could be null if the tablet should not be split.
+  TabletSplitter* const tablet_splitter_;
+
   bool IsLeader() override {
     return LeaderTerm() != OpId::kUnknownTerm;
   }
@@ -0,0 +1,37 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TABLET_SPLITTER_H
+#define YB_TABLET_TABLET_SPLITTER_H
+
+#include "yb/util/status.h"
+
+namespace yb {
+namespace tablet {
+
+class SplitOperationState;
+
+// Applies the split tablet operation: creates the new tablets on disk and starts their Raft
+// groups. Implemented by the tablet manager, because the new tablets should be registered in it.
+class TabletSplitter {
+ public:
+  virtual ~TabletSplitter() = default;
+
+  // Should be idempotent, since the split operation could be applied again during bootstrap.
+  virtual CHECKED_STATUS ApplyTabletSplit(SplitOperationState* state) = 0;
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_TABLET_SPLITTER_H
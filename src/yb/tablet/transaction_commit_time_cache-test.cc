@@ -0,0 +1,137 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/transaction_commit_time_cache.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class TransactionCommitTimeCacheTest : public YBTest {
+};
+
+TEST_F(TransactionCommitTimeCacheTest, InsertAndErase) {
+  auto mem_tracker = MemTracker::CreateTracker("commit_time_cache");
+  TransactionCommitTimeCache cache(mem_tracker);
+
+  auto id1 = GenerateTransactionId();
+  auto id2 = GenerateTransactionId();
+  cache.Insert(id1, HybridTime(100));
+  cache.Insert(id2, HybridTime(200));
+  // Commit time of a transaction never changes, so repeated insert keeps the original value.
+  cache.Insert(id1, HybridTime(300));
+
+  ASSERT_EQ(HybridTime(100), cache.Get(id1));
+  ASSERT_EQ(HybridTime(200), cache.Get(id2));
+  ASSERT_FALSE(cache.Get(GenerateTransactionId()).is_valid());
+  ASSERT_EQ(2U, cache.size());
+  ASSERT_GT(mem_tracker->consumption(), 0);
+
+  cache.Erase(id1);
+  ASSERT_FALSE(cache.Get(id1).is_valid());
+  ASSERT_EQ(HybridTime(200), cache.Get(id2));
+
+  cache.Erase(id2);
+  ASSERT_EQ(0U, cache.size());
+  ASSERT_EQ(0, mem_tracker->consumption());
+}
+
+TEST_F(TransactionCommitTimeCacheTest, EvictOldestWhenLimitReached) {
+  constexpr int64_t kLimit = 1024;
+  auto mem_tracker = MemTracker::CreateTracker(kLimit, "commit_time_cache");
+  TransactionCommitTimeCache cache(mem_tracker);
+
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 1000; ++i) {
+    ids.push_back(GenerateTransactionId());
+    cache.Insert(ids.back(), HybridTime(i + 1));
+  }
+
+  ASSERT_LT(cache.size(), ids.size());
+  ASSERT_GT(cache.size(), 0U);
+  ASSERT_LE(mem_tracker->consumption(), kLimit);
+  // The oldest entries are evicted first.
+  ASSERT_FALSE(cache.Get(ids.front()).is_valid());
+  ASSERT_EQ(HybridTime(ids.size()), cache.Get(ids.back()));
+}
+
+TEST_F(TransactionCommitTimeCacheTest, SkipWhenParentLimitReached) {
+  constexpr int64_t kParentLimit = 4096;
+  auto parent_tracker = MemTracker::CreateTracker(kParentLimit, "commit_time_cache_parent");
+  auto mem_tracker = MemTracker::CreateTracker("commit_time_cache", parent_tracker);
+  TransactionCommitTimeCache cache(mem_tracker);
+
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 10; ++i) {
+    ids.push_back(GenerateTransactionId());
+    cache.Insert(ids.back(), HybridTime(i + 1));
+  }
+  ASSERT_EQ(ids.size(), cache.size());
+
+  // Memory used by other children of the parent does not make the cache evict its entries, the new
+  // entry is not cached instead.
+  ScopedTrackedConsumption other_consumption(
+      parent_tracker, kParentLimit - parent_tracker->consumption());
+  auto id = GenerateTransactionId();
+  cache.Insert(id, HybridTime(100));
+  ASSERT_FALSE(cache.Get(id).is_valid());
+  ASSERT_EQ(ids.size(), cache.size());
+  for (size_t i = 0; i != ids.size(); ++i) {
+    ASSERT_EQ(HybridTime(i + 1), cache.Get(ids[i]));
+  }
+}
+
+TEST_F(TransactionCommitTimeCacheTest, ConcurrentAccess) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumTransactions = 1000;
+
+  auto mem_tracker = MemTracker::CreateTracker("commit_time_cache");
+  TransactionCommitTimeCache cache(mem_tracker);
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != kNumTransactions; ++i) {
+    ids.push_back(GenerateTransactionId());
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([&cache, &ids] {
+      for (int i = 0; i != kNumTransactions; ++i) {
+        auto commit_time = cache.Get(ids[i]);
+        if (commit_time.is_valid()) {
+          ASSERT_EQ(HybridTime(i + 1), commit_time);
+        } else {
+          cache.Insert(ids[i], HybridTime(i + 1));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(static_cast<size_t>(kNumTransactions), cache.size());
+  for (int i = 0; i != kNumTransactions; ++i) {
+    ASSERT_EQ(HybridTime(i + 1), cache.Get(ids[i]));
+    cache.Erase(ids[i]);
+  }
+  ASSERT_EQ(0, mem_tracker->consumption());
+}
+
+} // namespace tablet
+} // namespace yb
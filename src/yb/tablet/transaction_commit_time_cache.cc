@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_commit_time_cache.h"
+
+#include <mutex>
+
+#include "yb/util/shared_lock.h"
+
+namespace yb {
+namespace tablet {
+
+constexpr int64_t TransactionCommitTimeCache::kEntryMemoryUsage;
+
+TransactionCommitTimeCache::TransactionCommitTimeCache(MemTrackerPtr mem_tracker)
+    : mem_tracker_(std::move(mem_tracker)) {
+}
+
+TransactionCommitTimeCache::~TransactionCommitTimeCache() {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  mem_tracker_->Release(entries_.size() * kEntryMemoryUsage);
+}
+
+HybridTime TransactionCommitTimeCache::Get(const TransactionId& id) const {
+  SharedLock<rw_spinlock> lock(mutex_);
+  const auto& index = entries_.get<IdTag>();
+  auto it = index.find(id);
+  return it != index.end() ? it->commit_time : HybridTime::kInvalid;
+}
+
+void TransactionCommitTimeCache::Insert(const TransactionId& id, HybridTime commit_time) {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  if (entries_.get<IdTag>().count(id)) {
+    return;
+  }
+  while (!mem_tracker_->TryConsume(kEntryMemoryUsage)) {
+    // Evicting entries makes room only while the limit of the cache itself is reached. When an
+    // ancestor tracker is out of memory, the entry is not cached instead of evicting the whole
+    // cache for nothing.
+    if (entries_.empty() || !mem_tracker_->has_limit() ||
+        mem_tracker_->consumption() + kEntryMemoryUsage <= mem_tracker_->limit()) {
+      return;
+    }
+    entries_.pop_front();
+    mem_tracker_->Release(kEntryMemoryUsage);
+  }
+  entries_.push_back(Entry{id, commit_time});
+}
+
+void TransactionCommitTimeCache::Erase(const TransactionId& id) {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  if (entries_.get<IdTag>().erase(id)) {
+    mem_tracker_->Release(kEntryMemoryUsage);
+  }
+}
+
+size_t TransactionCommitTimeCache::size() const {
+  SharedLock<rw_spinlock> lock(mutex_);
+  return entries_.size();
+}
+
+} // namespace tablet
+} // namespace yb
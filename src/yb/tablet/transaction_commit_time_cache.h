@@ -0,0 +1,87 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_COMMIT_TIME_CACHE_H
+#define YB_TABLET_TRANSACTION_COMMIT_TIME_CACHE_H
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/mem_tracker.h"
+
+namespace yb {
+namespace tablet {
+
+// Tablet wide cache of commit times for transactions, that were resolved as committed by the
+// transaction coordinator, but were not yet applied to this tablet.
+// It is shared by all readers of the tablet, so a transaction resolved by one reader is not
+// resolved again by others.
+//
+// Commit time of a transaction never changes, so an entry could not become stale. Entries are
+// removed when the transaction is applied or cleaned up. Memory used by entries is consumed from
+// the provided mem tracker, the oldest entries are evicted when its limit is reached. When an
+// ancestor of the mem tracker is out of memory, new entries are not cached.
+class TransactionCommitTimeCache {
+ public:
+  explicit TransactionCommitTimeCache(MemTrackerPtr mem_tracker);
+  ~TransactionCommitTimeCache();
+
+  TransactionCommitTimeCache(const TransactionCommitTimeCache&) = delete;
+  void operator=(const TransactionCommitTimeCache&) = delete;
+
+  // Returns commit time of specified transaction, or invalid hybrid time if it is not cached.
+  HybridTime Get(const TransactionId& id) const;
+
+  void Insert(const TransactionId& id, HybridTime commit_time);
+
+  void Erase(const TransactionId& id);
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    TransactionId id;
+    HybridTime commit_time;
+  };
+
+  class IdTag;
+
+  typedef boost::multi_index_container<
+      Entry,
+      boost::multi_index::indexed_by<
+          boost::multi_index::sequenced<>,
+          boost::multi_index::hashed_unique<
+              boost::multi_index::tag<IdTag>,
+              boost::multi_index::member<Entry, TransactionId, &Entry::id>,
+              TransactionIdHash>
+      >
+  > Entries;
+
+  // Approximate memory used by single entry, including overhead of the indexes.
+  static constexpr int64_t kEntryMemoryUsage = sizeof(Entry) + 4 * sizeof(void*);
+
+  MemTrackerPtr mem_tracker_;
+  mutable rw_spinlock mutex_;
+  Entries entries_ GUARDED_BY(mutex_);
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_COMMIT_TIME_CACHE_H
@@ -40,25 +40,34 @@
 
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/transaction_commit_time_cache.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
 #include "yb/util/flag_tags.h"
 #include "yb/util/locks.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/thread_restrictions.h"
 
 DECLARE_uint64(aborted_intent_cleanup_ms);
 
 using namespace std::literals;
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 DEFINE_uint64(transaction_delay_status_reply_usec_in_tests, 0,
               "For tests only. Delay handling status reply by specified amount of usec.");
 DEFINE_double(transaction_ignore_applying_probability_in_tests, 0,
               "Probability to ignore APPLYING update in tests.");
+DEFINE_int64(transaction_commit_time_cache_limit_bytes, 256_KB,
+             "Memory limit for per tablet cache of commit times of transactions, that were "
+             "resolved by readers but not yet applied to the tablet.");
+TAG_FLAG(transaction_commit_time_cache_limit_bytes, advanced);
+
 DEFINE_test_flag(bool, fail_in_apply_if_no_metadata, false,
                  "Fail when applying intents if metadata is not found.");
 DEFINE_test_flag(int32, inject_load_transaction_delay_ms, 0,
@@ -155,8 +164,10 @@ typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
-                            TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+                            TransactionIntentApplier* applier,
+                            const MemTrackerPtr& commit_time_cache_mem_tracker)
+      : participant_context_(*participant_context), applier_(*applier),
+        commit_time_cache_(commit_time_cache_mem_tracker) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -182,6 +193,9 @@ class RunningTransactionContext {
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  // Has its own lock, so readers could check commit time without acquiring mutex_.
+  TransactionCommitTimeCache commit_time_cache_;
+
   // Used only in tests.
   Delayer delayer_;
 };
@@ -628,6 +642,11 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
       if (last_known_status_hybrid_time_ <= time_of_status) {
         last_known_status_hybrid_time_ = time_of_status;
         last_known_status_ = response.status();
+        if (response.status() == TransactionStatus::COMMITTED) {
+          // Status time of committed transaction is its commit time. Even if transaction was
+          // already removed, the cached commit time is still correct and will be evicted.
+          context_.commit_time_cache_.Insert(id(), time_of_status);
+        }
         if (response.status() == TransactionStatus::ABORTED &&
             ThreadRestrictions::IsWaitAllowed() && // Required by IsLeader
             context_.participant_context_.IsLeader()) {
@@ -775,8 +794,12 @@ std::string TransactionApplyData::ToString() const {
 class TransactionParticipant::Impl : public RunningTransactionContext {
  public:
   Impl(TransactionParticipantContext* context, TransactionIntentApplier* applier,
-       const scoped_refptr<MetricEntity>& entity)
-      : RunningTransactionContext(context, applier),
+       const scoped_refptr<MetricEntity>& entity, const MemTrackerPtr& tablet_mem_tracker)
+      : RunningTransactionContext(
+            context, applier,
+            MemTracker::FindOrCreateTracker(
+                FLAGS_transaction_commit_time_cache_limit_bytes, "TransactionCommitTimeCache",
+                tablet_mem_tracker)),
         log_prefix_(Format("T $0 P $1: ", context->tablet_id(), context->permanent_uuid())) {
     LOG_WITH_PREFIX(INFO) << "Start";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
@@ -826,6 +849,11 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   HybridTime LocalCommitTime(const TransactionId& id) {
+    auto cached_commit_time = commit_time_cache_.Get(id);
+    if (cached_commit_time.is_valid()) {
+      return cached_commit_time;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -834,6 +862,10 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     return (**it).local_commit_time();
   }
 
+  size_t TEST_CommitTimeCacheSize() const {
+    return commit_time_cache_.size();
+  }
+
   size_t TEST_CountIntents() {
     size_t count = 0;
     auto iter = docdb::CreateRocksDBIterator(db_,
@@ -1407,6 +1439,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     recently_removed_transactions_cleanup_queue_.push_back({transaction.id(), now + 15s});
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
+    commit_time_cache_.Erase(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked();
   }
@@ -1464,8 +1497,8 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
 
 TransactionParticipant::TransactionParticipant(
     TransactionParticipantContext* context, TransactionIntentApplier* applier,
-    const scoped_refptr<MetricEntity>& entity)
-    : impl_(new Impl(context, applier, entity)) {
+    const scoped_refptr<MetricEntity>& entity, const MemTrackerPtr& tablet_mem_tracker)
+    : impl_(new Impl(context, applier, entity, tablet_mem_tracker)) {
 }
 
 TransactionParticipant::~TransactionParticipant() {
@@ -1499,6 +1532,10 @@ size_t TransactionParticipant::TEST_CountIntents() const {
   return impl_->TEST_CountIntents();
 }
 
+size_t TransactionParticipant::TEST_CommitTimeCacheSize() const {
+  return impl_->TEST_CommitTimeCacheSize();
+}
+
 void TransactionParticipant::RequestStatusAt(const StatusRequest& request) {
   return impl_->RequestStatusAt(request);
 }
@@ -50,6 +50,7 @@ class WriteBatch;
 namespace yb {
 
 class HybridTime;
+class MemTracker;
 class TransactionMetadataPB;
 
 namespace tserver {
@@ -121,7 +122,8 @@ class TransactionParticipant : public TransactionStatusManager {
  public:
   TransactionParticipant(
       TransactionParticipantContext* context, TransactionIntentApplier* applier,
-      const scoped_refptr<MetricEntity>& entity);
+      const scoped_refptr<MetricEntity>& entity,
+      const std::shared_ptr<MemTracker>& tablet_mem_tracker);
   virtual ~TransactionParticipant();
 
   // Adds new running transaction.
@@ -171,6 +173,8 @@ class TransactionParticipant : public TransactionStatusManager {
 
   size_t TEST_CountIntents() const;
 
+  size_t TEST_CommitTimeCacheSize() const;
+
  private:
   int64_t RegisterRequest() override;
   void UnregisterRequest(int64_t request) override;
@@ -33,6 +33,7 @@
 #include "yb/tserver/heartbeater.h"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 
@@ -48,6 +49,7 @@
 #include "yb/server/server_base.proxy.h"
 #include "yb/server/webserver.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tablet_server_options.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -192,6 +194,21 @@ class Heartbeater::Thread {
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  struct TabletOpsCounts {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+  };
+
+  // Fills the load of the given tablet in the tablet report and stores its ops counts to
+  // tablet_ops, for computing the per tablet iops in the next metrics interval.
+  void AddTabletLoad(
+      tablet::Tablet* tablet, double interval_seconds,
+      std::unordered_map<TabletId, TabletOpsCounts>* tablet_ops,
+      master::TabletReportPB* report);
+
+  // Stores the read and write ops of each tablet, as of the last metrics submission.
+  std::unordered_map<TabletId, TabletOpsCounts> prev_tablet_ops_;
+
   MonoTime start_time_;
 
   rpc::Rpcs rpcs_;
@@ -351,6 +368,36 @@ uint64_t Heartbeater::Thread::CalculateUptime() {
   return uptime_seconds;
 }
 
+void Heartbeater::Thread::AddTabletLoad(
+    tablet::Tablet* tablet, double interval_seconds,
+    std::unordered_map<TabletId, TabletOpsCounts>* tablet_ops,
+    master::TabletReportPB* report) {
+  const auto* metrics = tablet->metrics();
+  if (metrics == nullptr) {
+    return;
+  }
+  TabletOpsCounts counts;
+  counts.reads = metrics->ql_read_latency->TotalCount() +
+                 metrics->redis_read_latency->TotalCount();
+  counts.writes = metrics->write_op_duration_client_propagated_consistency->TotalCount() +
+                  metrics->write_op_duration_commit_wait_consistency->TotalCount();
+
+  auto* load = report->add_tablet_loads();
+  load->set_tablet_id(tablet->tablet_id());
+  load->set_sst_file_size(tablet->GetCurrentVersionSstFilesSize());
+  // Tablets that were not known during the previous metrics submission have no ops rate yet.
+  auto it = prev_tablet_ops_.find(tablet->tablet_id());
+  if (it != prev_tablet_ops_.end() && interval_seconds > 0) {
+    load->set_read_ops_per_sec(
+        static_cast<double>(counts.reads - std::min(counts.reads, it->second.reads)) /
+        interval_seconds);
+    load->set_write_ops_per_sec(
+        static_cast<double>(counts.writes - std::min(counts.writes, it->second.writes)) /
+        interval_seconds);
+  }
+  tablet_ops->emplace(tablet->tablet_id(), counts);
+}
+
 Status Heartbeater::Thread::TryHeartbeat() {
   master::TSHeartbeatRequestPB req;
 
@@ -389,6 +436,12 @@ Status Heartbeater::Thread::TryHeartbeat() {
     uint64_t uncompressed_file_sizes = 0;
     uint64_t num_files = 0;
     server_->tablet_manager()->GetTabletPeers(&tablet_peers);
+
+    // Used to compute the per tablet read and write ops per second.
+    MonoDelta diff = MonoTime::Now() - prev_tserver_metrics_submission_;
+    double_t div = diff.ToSeconds();
+    std::unordered_map<TabletId, TabletOpsCounts> tablet_ops;
+
     for (auto it = tablet_peers.begin(); it != tablet_peers.end(); it++) {
       shared_ptr<yb::tablet::TabletPeer> tablet_peer = *it;
       if (tablet_peer) {
@@ -398,8 +451,12 @@ Status Heartbeater::Thread::TryHeartbeat() {
         uncompressed_file_sizes += (tablet_class)
             ? tablet_class->GetCurrentVersionSstFilesUncompressedSize() : 0;
         num_files += (tablet_class) ? tablet_class->GetCurrentVersionNumSSTFiles() : 0;
+        if (tablet_class) {
+          AddTabletLoad(tablet_class.get(), div, &tablet_ops, req.mutable_tablet_report());
+        }
       }
     }
+    prev_tablet_ops_ = std::move(tablet_ops);
     req.mutable_metrics()->set_total_sst_file_size(total_file_sizes);
     req.mutable_metrics()->set_uncompressed_sst_file_size(uncompressed_file_sizes);
     req.mutable_metrics()->set_num_sst_files(num_files);
@@ -414,9 +471,6 @@ Status Heartbeater::Thread::TryHeartbeat() {
     uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
     // Calculate the read and write ops per second.
-    MonoDelta diff = MonoTime::Now() - prev_tserver_metrics_submission_;
-    double_t div = diff.ToSeconds();
-
     double rops_per_sec = (div > 0 && num_reads > 0) ?
         (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
@@ -0,0 +1,200 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/read_scheduler.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/util/countdown_latch.h"
+#include "yb/util/test_util.h"
+#include "yb/util/threadpool.h"
+
+DECLARE_int32(read_scheduler_point_read_weight);
+DECLARE_int32(read_scheduler_max_queued_reads);
+
+using namespace std::literals;
+
+namespace yb {
+namespace tserver {
+
+class ReadSchedulerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+
+    // Single thread, so the order of execution matches the order of scheduling.
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("read-sched").set_max_threads(1).Build(&pool));
+    scheduler_ = std::make_unique<ReadScheduler>(
+        std::move(pool), /* max_running_scans= */ 1, nullptr);
+  }
+
+  void TearDown() override {
+    scheduler_->Shutdown();
+    YBTest::TearDown();
+  }
+
+  // Occupies the only thread of the scheduler until blocker_release_ is counted down.
+  void Block() {
+    CountDownLatch started(1);
+    ASSERT_OK(scheduler_->Submit("blocker", ReadClass::kPoint, [this, &started](const Status&) {
+      started.CountDown();
+      blocker_release_.Wait();
+    }));
+    started.Wait();
+  }
+
+  std::unique_ptr<ReadScheduler> scheduler_;
+  CountDownLatch blocker_release_{1};
+};
+
+TEST_F(ReadSchedulerTest, FairOrder) {
+  FLAGS_read_scheduler_point_read_weight = 2;
+  Block();
+
+  std::mutex mutex;
+  std::vector<std::string> order;
+  CountDownLatch done(7);
+  auto submit = [this, &mutex, &order, &done](
+      const std::string& tablet_id, ReadClass read_class, const std::string& name) {
+    ASSERT_OK(scheduler_->Submit(
+        tablet_id, read_class, [&mutex, &order, &done, name](const Status& status) {
+      ASSERT_OK(status);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(name);
+      }
+      done.CountDown();
+    }));
+  };
+  submit("a", ReadClass::kScan, "scan-a1");
+  submit("a", ReadClass::kScan, "scan-a2");
+  submit("b", ReadClass::kScan, "scan-b1");
+  submit("a", ReadClass::kPoint, "point-a1");
+  submit("a", ReadClass::kPoint, "point-a2");
+  submit("a", ReadClass::kPoint, "point-a3");
+  submit("b", ReadClass::kPoint, "point-b1");
+
+  blocker_release_.CountDown();
+  done.Wait();
+
+  // Tablets are served round robin, with two point reads per scan.
+  std::vector<std::string> expected = {
+      "point-a1", "scan-a1", "point-b1", "point-a2", "scan-b1", "point-a3", "scan-a2" };
+  ASSERT_EQ(expected, order);
+}
+
+TEST_F(ReadSchedulerTest, QueueLimitAndShutdown) {
+  FLAGS_read_scheduler_max_queued_reads = 1;
+  Block();
+
+  Status scan_status;
+  Status point_status;
+  ASSERT_OK(scheduler_->Submit("a", ReadClass::kScan, [&scan_status](const Status& status) {
+    scan_status = status;
+  }));
+  auto status = scheduler_->Submit("b", ReadClass::kScan, [](const Status& status) {
+    FAIL() << "Rejected read should not be invoked";
+  });
+  ASSERT_TRUE(status.IsServiceUnavailable()) << status;
+
+  // Limit is applied per class.
+  ASSERT_OK(scheduler_->Submit("b", ReadClass::kPoint, [this, &point_status](const Status& status) {
+    point_status = status;
+    blocker_release_.CountDown();
+  }));
+
+  // Queued reads are aborted before waiting for the running one.
+  scheduler_->Shutdown();
+  ASSERT_TRUE(scan_status.IsServiceUnavailable()) << scan_status;
+  ASSERT_TRUE(point_status.IsServiceUnavailable()) << point_status;
+}
+
+TEST_F(ReadSchedulerTest, Deadline) {
+  Block();
+
+  Status expired_status;
+  Status alive_status;
+  ASSERT_OK(scheduler_->Submit(
+      "a", ReadClass::kPoint, [&expired_status](const Status& status) {
+    expired_status = status;
+  }, CoarseMonoClock::now() + 10ms));
+  ASSERT_OK(scheduler_->Submit(
+      "a", ReadClass::kPoint, [&alive_status](const Status& status) {
+    alive_status = status;
+  }, CoarseMonoClock::now() + 60s));
+  CountDownLatch done(1);
+  ASSERT_OK(scheduler_->Submit("a", ReadClass::kPoint, [&done](const Status&) {
+    done.CountDown();
+  }));
+
+  // Deadline of the first read passes while it is queued.
+  std::this_thread::sleep_for(50ms);
+  blocker_release_.CountDown();
+  done.Wait();
+
+  ASSERT_TRUE(expired_status.IsTimedOut()) << expired_status;
+  ASSERT_OK(alive_status);
+}
+
+TEST_F(ReadSchedulerTest, PointReadsNotBlockedByScans) {
+  std::unique_ptr<ThreadPool> pool;
+  ASSERT_OK(ThreadPoolBuilder("read-sched").set_max_threads(3).Build(&pool));
+  ReadScheduler scheduler(std::move(pool), /* max_running_scans= */ 2, nullptr);
+
+  // Scans that wait for the latch, so they occupy threads until it is counted down.
+  CountDownLatch scans_release(1);
+  CountDownLatch scans_started(2);
+  CountDownLatch scans_done(4);
+  std::atomic<int> running_scans{0};
+  std::atomic<int> max_running_scans{0};
+  for (int i = 0; i != 4; ++i) {
+    ASSERT_OK(scheduler.Submit(Format("scan-$0", i), ReadClass::kScan, [&](const Status& status) {
+      ASSERT_OK(status);
+      auto running = ++running_scans;
+      auto max_running = max_running_scans.load();
+      while (running > max_running &&
+             !max_running_scans.compare_exchange_weak(max_running, running)) {
+      }
+      scans_started.CountDown();
+      scans_release.Wait();
+      --running_scans;
+      scans_done.CountDown();
+    }));
+  }
+  scans_started.Wait();
+
+  // The thread that is not used by scans executes point reads.
+  CountDownLatch point_done(1);
+  ASSERT_OK(scheduler.Submit("point", ReadClass::kPoint, [&point_done](const Status& status) {
+    ASSERT_OK(status);
+    point_done.CountDown();
+  }));
+  ASSERT_TRUE(point_done.WaitFor(MonoDelta::FromSeconds(10)));
+
+  // Queued scans are executed by threads of completed scans.
+  scans_release.CountDown();
+  ASSERT_TRUE(scans_done.WaitFor(MonoDelta::FromSeconds(10)));
+  ASSERT_EQ(2, max_running_scans.load());
+
+  scheduler.Shutdown();
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,226 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/read_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "yb/gutil/casts.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_int32(read_scheduler_point_read_weight, 4,
+             "Number of point reads the read scheduler executes for each scan, when reads of both "
+             "classes are queued.");
+TAG_FLAG(read_scheduler_point_read_weight, advanced);
+TAG_FLAG(read_scheduler_point_read_weight, runtime);
+
+DEFINE_int32(read_scheduler_max_queued_reads, 1024,
+             "The maximum number of reads of each class that could be queued in the read "
+             "scheduler.");
+TAG_FLAG(read_scheduler_max_queued_reads, advanced);
+TAG_FLAG(read_scheduler_max_queued_reads, runtime);
+
+METRIC_DEFINE_gauge_uint64(server, read_scheduler_point_queue_length,
+                           "Read Scheduler Point Read Queue Length",
+                           yb::MetricUnit::kTasks,
+                           "Number of point reads waiting in the read scheduler.");
+
+METRIC_DEFINE_gauge_uint64(server, read_scheduler_scan_queue_length,
+                           "Read Scheduler Scan Queue Length",
+                           yb::MetricUnit::kTasks,
+                           "Number of scans waiting in the read scheduler.");
+
+METRIC_DEFINE_histogram(server, read_scheduler_point_queue_time,
+                        "Read Scheduler Point Read Queue Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Time that point reads spent waiting in the read scheduler.",
+                        10000000, 2);
+
+METRIC_DEFINE_histogram(server, read_scheduler_scan_queue_time,
+                        "Read Scheduler Scan Queue Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Time that scans spent waiting in the read scheduler.",
+                        10000000, 2);
+
+namespace yb {
+namespace tserver {
+
+ReadScheduler::ReadScheduler(std::unique_ptr<ThreadPool> pool, size_t max_running_scans,
+                             const scoped_refptr<MetricEntity>& metric_entity)
+    : pool_(std::move(pool)), max_running_scans_(std::max<size_t>(max_running_scans, 1)) {
+  if (metric_entity) {
+    auto& point_lane = lanes_[to_underlying(ReadClass::kPoint)];
+    point_lane.queue_length =
+        METRIC_read_scheduler_point_queue_length.Instantiate(metric_entity, 0);
+    point_lane.queue_time = METRIC_read_scheduler_point_queue_time.Instantiate(metric_entity);
+
+    auto& scan_lane = lanes_[to_underlying(ReadClass::kScan)];
+    scan_lane.queue_length = METRIC_read_scheduler_scan_queue_length.Instantiate(metric_entity, 0);
+    scan_lane.queue_time = METRIC_read_scheduler_scan_queue_time.Instantiate(metric_entity);
+  }
+}
+
+ReadScheduler::~ReadScheduler() {
+  Shutdown();
+}
+
+Status ReadScheduler::Submit(const std::string& tablet_id, ReadClass read_class, Task task,
+                             CoarseTimePoint deadline) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      return STATUS(ServiceUnavailable, "Read scheduler is shutting down");
+    }
+    auto& lane = lanes_[to_underlying(read_class)];
+    if (lane.size >= implicit_cast<size_t>(FLAGS_read_scheduler_max_queued_reads)) {
+      return STATUS_FORMAT(ServiceUnavailable, "Too many queued reads of class $0: $1",
+                           read_class, lane.size);
+    }
+    auto& queue = lane.tablet_queues[tablet_id];
+    if (queue.empty()) {
+      lane.active_tablets.push_back(tablet_id);
+    }
+    queue.push_back(QueuedTask{std::move(task), read_class, CoarseMonoClock::now(), deadline});
+    ++lane.size;
+    if (lane.queue_length) {
+      lane.queue_length->Increment();
+    }
+  }
+
+  // Each submitted function runs one task, so the thread pool limits the number of concurrent
+  // reads, while the order of reads is decided by PopTaskUnlocked.
+  auto status = pool_->SubmitFunc(std::bind(&ReadScheduler::RunNext, this));
+  if (!status.ok()) {
+    AbortNext(status);
+  }
+  return Status::OK();
+}
+
+void ReadScheduler::RunNext() {
+  QueuedTask task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!PopTaskUnlocked(/* limit_scans= */ true, &task)) {
+      // Only scans are queued and max_running_scans_ of them are running, so the next scan is
+      // picked by the thread of a running scan when it completes.
+      if (lanes_[to_underlying(ReadClass::kScan)].size != 0) {
+        ++deferred_runs_;
+      }
+      return;
+    }
+  }
+  for (;;) {
+    Execute(&task);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (task.read_class == ReadClass::kScan) {
+      --running_scans_;
+    }
+    if (deferred_runs_ == 0 || !PopTaskUnlocked(/* limit_scans= */ true, &task)) {
+      return;
+    }
+    --deferred_runs_;
+  }
+}
+
+void ReadScheduler::Execute(QueuedTask* task) {
+  // Client does not wait for the result anymore, so the read is dropped without executing it.
+  if (task->deadline <= CoarseMonoClock::now()) {
+    task->task(STATUS(TimedOut, "Read deadline passed while queued in the read scheduler"));
+    return;
+  }
+  task->task(Status::OK());
+}
+
+void ReadScheduler::AbortNext(const Status& status) {
+  QueuedTask task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!PopTaskUnlocked(/* limit_scans= */ false, &task)) {
+      return;
+    }
+  }
+  task.task(status);
+}
+
+bool ReadScheduler::PopTaskUnlocked(bool limit_scans, QueuedTask* task) {
+  auto& point_lane = lanes_[to_underlying(ReadClass::kPoint)];
+  auto& scan_lane = lanes_[to_underlying(ReadClass::kScan)];
+  const bool can_pick_scan =
+      scan_lane.size != 0 && (!limit_scans || running_scans_ < max_running_scans_);
+  Lane* lane;
+  if (point_lane.size != 0 &&
+      (!can_pick_scan || point_reads_in_row_ < FLAGS_read_scheduler_point_read_weight)) {
+    lane = &point_lane;
+    ++point_reads_in_row_;
+  } else if (can_pick_scan) {
+    lane = &scan_lane;
+    point_reads_in_row_ = 0;
+    if (limit_scans) {
+      ++running_scans_;
+    }
+  } else {
+    return false;
+  }
+
+  auto tablet_id = std::move(lane->active_tablets.front());
+  lane->active_tablets.pop_front();
+  auto it = lane->tablet_queues.find(tablet_id);
+  *task = std::move(it->second.front());
+  it->second.pop_front();
+  if (it->second.empty()) {
+    lane->tablet_queues.erase(it);
+  } else {
+    lane->active_tablets.push_back(std::move(tablet_id));
+  }
+
+  --lane->size;
+  if (lane->queue_length) {
+    lane->queue_length->Decrement();
+  }
+  if (lane->queue_time) {
+    lane->queue_time->Increment(ToMicroseconds(CoarseMonoClock::now() - task->enqueue_time));
+  }
+  return true;
+}
+
+void ReadScheduler::Shutdown() {
+  std::vector<QueuedTask> aborted_tasks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      return;
+    }
+    closing_ = true;
+    QueuedTask task;
+    while (PopTaskUnlocked(/* limit_scans= */ false, &task)) {
+      aborted_tasks.push_back(std::move(task));
+    }
+    deferred_runs_ = 0;
+  }
+
+  const auto status = STATUS(ServiceUnavailable, "Read scheduler is shutting down");
+  for (auto& task : aborted_tasks) {
+    task.task(status);
+  }
+
+  pool_->Shutdown();
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,128 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_READ_SCHEDULER_H
+#define YB_TSERVER_READ_SCHEDULER_H
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+class Histogram;
+class MetricEntity;
+class ThreadPool;
+
+template <class T>
+class AtomicGauge;
+
+namespace tserver {
+
+// Point reads are served from their own lane, so they are not queued behind scans.
+YB_DEFINE_ENUM(ReadClass, (kPoint)(kScan));
+
+// Executes reads on a thread pool, so a tablet with many long reads does not delay reads of other
+// tablets.
+//
+// Reads of each class are queued per tablet, and tablets are served round robin. Point reads are
+// preferred over scans, up to read_scheduler_point_read_weight point reads per scan, so scans still
+// make progress under a constant flow of point reads.
+//
+// At most max_running_scans scans run at the same time, so the remaining threads of the pool are
+// available to point reads even when long scans are queued.
+class ReadScheduler {
+ public:
+  // Invoked with OK status when the read should be executed, or with an error status when the
+  // scheduler is shut down or the deadline passes before the read was started.
+  typedef std::function<void(const Status&)> Task;
+
+  ReadScheduler(std::unique_ptr<ThreadPool> pool, size_t max_running_scans,
+                const scoped_refptr<MetricEntity>& metric_entity);
+
+  ~ReadScheduler();
+
+  // Queues the task of the specified class for the tablet.
+  // Returns ServiceUnavailable when too many reads of this class are queued, in this case the task
+  // is not invoked.
+  // If the task is picked after the deadline, it is invoked with TimedOut status.
+  CHECKED_STATUS Submit(const std::string& tablet_id, ReadClass read_class, Task task,
+                        CoarseTimePoint deadline = CoarseTimePoint::max());
+
+  // Aborts queued tasks and waits for running ones to complete.
+  void Shutdown();
+
+ private:
+  struct QueuedTask {
+    Task task;
+    ReadClass read_class;
+    CoarseTimePoint enqueue_time;
+    CoarseTimePoint deadline;
+  };
+
+  struct Lane {
+    // Queued tasks per tablet.
+    std::unordered_map<std::string, std::deque<QueuedTask>> tablet_queues;
+
+    // Tablets that have queued tasks, in the order they are served.
+    std::deque<std::string> active_tablets;
+
+    size_t size = 0;
+
+    scoped_refptr<AtomicGauge<uint64_t>> queue_length;
+    scoped_refptr<Histogram> queue_time;
+  };
+
+  void RunNext();
+
+  // Executes the task, failing it when its deadline has passed.
+  void Execute(QueuedTask* task);
+
+  // Aborts the next task, used when the thread pool does not accept more tasks.
+  void AbortNext(const Status& status);
+
+  // Picks the next task in fair order. If limit_scans is true, scans are not picked while
+  // max_running_scans_ scans are running. Returns false if there are no tasks to pick.
+  bool PopTaskUnlocked(bool limit_scans, QueuedTask* task);
+
+  std::unique_ptr<ThreadPool> pool_;
+  const size_t max_running_scans_;
+
+  std::mutex mutex_;
+  bool closing_ = false;
+  std::array<Lane, kReadClassMapSize> lanes_;
+
+  // Number of point reads picked since the last scan.
+  int point_reads_in_row_ = 0;
+
+  size_t running_scans_ = 0;
+
+  // Number of queued tasks whose thread pool functions found only scans that could not be started.
+  // Such tasks are picked by the threads of running scans when they complete.
+  size_t deferred_runs_ = 0;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_READ_SCHEDULER_H
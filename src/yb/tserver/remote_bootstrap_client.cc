@@ -32,6 +32,8 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <unordered_set>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -63,6 +65,7 @@
 #include "yb/util/net/rate_limiter.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 using namespace yb::size_literals;
 
@@ -116,6 +119,11 @@ DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 256_MB,
              "the total limit will be 2 * remote_bootstrap_rate_limit_bytes_per_sec because a "
              "tserver or master can act both as a sender and receiver at the same time.");
 
+DEFINE_int32(remote_bootstrap_max_concurrent_file_downloads, 4,
+             "Maximum number of RocksDB files downloaded concurrently by a single remote "
+             "bootstrap session. All downloads of the session share its transmission rate.");
+TAG_FLAG(remote_bootstrap_max_concurrent_file_downloads, advanced);
+
 DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
@@ -190,7 +198,17 @@ RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id,
       session_idle_timeout_millis_(0),
       start_time_micros_(0),
       succeeded_(false),
-      log_prefix_(Format("T $0 P$ 1: Remote bootstrap client: ", tablet_id_, permanent_uuid_)) {}
+      log_prefix_(Format("T $0 P$ 1: Remote bootstrap client: ", tablet_id_, permanent_uuid_)) {
+  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
+    rate_limiter_.SetTargetRateUpdater([]() {
+      if (n_started_.load(std::memory_order_acquire) < 1) {
+        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: " << n_started_;
+        return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
+      }
+      return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / n_started_);
+    });
+  }
+}
 
 RemoteBootstrapClient::~RemoteBootstrapClient() {
   // Note: Ending the remote bootstrap session releases anchors on the remote.
@@ -683,16 +701,23 @@ Status RemoteBootstrapClient::DownloadFile(
   RETURN_NOT_OK(fs_manager_->env()->CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string linked_file;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        linked_file = it->second;
+      }
+    }
+    if (!linked_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = fs_manager_->env()->LinkFile(it->second, file_path);
+                          << " => " << linked_file;
+      auto link_status = fs_manager_->env()->LinkFile(linked_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << linked_file
                              << ": " << link_status;
     }
   }
@@ -709,6 +734,7 @@ Status RemoteBootstrapClient::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
@@ -738,13 +764,21 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   DataIdPB data_id;
   data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  // Files sharing an inode with another file are hard linked to it, so they are processed after
+  // all other files are downloaded.
+  std::vector<const tablet::FilePB*> files;
+  std::vector<const tablet::FilePB*> linked_files;
+  std::unordered_set<uint64_t> inodes;
   for (auto const& file_pb : new_sb->kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
+    if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+      linked_files.push_back(&file_pb);
+    } else {
+      files.push_back(&file_pb);
+    }
+  }
+  RETURN_NOT_OK(DownloadRocksDBFilesInParallel(files, rocksdb_dir, data_id));
+  for (const auto* file_pb : linked_files) {
+    RETURN_NOT_OK(DownloadRocksDBFile(*file_pb, rocksdb_dir, data_id));
   }
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
@@ -763,6 +797,77 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
   return Status::OK();
 }
 
+Status RemoteBootstrapClient::DownloadRocksDBFile(
+    const tablet::FilePB& file_pb, const std::string& dir, DataIdPB data_id) {
+  auto start = MonoTime::Now();
+  RETURN_NOT_OK(DownloadFile(file_pb, dir, &data_id));
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  LOG_WITH_PREFIX(INFO)
+      << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
+      << " in " << elapsed.ToSeconds() << " seconds";
+  return Status::OK();
+}
+
+Status RemoteBootstrapClient::DownloadRocksDBFilesInParallel(
+    const std::vector<const tablet::FilePB*>& files, const std::string& dir,
+    const DataIdPB& data_id) {
+  const auto num_threads = std::min<size_t>(
+      files.size(), std::max(FLAGS_remote_bootstrap_max_concurrent_file_downloads, 1));
+  if (num_threads <= 1) {
+    for (const auto* file_pb : files) {
+      RETURN_NOT_OK(DownloadRocksDBFile(*file_pb, dir, data_id));
+    }
+    return Status::OK();
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Downloading " << files.size() << " RocksDB files using "
+                        << num_threads << " threads";
+
+  std::unique_ptr<ThreadPool> pool;
+  RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                    .set_min_threads(0)
+                    .set_max_threads(num_threads)
+                    .Build(&pool));
+
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+  std::mutex result_mutex;
+  Status result;
+  auto set_failure = [&failed, &result_mutex, &result](const Status& status) {
+    std::lock_guard<std::mutex> lock(result_mutex);
+    if (result.ok()) {
+      result = status;
+    }
+    failed.store(true, std::memory_order_release);
+  };
+
+  // Each worker takes the next file until all files are downloaded or one of them fails.
+  auto worker = [this, &files, &dir, &data_id, &next_file, &failed, &set_failure]() {
+    while (!failed.load(std::memory_order_acquire)) {
+      auto idx = next_file.fetch_add(1, std::memory_order_acq_rel);
+      if (idx >= files.size()) {
+        break;
+      }
+      auto status = DownloadRocksDBFile(*files[idx], dir, data_id);
+      if (!status.ok()) {
+        set_failure(status);
+      }
+    }
+  };
+
+  for (size_t i = 0; i != num_threads; ++i) {
+    auto status = pool->SubmitFunc(worker);
+    if (!status.ok()) {
+      set_failure(status);
+      break;
+    }
+  }
+  pool->Wait();
+  pool->Shutdown();
+
+  return result;
+}
+
 Status RemoteBootstrapClient::DownloadWAL(uint64_t wal_segment_seqno) {
   VLOG_WITH_PREFIX(1) << "Downloading WAL segment with seqno " << wal_segment_seqno;
   DataIdPB data_id;
@@ -833,23 +938,6 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
   int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
                                 FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
 
-  std::unique_ptr<RateLimiter> rate_limiter;
-
-  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
-      if (n_started_.load(std::memory_order_acquire) < 1) {
-        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: " << n_started_;
-        return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
-      }
-      return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / n_started_);
-    };
-
-    rate_limiter = std::make_unique<RateLimiter>(rate_updater);
-  } else {
-    // Inactive RateLimiter.
-    rate_limiter = std::make_unique<RateLimiter>();
-  }
-
   rpc::RpcController controller;
   controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
   FetchDataRequestPB req;
@@ -860,20 +948,30 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
     req.set_session_id(session_id_);
     req.mutable_data_id()->CopyFrom(data_id);
     req.set_offset(offset);
-    if (rate_limiter->active()) {
-      auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
-      if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
-        max_size = std::numeric_limits<decltype(max_length)>::max();
+    {
+      std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+      if (!rate_limiter_.IsInitialized()) {
+        rate_limiter_.Init();
+      }
+      if (rate_limiter_.active()) {
+        auto max_size = rate_limiter_.GetMaxSizeForNextTransmission();
+        if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
+          max_size = std::numeric_limits<decltype(max_length)>::max();
+        }
+        max_length = std::min(max_length, decltype(max_length)(max_size));
       }
-      max_length = std::min(max_length, decltype(max_length)(max_size));
     }
     req.set_max_length(max_length);
 
     FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
+    auto status = proxy_->FetchData(req, &resp, &controller);
     RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
+    {
+      // Sleeping under the lock is intended, it throttles all concurrent downloads of this
+      // session.
+      std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+      rate_limiter_.UpdateDataSizeAndMaybeSleep(resp.ByteSize());
+    }
     DCHECK_LE(resp.chunk().data().size(), max_length);
 
     // Sanity-check for corruption.
@@ -898,7 +996,10 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
     }
   }
 
-  VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter->GetRate();
+  if (VLOG_IS_ON(2)) {
+    std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+    VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter_.GetRate();
+  }
 
   return Status::OK();
 }
@@ -35,6 +35,7 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -44,8 +45,10 @@
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
+#include "yb/gutil/thread_annotations.h"
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/tserver/remote_bootstrap.pb.h"
+#include "yb/util/net/rate_limiter.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -77,8 +80,8 @@ class TSTabletManager;
 // Client class for using remote bootstrap to copy a tablet from another host.
 // This class is not thread-safe.
 //
-// TODO:
-// * Parallelize download of blocks and WAL segments.
+// RocksDB files are downloaded in parallel, up to remote_bootstrap_max_concurrent_file_downloads
+// at a time. WAL segments are downloaded sequentially, since the remote side serves them in order.
 //
 class RemoteBootstrapClient {
  public:
@@ -137,6 +140,7 @@ class RemoteBootstrapClient {
  protected:
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestBeginEndSession);
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesSequentially);
 
   // Update the bootstrap StatusListener with a message.
   // The string "RemoteBootstrap: " will be prepended to each message.
@@ -168,6 +172,17 @@ class RemoteBootstrapClient {
 
   CHECKED_STATUS DownloadRocksDBFiles();
 
+  // Download a single RocksDB file, logging the time it took.
+  CHECKED_STATUS DownloadRocksDBFile(
+      const tablet::FilePB& file_pb, const std::string& dir, DataIdPB data_id);
+
+  // Download specified RocksDB files using up to remote_bootstrap_max_concurrent_file_downloads
+  // threads. Files should have distinct inodes, since hard links are resolved against files that
+  // were already downloaded.
+  CHECKED_STATUS DownloadRocksDBFilesInParallel(
+      const std::vector<const tablet::FilePB*>& files, const std::string& dir,
+      const DataIdPB& data_id);
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
   CHECKED_STATUS DownloadFile(
@@ -228,7 +243,13 @@ class RemoteBootstrapClient {
   const std::string log_prefix_;
 
  private:
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  std::mutex inode2file_mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_ GUARDED_BY(inode2file_mutex_);
+
+  // Limits the transmission rate of all files downloaded by this session, including the ones
+  // downloaded concurrently.
+  std::mutex rate_limiter_mutex_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   DISALLOW_COPY_AND_ASSIGN(RemoteBootstrapClient);
 };
@@ -16,6 +16,8 @@
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
 
+DECLARE_int32(remote_bootstrap_max_concurrent_file_downloads);
+
 using std::shared_ptr;
 
 namespace yb {
@@ -33,6 +35,40 @@ class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
   void SetUp() override {
     RemoteBootstrapClientTest::SetUp();
   }
+
+  // Verify that the client has the same files that the leader has.
+  void CheckDownloadedRocksDBFiles() {
+    auto tablet_peer_checkpoint_dir =
+        tablet_peer_->tablet()->TEST_LastRocksDBCheckpointDir();
+
+    vector<std::string> rocksdb_files;
+    ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
+
+    vector<std::string> tablet_peer_checkpoint_files;
+    ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(
+        tablet_peer_checkpoint_dir, &tablet_peer_checkpoint_files));
+
+    ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size());
+    std::sort(rocksdb_files.begin(), rocksdb_files.end());
+    std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
+    for (int i = 0; i < rocksdb_files.size(); ++i) {
+      auto local_rocksdb_file = rocksdb_files[i];
+      auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
+      ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+
+      if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
+        continue;
+      }
+
+      auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
+      auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
+                                                            tablet_peer_rocksdb_file);
+
+      LOG(INFO) << "Comparing file " << local_rocksdb_file_path
+                << " and file " << tablet_peer_rocksdb_file_path;
+      ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
+    }
+  }
 };
 
 // Basic begin / end remote bootstrap session.
@@ -46,37 +82,14 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
 TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   TabletStatusListener listener(meta_);
   ASSERT_OK(client_->DownloadRocksDBFiles());
-  auto tablet_peer_checkpoint_dir =
-      tablet_peer_->tablet()->TEST_LastRocksDBCheckpointDir();
-
-  vector<std::string> rocksdb_files;
-  ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
-
-  vector<std::string> tablet_peer_checkpoint_files;
-  ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(tablet_peer_checkpoint_dir,
-                                                                   &tablet_peer_checkpoint_files));
-
-  ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size());
-  std::sort(rocksdb_files.begin(), rocksdb_files.end());
-  std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-  // Verify that the client has the same files that the leader has.
-  for (int i = 0; i < rocksdb_files.size(); ++i) {
-    auto local_rocksdb_file = rocksdb_files[i];
-    auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
-    ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
-
-    if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
-      continue;
-    }
-
-    auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
-    auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
-                                                          tablet_peer_rocksdb_file);
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
+}
 
-    LOG(INFO) << "Comparing file " << local_rocksdb_file_path
-              << " and file " << tablet_peer_rocksdb_file_path;
-    ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
-  }
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesSequentially) {
+  FLAGS_remote_bootstrap_max_concurrent_file_downloads = 1;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
 }
 
 } // namespace tserver
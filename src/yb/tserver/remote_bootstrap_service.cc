@@ -287,8 +287,8 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   MAYBE_FAULT(FLAGS_fault_crash_on_handle_rb_fetch_data);
 
   uint64_t offset = req->offset();
-  VLOG(3) << " rate limiter max len: "  << session->rate_limiter().GetMaxSizeForNextTransmission();
-  auto rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  auto rate_limit = session->GetMaxSizeForNextTransmission();
+  VLOG(3) << " rate limiter max len: "  << rate_limit;
   int64_t client_maxlen = rate_limit == 0
       ? req->max_length() : std::min(static_cast<uint64_t>(req->max_length()), rate_limit);
   const DataIdPB& data_id = req->data_id();
@@ -304,7 +304,7 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
                     error_code, "Unable to get piece of data file");
 
   data_chunk->set_total_data_length(total_data_length);
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(data->size());
+  session->UpdateDataSizeAndMaybeSleep(data->size());
   data_chunk->set_offset(offset);
 
   // Calculate checksum.
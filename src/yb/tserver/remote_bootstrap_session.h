@@ -128,11 +128,12 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Change the peer's role to VOTER.
   CHECKED_STATUS ChangeRole();
 
-  void InitRateLimiter();
-
   void EnsureRateLimiterIsInitialized();
 
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Rate limiter wrappers, the client could fetch several files of the same session concurrently.
+  uint64_t GetMaxSizeForNextTransmission();
+
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -189,13 +190,16 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   MonoTime start_time_;
 
   // Used to limit the transmission rate.
-  RateLimiter rate_limiter_;
+  std::mutex rate_limiter_mutex_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
   const std::atomic<int>* nsessions_;
 
  private:
+  void InitRateLimiter() REQUIRES(rate_limiter_mutex_);
+
   DISALLOW_COPY_AND_ASSIGN(RemoteBootstrapSession);
 };
 
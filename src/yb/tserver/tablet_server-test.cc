@@ -30,9 +30,13 @@
 // under the License.
 //
 
+#include "yb/consensus/consensus.proxy.h"
 #include "yb/consensus/log-test-base.h"
+#include "yb/consensus/multi_raft_batcher.h"
 
+#include "yb/common/ql_rowblock.h"
 #include "yb/common/ql_value.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/gutil/strings/escaping.h"
 #include "yb/gutil/strings/substitute.h"
@@ -54,6 +58,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_admin.proxy.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/curl_util.h"
 #include "yb/util/url-coding.h"
@@ -84,11 +89,18 @@ DECLARE_int32(metrics_retirement_age_ms);
 DECLARE_string(block_manager);
 DECLARE_string(rpc_bind_addresses);
 DECLARE_bool(disable_clock_sync_error);
+DECLARE_bool(TEST_reject_multi_raft_update_consensus);
+DECLARE_bool(TEST_fail_multi_raft_update_consensus);
+DECLARE_bool(enable_read_scheduler);
 
 // Declare these metrics prototypes for simpler unit testing of their behavior.
 METRIC_DECLARE_counter(rows_inserted);
 METRIC_DECLARE_counter(rows_updated);
 METRIC_DECLARE_counter(rows_deleted);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_UpdateConsensus);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus);
+METRIC_DECLARE_histogram(read_scheduler_point_queue_time);
+METRIC_DECLARE_histogram(read_scheduler_scan_queue_time);
 
 namespace yb {
 namespace tserver {
@@ -639,6 +651,205 @@ TEST_F(TabletServerTest, TestDeleteTablet_TabletNotCreated) {
   }
 }
 
+// Test that failures of requests in a multi Raft batch are reported per request.
+TEST_F(TabletServerTest, TestMultiRaftUpdateConsensusErrors) {
+  consensus::MultiRaftConsensusRequestPB req;
+  consensus::MultiRaftConsensusResponsePB resp;
+  RpcController rpc;
+
+  auto* not_found_req = req.add_consensus_request();
+  not_found_req->set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+  not_found_req->set_tablet_id("NotPresentTabletId");
+  not_found_req->set_caller_uuid("FakeLeaderUuid");
+  not_found_req->set_caller_term(1);
+
+  auto* wrong_uuid_req = req.add_consensus_request();
+  wrong_uuid_req->CopyFrom(*not_found_req);
+  wrong_uuid_req->set_dest_uuid("WrongUuid");
+  wrong_uuid_req->set_tablet_id(kTabletId);
+
+  SCOPED_TRACE(req.DebugString());
+  ASSERT_OK(consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &rpc));
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_EQ(2, resp.consensus_response_size());
+  ASSERT_TRUE(resp.consensus_response(0).has_error());
+  ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, resp.consensus_response(0).error().code());
+  ASSERT_TRUE(resp.consensus_response(1).has_error());
+  ASSERT_EQ(TabletServerErrorPB::WRONG_SERVER_UUID, resp.consensus_response(1).error().code());
+}
+
+// Test that heartbeats added to the batcher are sent in a single RPC, that every peer gets the
+// response to its own request through its own callback, that requests are resent individually
+// when the remote server does not support the batch RPC, and that other failures of the batch RPC
+// are reported to every request.
+TEST_F(TabletServerTest, TestMultiRaftHeartbeatBatcher) {
+  const auto& metric_entity = mini_server_->server()->metric_entity();
+  auto single_hist =
+      METRIC_handler_latency_yb_consensus_ConsensusService_UpdateConsensus.Instantiate(
+          metric_entity);
+  auto multi_hist =
+      METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus.Instantiate(
+          metric_entity);
+
+  consensus::MultiRaftManager manager(client_messenger_.get(), proxy_cache_.get());
+  auto hostport = HostPort::FromBoundEndpoint(mini_server_->bound_rpc_addr());
+  auto batcher = manager.AddOrGetBatcher(hostport);
+  ASSERT_EQ(batcher, manager.AddOrGetBatcher(hostport));
+
+  struct PeerCall {
+    consensus::ConsensusRequestPB request;
+    consensus::ConsensusResponsePB response;
+    RpcController controller;
+    int num_callbacks = 0;
+  };
+
+  // Sends heartbeats through the batcher. If batch_error is set, the batch RPC is expected to fail
+  // with it, otherwise each heartbeat gets its own response.
+  auto send_heartbeats = [this, &batcher](bool batch_error) {
+    std::vector<PeerCall> calls(2);
+    calls[0].request.set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+    calls[0].request.set_tablet_id("NotPresentTabletId");
+    calls[1].request.set_dest_uuid("WrongUuid");
+    calls[1].request.set_tablet_id(kTabletId);
+    for (auto& call : calls) {
+      call.request.set_caller_uuid("FakeLeaderUuid");
+      call.request.set_caller_term(1);
+    }
+
+    CountDownLatch latch(calls.size());
+    for (auto& call : calls) {
+      batcher->AddRequestToBatch(
+          &call.request, &call.response, &call.controller, [&call, &latch] {
+        ++call.num_callbacks;
+        latch.CountDown();
+      });
+    }
+    ASSERT_TRUE(latch.WaitFor(MonoDelta::FromSeconds(30)));
+
+    for (auto& call : calls) {
+      SCOPED_TRACE(call.response.ShortDebugString());
+      ASSERT_EQ(1, call.num_callbacks);
+      // Requests are not changed by the batcher.
+      ASSERT_EQ("FakeLeaderUuid", call.request.caller_uuid());
+      if (batch_error) {
+        auto status = call.controller.status();
+        ASSERT_TRUE(status.IsRemoteError()) << status;
+        ASSERT_STR_CONTAINS(status.ToString(), "failed by test flag");
+        continue;
+      }
+      ASSERT_OK(call.controller.status());
+      ASSERT_TRUE(call.response.has_error());
+    }
+    if (batch_error) {
+      return;
+    }
+    ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, calls[0].response.error().code());
+    ASSERT_EQ(TabletServerErrorPB::WRONG_SERVER_UUID, calls[1].response.error().code());
+  };
+
+  // Handler latency is recorded after the response is sent, so wait for it.
+  auto wait_rpc_counts = [&multi_hist, &single_hist](uint64_t multi, uint64_t single) {
+    return WaitFor([&multi_hist, &single_hist, multi, single] {
+      return multi_hist->TotalCount() == multi && single_hist->TotalCount() == single;
+    }, MonoDelta::FromSeconds(10), Format("$0 batch and $1 individual RPCs", multi, single));
+  };
+
+  ASSERT_NO_FATALS(send_heartbeats(false));
+  ASSERT_OK(wait_rpc_counts(1, 0));
+
+  // Server that does not support batches fails the RPC, so heartbeats are sent individually.
+  FLAGS_TEST_reject_multi_raft_update_consensus = true;
+  ASSERT_NO_FATALS(send_heartbeats(false));
+  ASSERT_OK(wait_rpc_counts(2, 2));
+  FLAGS_TEST_reject_multi_raft_update_consensus = false;
+
+  // Other failures are reported to every heartbeat without resending it.
+  FLAGS_TEST_fail_multi_raft_update_consensus = true;
+  ASSERT_NO_FATALS(send_heartbeats(true));
+  ASSERT_OK(wait_rpc_counts(3, 2));
+  FLAGS_TEST_fail_multi_raft_update_consensus = false;
+
+  // Batcher is removed from the manager after its last user is gone.
+  std::weak_ptr<consensus::MultiRaftHeartbeatBatcher> weak_batcher = batcher;
+  batcher.reset();
+  ASSERT_OK(WaitFor([&weak_batcher] { return weak_batcher.expired(); }, MonoDelta::FromSeconds(10),
+                    "Batcher destroyed"));
+  ASSERT_EQ(1, manager.TEST_NumBatchers());
+  auto other_batcher = manager.AddOrGetBatcher(HostPort("127.0.0.2", hostport.port()));
+  ASSERT_EQ(1, manager.TEST_NumBatchers());
+}
+
+// Test that reads executed by the read scheduler return the same rows, and that only reads of the
+// full primary key are classified as point reads.
+TEST_F(TabletServerTest, TestReadScheduler) {
+  {
+    WriteRequestPB req;
+    WriteResponsePB resp;
+    RpcController controller;
+    req.set_tablet_id(kTabletId);
+    for (int32_t key : {1, 2, 3}) {
+      AddTestRowInsert(key, key * 10, Format("value $0", key), &req);
+    }
+    SCOPED_TRACE(req.DebugString());
+    ASSERT_OK(proxy_->Write(req, &resp, &controller));
+    SCOPED_TRACE(resp.DebugString());
+    ASSERT_FALSE(resp.has_error());
+  }
+
+  FLAGS_enable_read_scheduler = true;
+
+  const auto& metric_entity = mini_server_->server()->metric_entity();
+  auto point_hist = METRIC_read_scheduler_point_queue_time.Instantiate(metric_entity);
+  auto scan_hist = METRIC_read_scheduler_scan_queue_time.Instantiate(metric_entity);
+
+  // Reads all columns, of the specified key if any. Returns the number of read rows.
+  auto read = [this](boost::optional<int32_t> key) -> Result<size_t> {
+    ReadRequestPB req;
+    ReadResponsePB resp;
+    RpcController controller;
+    controller.set_timeout(MonoDelta::FromSeconds(10));
+    req.set_tablet_id(kTabletId);
+    req.set_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+    auto* ql_req = req.add_ql_batch();
+    ql_req->set_schema_version(0);
+    if (key) {
+      std::string hash_key;
+      YBPartition::AppendIntToKey<int32_t, uint32_t>(*key, &hash_key);
+      ql_req->set_hash_code(YBPartition::HashColumnCompoundValue(hash_key));
+      ql_req->add_hashed_column_values()->mutable_value()->set_int32_value(*key);
+    }
+    auto* rsrow = ql_req->mutable_rsrow_desc();
+    int id = kFirstColumnId;
+    for (const auto& col : schema_.columns()) {
+      ql_req->add_selected_exprs()->set_column_id(id);
+      ql_req->mutable_column_refs()->add_ids(id);
+      auto* coldesc = rsrow->add_rscol_descs();
+      coldesc->set_name(col.name());
+      col.type()->ToQLTypePB(coldesc->mutable_ql_type());
+      ++id;
+    }
+
+    RETURN_NOT_OK(proxy_->Read(req, &resp, &controller));
+    if (resp.has_error()) {
+      return StatusFromPB(resp.error().status());
+    }
+    QLRowBlock result(schema_);
+    Slice data = VERIFY_RESULT(controller.GetSidecar(0));
+    if (!data.empty()) {
+      RETURN_NOT_OK(result.Deserialize(QLClient::YQL_CLIENT_CQL, &data));
+    }
+    return result.row_count();
+  };
+
+  ASSERT_EQ(3, ASSERT_RESULT(read(boost::none)));
+  ASSERT_EQ(1, scan_hist->TotalCount());
+  ASSERT_EQ(0, point_hist->TotalCount());
+
+  ASSERT_EQ(1, ASSERT_RESULT(read(2)));
+  ASSERT_EQ(1, scan_hist->TotalCount());
+  ASSERT_EQ(1, point_hist->TotalCount());
+}
+
 // Test that with concurrent requests to delete the same tablet, one wins and
 // the other fails, with no assertion failures. Regression test for KUDU-345.
 TEST_F(TabletServerTest, TestConcurrentDeleteTablet) {
@@ -33,6 +33,7 @@
 #include "yb/tserver/tablet_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -65,10 +66,12 @@
 #include "yb/tablet/tablet_metrics.h"
 
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 
+#include "yb/tserver/read_scheduler.h"
 #include "yb/tserver/remote_bootstrap_service.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -132,6 +135,15 @@ DEFINE_int32(max_wait_for_safe_time_ms, 5000,
 
 DEFINE_test_flag(bool, tserver_noop_read_write, false, "Respond NOOP to read/write.");
 
+DEFINE_test_flag(bool, TEST_reject_tablet_split, false,
+                 "Reject tablet split requests before the split is replicated.");
+
+DEFINE_test_flag(bool, TEST_reject_multi_raft_update_consensus, false,
+                 "Fail MultiRaftUpdateConsensus requests, as a server that does not support them.");
+
+DEFINE_test_flag(bool, TEST_fail_multi_raft_update_consensus, false,
+                 "Fail MultiRaftUpdateConsensus requests with a service unavailable error.");
+
 DEFINE_int32(max_stale_read_bound_time_ms, 0, "If we are allowed to read from followers, "
              "specify the maximum time a follower can be behind by using the last message received "
              "from the leader. If set to zero, a read can be served by a follower regardless of "
@@ -177,6 +189,12 @@ DEFINE_test_flag(double, respond_write_failed_probability, 0.0,
 
 DEFINE_test_flag(bool, rpc_delete_tablet_fail, false, "Should delete tablet RPC fail.");
 
+DEFINE_bool(enable_read_scheduler, false,
+            "Whether reads should be executed by the read scheduler, that serves tablets in fair "
+            "order and executes point reads ahead of scans, instead of the RPC service thread.");
+TAG_FLAG(enable_read_scheduler, advanced);
+TAG_FLAG(enable_read_scheduler, runtime);
+
 DECLARE_uint64(max_clock_skew_usec);
 
 namespace yb {
@@ -248,6 +266,40 @@ Status GetTabletRef(const TabletPeerPtr& tablet_peer,
   return Status::OK();
 }
 
+// Tablet that was split does not contain actual data anymore, so requests to it should be
+// rejected. The client refreshes its tablet locations when receiving TABLET_SPLIT.
+Status CheckTabletNotSplit(const TabletPeer& tablet_peer) {
+  auto tablet = tablet_peer.shared_tablet();
+  if (PREDICT_FALSE(tablet && tablet->IsSplitDone())) {
+    return STATUS(
+        IllegalState, Format("Tablet $0 was split", tablet_peer.tablet_id()), Slice(),
+        TabletServerError(TabletServerErrorPB::TABLET_SPLIT));
+  }
+  return Status::OK();
+}
+
+Status ValidateSplitRequest(const tablet::RaftGroupMetadata& metadata,
+                            const SplitTabletRequestPB& req) {
+  if (PREDICT_FALSE(FLAGS_TEST_reject_tablet_split)) {
+    return STATUS(IllegalState, "Tablet split rejected by test flag");
+  }
+  if (!metadata.partition_schema().IsHashPartitioning()) {
+    return STATUS(NotSupported, "Only tablets of hash partitioned tables could be split");
+  }
+  const auto& partition = metadata.partition();
+  if (req.split_encoded_key().empty() ||
+      req.split_partition_key() <= partition.partition_key_start() ||
+      (!partition.partition_key_end().empty() &&
+       req.split_partition_key() >= partition.partition_key_end())) {
+    return STATUS_FORMAT(
+        InvalidArgument, "Split key $0 is out of partition [$1, $2)",
+        Slice(req.split_partition_key()).ToDebugHexString(),
+        Slice(partition.partition_key_start()).ToDebugHexString(),
+        Slice(partition.partition_key_end()).ToDebugHexString());
+  }
+  return Status::OK();
+}
+
 // overlimit - we have 2 bounds, value and random score.
 // overlimit is calculated as:
 // score + (value - lower_bound) / (upper_bound - lower_bound).
@@ -822,6 +874,86 @@ void TabletServiceAdminImpl::CountIntents(
   context.RespondSuccess();
 }
 
+void TabletServiceAdminImpl::GetSplitKey(const GetSplitKeyRequestPB* req,
+                                         GetSplitKeyResponsePB* resp,
+                                         rpc::RpcContext context) {
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "GetSplitKey", req, resp, &context)) {
+    return;
+  }
+  TRACE_EVENT1("tserver", "GetSplitKey", "tablet_id", req->tablet_id());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  RETURN_UNKNOWN_ERROR_IF_NOT_OK(
+      tablet.peer->tablet()->GetSplitKey(
+          resp->mutable_split_partition_key(), resp->mutable_split_encoded_key()),
+      resp, &context);
+  context.RespondSuccess();
+}
+
+void TabletServiceAdminImpl::SplitTablet(const SplitTabletRequestPB* req,
+                                         SplitTabletResponsePB* resp,
+                                         rpc::RpcContext context) {
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "SplitTablet", req, resp, &context)) {
+    return;
+  }
+  TRACE_EVENT1("tserver", "SplitTablet", "tablet_id", req->tablet_id());
+
+  server::UpdateClock(*req, server_->Clock());
+
+  LOG(INFO) << "T " << req->tablet_id() << " P " << server_->permanent_uuid()
+            << ": Processing SplitTablet from " << context.requestor_string() << ": "
+            << req->ShortDebugString();
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  // The master could resend the request, when the response to the previous one was lost.
+  const auto split_child_tablet_ids = tablet.peer->tablet_metadata()->split_child_tablet_ids();
+  if (split_child_tablet_ids ==
+          std::vector<TabletId>{req->new_tablet1_id(), req->new_tablet2_id()}) {
+    context.RespondSuccess();
+    return;
+  }
+  auto split_status = CheckTabletNotSplit(*tablet.peer);
+  if (!split_status.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), split_status, &context);
+    return;
+  }
+  if (tablet.peer->tablet()->IsSplitStarted()) {
+    SetupErrorAndRespond(
+        resp->mutable_error(), STATUS(IllegalState, "Tablet split is already in progress"),
+        TabletServerErrorPB::ALREADY_IN_PROGRESS, &context);
+    return;
+  }
+  // The master rolls back the split rejected with TABLET_SPLIT_REJECTED, so it is only used
+  // before the split operation is submitted.
+  split_status = ValidateSplitRequest(*tablet.peer->tablet_metadata(), *req);
+  if (!split_status.ok()) {
+    SetupErrorAndRespond(
+        resp->mutable_error(), split_status, TabletServerErrorPB::TABLET_SPLIT_REJECTED,
+        &context);
+    return;
+  }
+
+  auto state = std::make_unique<tablet::SplitOperationState>(
+      tablet.peer->tablet(), server_->tablet_manager(), req);
+
+  state->set_completion_callback(
+      MakeRpcOperationCompletionCallback(std::move(context), resp, server_->Clock()));
+
+  // Submit the split tablet op. The RPC will be responded to asynchronously.
+  tablet.peer->Submit(
+      std::make_unique<tablet::SplitOperation>(std::move(state)), tablet.leader_term);
+}
+
 void TabletServiceImpl::Write(const WriteRequestPB* req,
                               WriteResponsePB* resp,
                               rpc::RpcContext context) {
@@ -846,6 +978,12 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
     return;
   }
 
+  auto split_status = CheckTabletNotSplit(*tablet.peer);
+  if (PREDICT_FALSE(!split_status.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), split_status, &context);
+    return;
+  }
+
 #if defined(DUMP_WRITE)
   if (req->has_write_batch() && req->write_batch().has_transaction()) {
     VLOG(1) << "Write with transaction: " << req->write_batch().transaction().ShortDebugString();
@@ -940,7 +1078,7 @@ Status TabletServiceImpl::CheckPeerIsReady(const TabletPeer& tablet_peer) {
   if (!s.ok()) {
     return s.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
   }
-  return Status::OK();
+  return CheckTabletNotSplit(tablet_peer);
 }
 
 Status TabletServiceImpl::CheckPeerIsLeader(const TabletPeer& tablet_peer) {
@@ -1175,6 +1313,70 @@ class ReadOperationCompletionCallback : public OperationCompletionCallback {
   std::shared_ptr<rpc::RpcContext> context_;
 };
 
+// Read with the state it needs while it is queued in the read scheduler.
+struct ScheduledRead {
+  ReadContext read_context;
+  HostPortPB host_port_pb;
+  std::shared_ptr<rpc::RpcContext> context;
+};
+
+namespace {
+
+// Schema of the table that the request reads, or null if the table is unknown.
+const Schema* TableSchema(const tablet::RaftGroupMetadata& metadata, const TableId& table_id) {
+  auto table_info = metadata.GetTableInfo(table_id);
+  return table_info.ok() ? &(**table_info).schema : nullptr;
+}
+
+// Point reads return at most one row: they specify the full primary key or are limited to a single
+// row. Other reads could scan many rows.
+bool IsPointRead(const ReadRequestPB& req, const tablet::RaftGroupMetadata& metadata) {
+  for (const auto& redis_req : req.redis_batch()) {
+    if (redis_req.has_keys_request() || redis_req.has_get_collection_range_request()) {
+      return false;
+    }
+  }
+  for (const auto& ql_req : req.ql_batch()) {
+    if (ql_req.has_paging_state()) {
+      return false;
+    }
+    if (ql_req.has_limit() && ql_req.limit() <= 1) {
+      continue;
+    }
+    // Conditions on range columns are part of the where expression, so the full key is recognized
+    // only for tables without range columns.
+    auto schema = TableSchema(metadata, std::string());
+    if (!schema || schema->num_range_key_columns() != 0 ||
+        implicit_cast<size_t>(ql_req.hashed_column_values().size()) !=
+            schema->num_hash_key_columns()) {
+      return false;
+    }
+  }
+  for (const auto& pgsql_req : req.pgsql_batch()) {
+    if (pgsql_req.has_paging_state()) {
+      return false;
+    }
+    if ((pgsql_req.has_limit() && pgsql_req.limit() <= 1) ||
+        (pgsql_req.has_ybctid_column_value() && !pgsql_req.has_index_request())) {
+      continue;
+    }
+    if (pgsql_req.has_index_request()) {
+      return false;
+    }
+    auto schema = TableSchema(metadata, pgsql_req.table_id());
+    if (!schema ||
+        implicit_cast<size_t>(pgsql_req.partition_column_values().size()) !=
+            schema->num_hash_key_columns() ||
+        implicit_cast<size_t>(pgsql_req.range_column_values().size()) !=
+            schema->num_range_key_columns()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 void TabletServiceImpl::Read(const ReadRequestPB* req,
                              ReadResponsePB* resp,
                              rpc::RpcContext context) {
@@ -1358,6 +1560,33 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     return;
   }
 
+  if (FLAGS_enable_read_scheduler) {
+    auto scheduled_read = std::make_shared<ScheduledRead>(ScheduledRead{
+        std::move(read_context), host_port_pb, std::make_shared<RpcContext>(std::move(context))});
+    scheduled_read->read_context.context = scheduled_read->context.get();
+    scheduled_read->read_context.host_port_pb = &scheduled_read->host_port_pb;
+    const auto& metadata = *down_cast<Tablet*>(
+        scheduled_read->read_context.tablet.get())->metadata();
+    // Reads that are still queued after the deadline are failed by the scheduler with TimedOut
+    // status, so they do not take a thread when nobody waits for them.
+    // Reads that the scheduler rejects or fails are reported as server too busy, so the client
+    // retries them with backoff.
+    auto status = server_->tablet_manager()->read_scheduler()->Submit(
+        req->tablet_id(), IsPointRead(*req, metadata) ? ReadClass::kPoint : ReadClass::kScan,
+        [this, scheduled_read](const Status& status) {
+      if (!status.ok()) {
+        scheduled_read->context->RespondRpcFailure(
+            rpc::ErrorStatusPB::ERROR_SERVER_TOO_BUSY, status);
+        return;
+      }
+      CompleteRead(&scheduled_read->read_context);
+    }, scheduled_read->context->GetClientDeadline());
+    if (!status.ok()) {
+      scheduled_read->context->RespondRpcFailure(rpc::ErrorStatusPB::ERROR_SERVER_TOO_BUSY, status);
+    }
+    return;
+  }
+
   CompleteRead(&read_context);
 }
 
@@ -1574,9 +1803,11 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
 }
 
 ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& metric_entity,
-                                           TabletPeerLookupIf* tablet_manager)
+                                           TabletPeerLookupIf* tablet_manager,
+                                           ThreadPool* multi_raft_pool)
     : ConsensusServiceIf(metric_entity),
-      tablet_manager_(tablet_manager) {
+      tablet_manager_(tablet_manager),
+      multi_raft_pool_(multi_raft_pool) {
 }
 
 ConsensusServiceImpl::~ConsensusServiceImpl() {
@@ -1586,32 +1817,145 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
                                            ConsensusResponsePB* resp,
                                            rpc::RpcContext context) {
   DVLOG(3) << "Received Consensus Update RPC: " << req->ShortDebugString();
-  if (!CheckUuidMatchOrRespond(tablet_manager_, "UpdateConsensus", req, resp, &context)) {
-    return;
-  }
-  auto tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
-      tablet_manager_, req->tablet_id(), resp, &context));
-
-  // Submit the update directly to the TabletPeer's Consensus instance.
-  shared_ptr<Consensus> consensus;
-  if (!GetConsensusOrRespond(tablet_peer, resp, &context, &consensus)) return;
-
+  auto error_code = TabletServerErrorPB::UNKNOWN_ERROR;
   // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
   // gives us a const request, but we need to be able to move messages out of the request for
   // efficiency.
-  Status s = consensus->Update(
-      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline());
-  if (PREDICT_FALSE(!s.ok())) {
+  auto status = DoUpdateConsensus(
+      "UpdateConsensus", const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline(),
+      &error_code);
+  if (PREDICT_FALSE(!status.ok())) {
     // Clear the response first, since a partially-filled response could
     // result in confusing a caller, or in having missing required fields
     // in embedded optional messages.
     resp->Clear();
+    SetupErrorAndRespond(resp->mutable_error(), status, error_code, &context);
+    return;
+  }
+  context.RespondSuccess();
+}
 
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::UNKNOWN_ERROR,
-                         &context);
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Multi Raft Consensus Update RPC: " << req->ShortDebugString();
+  if (PREDICT_FALSE(FLAGS_TEST_reject_multi_raft_update_consensus)) {
+    context.RespondRpcFailure(
+        rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD,
+        STATUS(NotSupported, "MultiRaftUpdateConsensus rejected by test flag"));
     return;
   }
+  if (PREDICT_FALSE(FLAGS_TEST_fail_multi_raft_update_consensus)) {
+    context.RespondFailure(
+        STATUS(ServiceUnavailable, "MultiRaftUpdateConsensus failed by test flag"));
+    return;
+  }
+  const auto deadline = context.GetClientDeadline();
+  const int num_requests = req->consensus_request_size();
+  // All responses are added before processing, so requests could fill them concurrently.
+  for (int i = 0; i != num_requests; ++i) {
+    resp->add_consensus_response();
+  }
+  auto process = [this, req, resp, deadline](int index) {
+    auto* consensus_resp = resp->mutable_consensus_response(index);
+    auto error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+    // Requests of the batch are independent, so failure of one of them is reported in its own
+    // response.
+    auto status = DoUpdateConsensus(
+        "MultiRaftUpdateConsensus", const_cast<ConsensusRequestPB*>(&req->consensus_request(index)),
+        consensus_resp, deadline, &error_code);
+    if (PREDICT_FALSE(!status.ok())) {
+      consensus_resp->Clear();
+      auto* error = consensus_resp->mutable_error();
+      StatusToPB(status, error->mutable_status());
+      error->set_code(error_code);
+    }
+  };
+
+  if (!multi_raft_pool_ || num_requests < 2) {
+    for (int i = 0; i != num_requests; ++i) {
+      process(i);
+    }
+    context.RespondSuccess();
+    return;
+  }
+
+  // Tablets are updated concurrently, so a tablet that is slow to update, for instance waiting
+  // for its log, does not delay heartbeats of other tablets in the batch.
+  struct BatchState {
+    BatchState(rpc::RpcContext context_, int pending_)
+        : context(std::move(context_)), pending(pending_) {}
+
+    rpc::RpcContext context;
+    std::atomic<int> pending;
+  };
+  auto state = std::make_shared<BatchState>(std::move(context), num_requests);
+  for (int i = 0; i != num_requests; ++i) {
+    auto task = [state, process, i] {
+      process(i);
+      if (state->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        state->context.RespondSuccess();
+      }
+    };
+    auto submit_status = multi_raft_pool_->SubmitFunc(task);
+    if (!submit_status.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to submit consensus update: " << submit_status;
+      task();
+    }
+  }
+}
+
+Status ConsensusServiceImpl::DoUpdateConsensus(const char* method_name,
+                                               ConsensusRequestPB* req,
+                                               ConsensusResponsePB* resp,
+                                               CoarseTimePoint deadline,
+                                               TabletServerErrorPB::Code* error_code) {
+  const auto& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+  if (PREDICT_FALSE(!req->has_dest_uuid())) {
+    // Maintain compat in release mode, but complain.
+#ifdef NDEBUG
+    YB_LOG_EVERY_N(ERROR, 100)
+#else
+    LOG(FATAL)
+#endif
+        << method_name << ": Missing destination UUID in request: " << req->ShortDebugString();
+  } else if (PREDICT_FALSE(req->dest_uuid() != local_uuid)) {
+    *error_code = TabletServerErrorPB::WRONG_SERVER_UUID;
+    auto status = STATUS_FORMAT(InvalidArgument,
+                                "$0: Wrong destination UUID requested. "
+                                "Local UUID: $1. Requested UUID: $2",
+                                method_name, local_uuid, req->dest_uuid());
+    LOG(WARNING) << status << ": " << req->ShortDebugString();
+    return status;
+  }
+
+  TabletPeerPtr tablet_peer;
+  auto status = tablet_manager_->GetTabletPeer(req->tablet_id(), &tablet_peer);
+  if (PREDICT_FALSE(!status.ok())) {
+    *error_code = status.IsServiceUnavailable() ? TabletServerErrorPB::UNKNOWN_ERROR
+                                                : TabletServerErrorPB::TABLET_NOT_FOUND;
+    return status;
+  }
+
+  auto state = tablet_peer->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    status = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStatePB_Name(state));
+    if (state == tablet::FAILED) {
+      status = status.CloneAndAppend(tablet_peer->error().ToString());
+    }
+    return status;
+  }
+
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  auto consensus = tablet_peer->shared_consensus();
+  if (PREDICT_FALSE(!consensus)) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
+  }
+
+  RETURN_NOT_OK(consensus->Update(req, resp, deadline));
 
   auto tablet = tablet_peer->shared_tablet();
   if (tablet) {
@@ -1619,7 +1963,7 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   }
 
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
-  context.RespondSuccess();
+  return Status::OK();
 }
 
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
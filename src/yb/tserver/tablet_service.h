@@ -51,6 +51,7 @@ namespace yb {
 class Schema;
 class Status;
 class HybridTime;
+class ThreadPool;
 
 namespace tserver {
 
@@ -199,14 +200,25 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
                     CountIntentsResponsePB* resp,
                     rpc::RpcContext context) override;
 
+  void GetSplitKey(const GetSplitKeyRequestPB* req,
+                   GetSplitKeyResponsePB* resp,
+                   rpc::RpcContext context) override;
+
+  void SplitTablet(const SplitTabletRequestPB* req,
+                   SplitTabletResponsePB* resp,
+                   rpc::RpcContext context) override;
+
  private:
   TabletServer* server_;
 };
 
 class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
  public:
+  // Requests of MultiRaftUpdateConsensus are processed concurrently on multi_raft_pool, when it
+  // is specified.
   ConsensusServiceImpl(const scoped_refptr<MetricEntity>& metric_entity,
-                       TabletPeerLookupIf* tablet_manager_);
+                       TabletPeerLookupIf* tablet_manager_,
+                       ThreadPool* multi_raft_pool = nullptr);
 
   virtual ~ConsensusServiceImpl();
 
@@ -214,6 +226,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  virtual void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                        consensus::MultiRaftConsensusResponsePB *resp,
+                                        rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -251,7 +267,16 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies update of a single tablet, without responding to the RPC. Used by both UpdateConsensus
+  // and MultiRaftUpdateConsensus.
+  CHECKED_STATUS DoUpdateConsensus(const char* method_name,
+                                   consensus::ConsensusRequestPB* req,
+                                   consensus::ConsensusResponsePB* resp,
+                                   CoarseTimePoint deadline,
+                                   TabletServerErrorPB::Code* error_code);
+
   TabletPeerLookupIf* tablet_manager_;
+  ThreadPool* multi_raft_pool_;
 };
 
 }  // namespace tserver
@@ -50,6 +50,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -69,6 +70,7 @@
 #include "yb/rpc/messenger.h"
 
 #include "yb/tablet/metadata.pb.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -77,6 +79,7 @@
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/tserver/heartbeater.h"
+#include "yb/tserver/read_scheduler.h"
 #include "yb/tserver/remote_bootstrap_client.h"
 #include "yb/tserver/remote_bootstrap_session.h"
 #include "yb/tserver/tablet_server.h"
@@ -192,6 +195,15 @@ DEFINE_int32(read_pool_max_queue_size, 128,
              "The maximum number of tasks that can be held in the queue for read_pool_. This pool "
              "is used to run multiple read operations, that are part of the same tablet rpc, "
              "in parallel.");
+DEFINE_int32(read_scheduler_max_threads, 64,
+             "The maximum number of threads used by the read scheduler. Threads are started on "
+             "demand and stopped when idle.");
+TAG_FLAG(read_scheduler_max_threads, advanced);
+
+DEFINE_int32(read_scheduler_point_read_threads, 8,
+             "The number of threads of the read scheduler that are reserved for point reads, so "
+             "point reads are not queued behind scans that occupy all threads.");
+TAG_FLAG(read_scheduler_point_read_threads, advanced);
 
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
@@ -202,6 +214,13 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
              "Default timeout for the YBClient embedded into the tablet server that is used "
              "for distributed transactions.");
 
+DEFINE_bool(enable_fast_restart_after_clean_shutdown, false,
+            "Whether tablets that have all their WAL entries applied should be flushed during "
+            "server shutdown, so they could skip log replay on the next start. Only segments "
+            "within retryable_request_timeout_secs are read, to rebuild retryable requests.");
+TAG_FLAG(enable_fast_restart_after_clean_shutdown, advanced);
+TAG_FLAG(enable_fast_restart_after_clean_shutdown, runtime);
+
 namespace yb {
 namespace tserver {
 
@@ -421,6 +440,16 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_metrics(std::move(read_metrics))
                .Build(&read_pool_));
 
+  std::unique_ptr<ThreadPool> read_scheduler_pool;
+  CHECK_OK(ThreadPoolBuilder("read-sched")
+               .set_max_threads(FLAGS_read_scheduler_max_threads)
+               .set_idle_timeout(MonoDelta::FromMilliseconds(10000))
+               .Build(&read_scheduler_pool));
+  read_scheduler_ = std::make_unique<ReadScheduler>(
+      std::move(read_scheduler_pool),
+      std::max(FLAGS_read_scheduler_max_threads - FLAGS_read_scheduler_point_read_threads, 1),
+      server_->metric_entity());
+
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
   // Auto-compute size of block cache if asked to.
@@ -491,6 +520,9 @@ Status TSTabletManager::Init() {
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache());
+
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
@@ -719,6 +751,56 @@ Status TSTabletManager::CreateNewTablet(
   return Status::OK();
 }
 
+Status TSTabletManager::ApplyTabletSplit(tablet::SplitOperationState* state) {
+  auto* tablet = state->tablet();
+  const auto& request = *state->request();
+  const TabletId child_ids[] = { request.new_tablet1_id(), request.new_tablet2_id() };
+
+  // New tablets start with the same Raft config as the split one, so all its replicas create
+  // replicas of the new tablets.
+  std::unique_ptr<ConsensusMetadata> parent_cmeta;
+  RETURN_NOT_OK(ConsensusMetadata::Load(
+      fs_manager_, tablet->tablet_id(), fs_manager_->uuid(), &parent_cmeta));
+  RaftConfigPB config = parent_cmeta->committed_config();
+  config.set_opid_index(consensus::kInvalidOpIdIndex);
+
+  for (const auto& child_id : child_ids) {
+    std::unique_ptr<ConsensusMetadata> cmeta;
+    if (ConsensusMetadata::Load(fs_manager_, child_id, fs_manager_->uuid(), &cmeta).ok()) {
+      continue;
+    }
+    RETURN_NOT_OK_PREPEND(
+        ConsensusMetadata::Create(fs_manager_, child_id, fs_manager_->uuid(), config,
+                                  consensus::kMinimumTerm, &cmeta),
+        "Unable to create new ConsensusMeta for tablet " + child_id);
+  }
+
+  RETURN_NOT_OK(tablet->Split(state));
+
+  for (const auto& child_id : child_ids) {
+    scoped_refptr<TransitionInProgressDeleter> deleter;
+    {
+      std::lock_guard<RWMutex> lock(lock_);
+      TabletPeerPtr existing;
+      if (LookupTabletUnlocked(child_id, &existing)) {
+        continue;
+      }
+      RETURN_NOT_OK(StartTabletStateTransitionUnlocked(child_id, "splitting tablet", &deleter));
+    }
+
+    RaftGroupMetadataPtr meta;
+    RETURN_NOT_OK(OpenTabletMeta(child_id, &meta));
+    RegisterDataAndWalDir(fs_manager_, meta->table_id(), meta->raft_group_id(),
+                          meta->table_type(), meta->data_root_dir(), meta->wal_root_dir());
+    RETURN_NOT_OK(CreateAndRegisterTabletPeer(meta, NEW_PEER));
+    RETURN_NOT_OK(open_tablet_pool_->SubmitFunc(
+        std::bind(&TSTabletManager::OpenTablet, this, meta, deleter)));
+    LOG(INFO) << TabletLogPrefix(child_id) << "Created by split of " << tablet->tablet_id();
+  }
+
+  return Status::OK();
+}
+
 string LogPrefix(const string& tablet_id, const string& uuid) {
   return "T " + tablet_id + " P " + uuid + ": ";
 }
@@ -923,7 +1005,7 @@ Result<TabletPeerPtr> TSTabletManager::CreateAndRegisterTabletPeer(
   TabletPeerPtr tablet_peer(new tablet::TabletPeer(
       meta, local_peer_pb_, scoped_refptr<server::Clock>(server_->clock()), fs_manager_->uuid(),
       Bind(&TSTabletManager::ApplyChange, Unretained(this), meta->raft_group_id()),
-      metric_registry_));
+      metric_registry_, this));
   RETURN_NOT_OK(RegisterTablet(meta->raft_group_id(), tablet_peer, mode));
   return tablet_peer;
 }
@@ -1113,7 +1195,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
         std::bind(&TSTabletManager::PreserveLocalLeadersOnly, this, _1),
         tablet_peer.get(),
         append_pool(),
-        &retryable_requests};
+        &retryable_requests,
+        this};
     s = BootstrapTablet(data, &tablet, &log, &bootstrap_info);
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to bootstrap: " << s;
@@ -1134,7 +1217,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
                                          tablet->GetMetricEntity(),
                                          raft_pool(),
                                          tablet_prepare_pool(),
-                                         &retryable_requests);
+                                         &retryable_requests,
+                                         multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1209,8 +1293,14 @@ void TSTabletManager::StartShutdown() {
 }
 
 void TSTabletManager::CompleteShutdown() {
+  if (read_scheduler_) {
+    read_scheduler_->Shutdown();
+  }
+
+  const tablet::RecordCleanShutdown record_clean_shutdown(
+      FLAGS_enable_fast_restart_after_clean_shutdown);
   for (const TabletPeerPtr& peer : shutting_down_peers_) {
-    peer->CompleteShutdown();
+    peer->CompleteShutdown(tablet::IsDropTable::kFalse, record_clean_shutdown);
   }
 
   // Shut down the apply pool.
@@ -53,6 +53,7 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/tablet/tablet_splitter.h"
 #include "yb/tserver/tablet_peer_lookup.h"
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_admin.pb.h"
@@ -84,6 +85,7 @@ class TabletReportPB;
 } // namespace master
 
 namespace tserver {
+class ReadScheduler;
 class TabletServer;
 class TsTabletManagerListener {
  public:
@@ -114,7 +116,7 @@ class TransitionInProgressDeleter;
 // TODO: will also be responsible for keeping the local metadata about
 // which tablets are hosted on this server persistent on disk, as well
 // as re-opening all the tablets at startup, etc.
-class TSTabletManager : public tserver::TabletPeerLookupIf {
+class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::TabletSplitter {
  public:
   typedef std::vector<std::shared_ptr<tablet::TabletPeer>> TabletPeers;
 
@@ -147,6 +149,7 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   ThreadPool* raft_pool() const { return raft_pool_.get(); }
   ThreadPool* read_pool() const { return read_pool_.get(); }
   ThreadPool* append_pool() const { return append_pool_.get(); }
+  ReadScheduler* read_scheduler() const { return read_scheduler_.get(); }
 
   // Create a new tablet and register it with the tablet manager. The new tablet
   // is persisted on disk and opened before this method returns.
@@ -180,6 +183,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
                       const boost::optional<int64_t>& cas_config_opid_index_less_or_equal,
                       boost::optional<TabletServerErrorPB::Code>* error_code);
 
+  // Creates the tablets produced by the split of the tablet specified in 'state', registers and
+  // opens them. Tablets that are already registered are left as is.
+  CHECKED_STATUS ApplyTabletSplit(tablet::SplitOperationState* state) override;
+
   // Lookup the given tablet peer by its ID.
   // Returns true if the tablet is found successfully.
   bool LookupTablet(const std::string& tablet_id,
@@ -477,9 +484,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
+  // Executes reads in fair order between tablets, shared between all tablets.
+  std::unique_ptr<ReadScheduler> read_scheduler_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
+  // Coalesces heartbeats of idle tablets sent to the same server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -31,6 +31,7 @@
 
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/shared_lock.h"
 
 using namespace std::placeholders;
 using namespace yb::size_literals;
@@ -165,29 +166,51 @@ void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
   next_available_processor_ = pos;
 }
 
+CQLServiceImpl::PreparedStmtsShard& CQLServiceImpl::GetPreparedStmtsShard(
+    const CQLMessage::QueryId& query_id) {
+  return prepared_stmts_shards_[std::hash<CQLMessage::QueryId>()(query_id) %
+                                prepared_stmts_shards_.size()];
+}
+
+shared_ptr<CQLStatement> CQLServiceImpl::FindPreparedStatementUnlocked(
+    const PreparedStmtsShard& shard, const CQLMessage::QueryId& query_id) {
+  const auto itr = shard.map.find(query_id);
+  if (itr == shard.map.end()) {
+    return nullptr;
+  }
+  itr->second->MarkUsed();
+  return itr->second;
+}
+
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
     const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
-  // Get exclusive lock before allocating a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  auto& shard = GetPreparedStmtsShard(query_id);
 
-  shared_ptr<CQLStatement> stmt;
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  // Return existing statement if found. Only the shared lock is needed for it.
+  {
+    SharedLock<rw_spinlock> guard(shard.mutex);
+    auto stmt = FindPreparedStatementUnlocked(shard, query_id);
+    if (stmt) {
+      return stmt;
+    }
+  }
+
+  // Get exclusive lock before allocating a prepared statement and updating the shard.
+  std::lock_guard<rw_spinlock> guard(shard.mutex);
+
+  // Check again, the statement could be allocated by another client since the lookup above.
+  auto stmt = FindPreparedStatementUnlocked(shard, query_id);
+  if (!stmt) {
     // Allocate the prepared statement placeholder that multiple clients trying to prepare the same
     // statement to contend on. The statement will then be prepared by one client while the rest
     // wait for the results.
-    stmt = prepared_stmts_map_.emplace(
-        query_id, std::make_shared<CQLStatement>(
-            keyspace, query, prepared_stmts_list_.end())).first->second;
-    InsertLruPreparedStatementUnlocked(stmt);
-  } else {
-    // Return existing statement if found.
-    stmt = itr->second;
-    MoveLruPreparedStatementUnlocked(stmt);
+    stmt = shard.map.emplace(
+        query_id, std::make_shared<CQLStatement>(keyspace, query, shard.list.end())).first->second;
+    InsertPreparedStatementUnlocked(stmt, &shard);
   }
 
-  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache shard count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 
   return stmt;
@@ -195,80 +218,102 @@ shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
 
 shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
     const CQLMessage::QueryId& query_id) {
-  // Get exclusive lock before looking up a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
-
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
-    return nullptr;
+  auto& shard = GetPreparedStmtsShard(query_id);
+  shared_ptr<CQLStatement> stmt;
+  {
+    // Only the shared lock is needed, since a cache hit just marks the statement as used.
+    SharedLock<rw_spinlock> guard(shard.mutex);
+    stmt = FindPreparedStatementUnlocked(shard, query_id);
   }
 
-  shared_ptr<CQLStatement> stmt = itr->second;
-
   // If the statement has not finished preparing, do not return it.
-  if (stmt->unprepared()) {
+  if (!stmt || stmt->unprepared()) {
     return nullptr;
   }
   // If the statement is stale, delete it.
   if (stmt->stale()) {
-    DeletePreparedStatementUnlocked(stmt);
+    DeletePreparedStatement(stmt);
     return nullptr;
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
   return stmt;
 }
 
 void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  auto& shard = GetPreparedStmtsShard(stmt->query_id());
+
   // Get exclusive lock before deleting the prepared statement.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<rw_spinlock> guard(shard.mutex);
 
-  DeletePreparedStatementUnlocked(stmt);
+  DeletePreparedStatementUnlocked(stmt, &shard);
 
-  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache shard count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
-void CQLServiceImpl::InsertLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
-  // Insert the statement at the front of the LRU list.
-  stmt->set_pos(prepared_stmts_list_.insert(prepared_stmts_list_.begin(), stmt));
-}
-
-void CQLServiceImpl::MoveLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
-  // Move the statement to the front of the LRU list.
-  prepared_stmts_list_.splice(prepared_stmts_list_.begin(), prepared_stmts_list_, stmt->pos());
+void CQLServiceImpl::InsertPreparedStatementUnlocked(
+    const shared_ptr<CQLStatement>& stmt, PreparedStmtsShard* shard) {
+  // Insert the statement right before the clock hand, i.e. the hand will reach it last.
+  stmt->set_pos(shard->list.insert(shard->clock_hand, stmt));
 }
 
 void CQLServiceImpl::DeletePreparedStatementUnlocked(
-    const std::shared_ptr<const CQLStatement> stmt) {
+    const std::shared_ptr<const CQLStatement> stmt, PreparedStmtsShard* shard) {
   // Remove statement from cache by looking it up by query ID and only when it is same statement
   // object. Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have
-  // a separate copy of the shared_ptr and not the very shared_ptr in prepared_stmts_map_ or
-  // prepared_stmt_list_ we are deleting.
-  const auto itr = prepared_stmts_map_.find(stmt->query_id());
-  if (itr != prepared_stmts_map_.end() && itr->second == stmt) {
-    prepared_stmts_map_.erase(itr);
+  // a separate copy of the shared_ptr and not the very shared_ptr in the shard map or list we are
+  // deleting.
+  const auto itr = shard->map.find(stmt->query_id());
+  if (itr != shard->map.end() && itr->second == stmt) {
+    shard->map.erase(itr);
   }
-  // Remove statement from LRU list only when it is in the list, i.e. pos() != end().
-  if (stmt->pos() != prepared_stmts_list_.end()) {
-    prepared_stmts_list_.erase(stmt->pos());
-    stmt->set_pos(prepared_stmts_list_.end());
+  // Remove statement from the list only when it is in the list, i.e. pos() != end().
+  if (stmt->pos() != shard->list.end()) {
+    if (shard->clock_hand == stmt->pos()) {
+      ++shard->clock_hand;
+    }
+    shard->list.erase(stmt->pos());
+    stmt->set_pos(shard->list.end());
   }
 }
 
-void CQLServiceImpl::CollectGarbage(size_t required) {
-  // Get exclusive lock before deleting the least recently used statement at the end of the LRU
-  // list from the cache.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+bool CQLServiceImpl::EvictPreparedStatementUnlocked(PreparedStmtsShard* shard) {
+  if (shard->list.empty()) {
+    return false;
+  }
 
-  if (!prepared_stmts_list_.empty()) {
-    DeletePreparedStatementUnlocked(prepared_stmts_list_.back());
+  // Each used statement is unmarked when the hand passes it, so the loop ends after at most one
+  // full turn.
+  for (;;) {
+    if (shard->clock_hand == shard->list.end()) {
+      shard->clock_hand = shard->list.begin();
+    }
+    auto stmt = *shard->clock_hand;
+    if (!stmt->ResetUsed()) {
+      DeletePreparedStatementUnlocked(stmt, shard);
+      return true;
+    }
+    ++shard->clock_hand;
   }
+}
 
-  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
-          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+void CQLServiceImpl::CollectGarbage(size_t required) {
+  // Evict a statement from the first non-empty shard, starting from the one next to the shard used
+  // by the previous call, so all shards are shrunk evenly.
+  const size_t start = next_prepared_stmts_shard_to_evict_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i != prepared_stmts_shards_.size(); ++i) {
+    auto& shard = prepared_stmts_shards_[(start + i) % prepared_stmts_shards_.size()];
+
+    // Get exclusive lock before deleting the statement from the shard.
+    std::lock_guard<rw_spinlock> guard(shard.mutex);
+    if (EvictPreparedStatementUnlocked(&shard)) {
+      VLOG(1) << "EvictPreparedStatement: CQL prepared statement cache shard count = "
+              << shard.map.size() << "/" << shard.list.size()
+              << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+      return;
+    }
+  }
 }
 
 server::Clock* CQLServiceImpl::clock() {
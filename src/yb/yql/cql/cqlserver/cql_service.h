@@ -17,6 +17,7 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 
+#include <array>
 #include <vector>
 
 #include "yb/client/client_fwd.h"
@@ -28,6 +29,7 @@
 #include "yb/yql/cql/cqlserver/cql_server_options.h"
 #include "yb/yql/cql/ql/statement.h"
 
+#include "yb/util/locks.h"
 #include "yb/util/string_case.h"
 
 #include "yb/client/async_initializer.h"
@@ -98,24 +100,56 @@ class CQLServiceImpl : public CQLServerServiceIf,
   }
 
  private:
+  friend class TestCQLPreparedStmtsCache;
+
   constexpr static int kRpcTimeoutSec = 5;
 
   // Either gets an available processor or creates a new one.
   CQLProcessor *GetProcessor();
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  // Number of shards in the prepared statements cache.
+  static constexpr size_t kNumPreparedStmtsShards = 16;
+
+  // Shard of the prepared statements cache. Statements are evicted with the CLOCK algorithm, so a
+  // cache hit only marks the statement as used under the shared lock, and the clock hand skips and
+  // unmarks used statements when looking for the one to evict.
+  struct PreparedStmtsShard {
+    // Mutex that protects the statements and the list of the shard.
+    rw_spinlock mutex;
+
+    // Prepared statements of the shard.
+    CQLStatementMap map;
+
+    // Prepared statements of the shard in the order they are visited by the clock hand.
+    CQLStatementList list;
+
+    // Next statement to be checked for eviction, list.end() means the beginning of the list.
+    CQLStatementListPos clock_hand = list.end();
+  };
 
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  // Return the shard of the prepared statements cache that contains the statement with the id.
+  PreparedStmtsShard& GetPreparedStmtsShard(const CQLMessage::QueryId& query_id);
 
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
-  // be locked before this call.
-  void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+  // Look up a prepared statement in the shard and mark it as used. "shard.mutex" needs to be locked
+  // at least in shared mode before this call.
+  std::shared_ptr<CQLStatement> FindPreparedStatementUnlocked(
+      const PreparedStmtsShard& shard, const CQLMessage::QueryId& query_id);
 
-  // Delete the least recently used prepared statement from the cache to free up memory.
+  // Insert a prepared statement to the shard right behind the clock hand, so it will be checked for
+  // eviction last. "shard.mutex" needs to be locked before this call.
+  void InsertPreparedStatementUnlocked(
+      const std::shared_ptr<CQLStatement>& stmt, PreparedStmtsShard* shard);
+
+  // Delete a prepared statement from the shard. "shard.mutex" needs to be locked before this call.
+  void DeletePreparedStatementUnlocked(
+      const std::shared_ptr<const CQLStatement> stmt, PreparedStmtsShard* shard);
+
+  // Evict a prepared statement, that was not used since the clock hand visited it last time, from
+  // the shard. Return false if the shard is empty. "shard.mutex" needs to be locked before this
+  // call.
+  bool EvictPreparedStatementUnlocked(PreparedStmtsShard* shard);
+
+  // Delete a not recently used prepared statement from the cache to free up memory.
   void CollectGarbage(size_t required) override;
 
   // CQLServer of this service.
@@ -139,14 +173,11 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Mutex that protects access to processors_.
   std::mutex processors_mutex_;
 
-  // Prepared statements cache.
-  CQLStatementMap prepared_stmts_map_;
-
-  // Prepared statements LRU list (least recently used one at the end).
-  CQLStatementList prepared_stmts_list_;
+  // Prepared statements cache, sharded by query id.
+  std::array<PreparedStmtsShard, kNumPreparedStmtsShards> prepared_stmts_shards_;
 
-  // Mutex that protects the prepared statements and the LRU list.
-  std::mutex prepared_stmts_mutex_;
+  // Shard to evict the next prepared statement from when the memory limit is hit.
+  std::atomic<size_t> next_prepared_stmts_shard_to_evict_{0};
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
@@ -19,6 +19,7 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_STATEMENT_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_STATEMENT_H_
 
+#include <atomic>
 #include <list>
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
@@ -34,7 +35,7 @@ class CQLStatement;
 // it when it is being executed by another client in another thread.
 using CQLStatementMap = std::unordered_map<CQLMessage::QueryId, std::shared_ptr<CQLStatement>>;
 
-// A LRU list of CQL statements and position in the list.
+// A list of CQL statements, in the order they are checked for eviction, and position in the list.
 using CQLStatementList = std::list<std::shared_ptr<CQLStatement>>;
 using CQLStatementListPos = CQLStatementList::iterator;
 
@@ -47,16 +48,30 @@ class CQLStatement : public ql::Statement {
   // Return the query id.
   CQLMessage::QueryId query_id() const { return GetQueryId(keyspace_, text_); }
 
-  // Get/set position of the statement in the LRU.
+  // Get/set position of the statement in the cache list.
   CQLStatementListPos pos() const { return pos_; }
   void set_pos(CQLStatementListPos pos) const { pos_ = pos; }
 
+  // Mark the statement as used since it was last checked for eviction. The flag is checked before
+  // the store, so cache hits on a hot statement do not keep invalidating its cache line.
+  void MarkUsed() const {
+    if (!used_.load(std::memory_order_relaxed)) {
+      used_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Clear the used mark. Return whether the statement was used since the previous call.
+  bool ResetUsed() const { return used_.exchange(false, std::memory_order_relaxed); }
+
   // Return the query id of a statement.
   static CQLMessage::QueryId GetQueryId(const std::string& keyspace, const std::string& query);
 
  private:
-  // Position of the statement in the LRU.
+  // Position of the statement in the cache list.
   mutable CQLStatementListPos pos_;
+
+  // Whether the statement was used since it was last checked for eviction.
+  mutable std::atomic<bool> used_{true};
 };
 
 }  // namespace cqlserver
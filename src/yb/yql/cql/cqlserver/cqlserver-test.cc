@@ -20,12 +20,18 @@
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
 #include "yb/yql/cql/cqlserver/cql_server.h"
+#include "yb/yql/cql/cqlserver/cql_service.h"
 
 #include "yb/gutil/strings/join.h"
 #include "yb/util/cast.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/shared_lock.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int64(cql_service_max_prepared_statement_size_bytes);
+
 namespace yb {
 namespace cqlserver {
 
@@ -46,10 +52,16 @@ class TestCQLService : public YBTableTestBase {
   void SendRequestAndExpectResponse(const string& cmd, const string& resp);
 
   int server_port() { return cql_server_port_; }
+
+  const CQLServerOptions& server_options() const { return opts_; }
+
+  boost::asio::io_service* io() { return io_.get(); }
+
  private:
   Status SendRequestAndGetResponse(
       const string& cmd, int expected_resp_length, int timeout_in_millis = 1000);
 
+  CQLServerOptions opts_;
   Socket client_sock_;
   unique_ptr<boost::asio::io_service> io_;
   unique_ptr<CQLServer> server_;
@@ -63,27 +75,26 @@ class TestCQLService : public YBTableTestBase {
 void TestCQLService::SetUp() {
   YBTableTestBase::SetUp();
 
-  CQLServerOptions opts;
   cql_server_port_ = GetFreePort(&cql_port_lock_);
-  opts.rpc_opts.rpc_bind_addresses = strings::Substitute("0.0.0.0:$0", cql_server_port_);
+  opts_.rpc_opts.rpc_bind_addresses = strings::Substitute("0.0.0.0:$0", cql_server_port_);
   // No need to save the webserver port, as we don't plan on using it. Just use a unique free port.
-  opts.webserver_opts.port = GetFreePort(&cql_webserver_lock_);
+  opts_.webserver_opts.port = GetFreePort(&cql_webserver_lock_);
   string fs_root = GetTestPath("CQLServerTest-fsroot");
-  opts.fs_opts.wal_paths = {fs_root};
-  opts.fs_opts.data_paths = {fs_root};
+  opts_.fs_opts.wal_paths = {fs_root};
+  opts_.fs_opts.data_paths = {fs_root};
 
   auto master_rpc_addrs = master_rpc_addresses_as_strings();
-  opts.master_addresses_flag = JoinStrings(master_rpc_addrs, ",");
+  opts_.master_addresses_flag = JoinStrings(master_rpc_addrs, ",");
   auto master_addresses = std::make_shared<server::MasterAddresses>();
   for (const auto& hp_str : master_rpc_addrs) {
     HostPort hp;
     CHECK_OK(hp.ParseString(hp_str, cql_server_port_));
     master_addresses->push_back({std::move(hp)});
   }
-  opts.SetMasterAddresses(master_addresses);
+  opts_.SetMasterAddresses(master_addresses);
 
   io_.reset(new boost::asio::io_service());
-  server_.reset(new CQLServer(opts, io_.get(), nullptr));
+  server_.reset(new CQLServer(opts_, io_.get(), nullptr));
   LOG(INFO) << "Starting CQL server...";
   CHECK_OK(server_->Start());
   LOG(INFO) << "CQL server successfully started.";
@@ -251,5 +262,178 @@ TEST_F(TestCQLService, TestCQLServerEventConst) {
   ASSERT_EQ(0, memcmp(buffer, ptr, kSize));
 }
 
+class TestCQLPreparedStmtsCache : public TestCQLService {
+ public:
+  void SetUp() override {
+    FLAGS_cql_service_max_prepared_statement_size_bytes = kMemoryLimit;
+    TestCQLService::SetUp();
+
+    // The service of a server that is not started, so its prepared statements cache is used only
+    // by the test.
+    cache_server_.reset(new CQLServer(server_options(), io(), nullptr));
+    service_ = std::make_shared<CQLServiceImpl>(
+        cache_server_.get(), server_options(), ql::TransactionPoolProvider());
+    service_->CompleteInit();
+  }
+
+  void TearDown() override {
+    service_->Shutdown();
+    service_.reset();
+    cache_server_.reset();
+    TestCQLService::TearDown();
+  }
+
+ protected:
+  static constexpr int64_t kMemoryLimit = 1_MB;
+  static constexpr size_t kNumShards = CQLServiceImpl::kNumPreparedStmtsShards;
+
+  static string Query(int i) {
+    return Format("SELECT * FROM t WHERE k = $0", i);
+  }
+
+  static CQLMessage::QueryId QueryId(int i) {
+    return CQLStatement::GetQueryId(kKeyspace, Query(i));
+  }
+
+  std::shared_ptr<CQLStatement> Allocate(int i) {
+    return service_->AllocatePreparedStatement(QueryId(i), kKeyspace, Query(i));
+  }
+
+  size_t ShardIndex(int i) {
+    return &service_->GetPreparedStmtsShard(QueryId(i)) - service_->prepared_stmts_shards_.data();
+  }
+
+  // Returns queries that are cached in the same shard as query 0.
+  std::vector<int> QueriesOfSameShard(size_t count) {
+    std::vector<int> result;
+    for (int i = 0; result.size() != count; ++i) {
+      if (ShardIndex(i) == ShardIndex(0)) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  // Checks whether the statement is cached, without marking it as used.
+  bool IsCached(int i) {
+    auto& shard = service_->GetPreparedStmtsShard(QueryId(i));
+    SharedLock<rw_spinlock> lock(shard.mutex);
+    return shard.map.count(QueryId(i)) != 0;
+  }
+
+  std::vector<size_t> ShardSizes() {
+    std::vector<size_t> result;
+    for (auto& shard : service_->prepared_stmts_shards_) {
+      SharedLock<rw_spinlock> lock(shard.mutex);
+      EXPECT_EQ(shard.map.size(), shard.list.size());
+      result.push_back(shard.map.size());
+    }
+    return result;
+  }
+
+  void CollectGarbage() {
+    service_->CollectGarbage(1);
+  }
+
+  // Requests memory above the limit of the prepared statements memory tracker, so it collects
+  // garbage. Each collection evicts a single statement.
+  void HitMemoryLimit() {
+    const auto& tracker = service_->prepared_stmts_mem_tracker();
+    ScopedTrackedConsumption consumption(tracker, kMemoryLimit - tracker->consumption());
+    ASSERT_FALSE(tracker->TryConsume(1));
+  }
+
+  static const string kKeyspace;
+
+  unique_ptr<CQLServer> cache_server_;
+  std::shared_ptr<CQLServiceImpl> service_;
+};
+
+const string TestCQLPreparedStmtsCache::kKeyspace = "test_keyspace";
+
+TEST_F(TestCQLPreparedStmtsCache, ClockEviction) {
+  const auto queries = QueriesOfSameShard(4);
+  for (int query : queries) {
+    ASSERT_NE(Allocate(query), nullptr);
+  }
+
+  // New statements are marked as used, so the clock hand makes a full turn unmarking them and
+  // evicts the oldest one.
+  ASSERT_NO_FATALS(HitMemoryLimit());
+  ASSERT_FALSE(IsCached(queries[0]));
+  for (size_t i = 1; i != queries.size(); ++i) {
+    ASSERT_TRUE(IsCached(queries[i])) << i;
+  }
+
+  // A lookup gives the statement a second chance, so the hand skips it and evicts the next one
+  // that was not used since the hand passed it.
+  ASSERT_EQ(service_->GetPreparedStatement(QueryId(queries[2])), nullptr);  // Unprepared.
+  ASSERT_NO_FATALS(HitMemoryLimit());
+  ASSERT_FALSE(IsCached(queries[1]));
+  ASSERT_NO_FATALS(HitMemoryLimit());
+  ASSERT_FALSE(IsCached(queries[3]));
+  ASSERT_TRUE(IsCached(queries[2]));
+
+  // The second chance is used up.
+  ASSERT_NO_FATALS(HitMemoryLimit());
+  ASSERT_FALSE(IsCached(queries[2]));
+  ASSERT_EQ(ShardSizes(), std::vector<size_t>(kNumShards, 0));
+}
+
+TEST_F(TestCQLPreparedStmtsCache, CollectGarbageRotatesShards) {
+  // Fill each shard with two statements.
+  std::vector<size_t> counts(kNumShards);
+  size_t filled_shards = 0;
+  for (int i = 0; filled_shards != kNumShards; ++i) {
+    auto& count = counts[ShardIndex(i)];
+    if (count < 2) {
+      ASSERT_NE(Allocate(i), nullptr);
+      if (++count == 2) {
+        ++filled_shards;
+      }
+    }
+  }
+  ASSERT_EQ(ShardSizes(), std::vector<size_t>(kNumShards, 2));
+
+  // Each collection evicts from the shard next to the previous one, so the shards shrink evenly.
+  for (size_t i = 0; i != kNumShards; ++i) {
+    CollectGarbage();
+  }
+  ASSERT_EQ(ShardSizes(), std::vector<size_t>(kNumShards, 1));
+
+  for (size_t i = 0; i != kNumShards; ++i) {
+    ASSERT_NO_FATALS(HitMemoryLimit());
+  }
+  ASSERT_EQ(ShardSizes(), std::vector<size_t>(kNumShards, 0));
+
+  // Collecting garbage from an empty cache does nothing.
+  CollectGarbage();
+  ASSERT_EQ(ShardSizes(), std::vector<size_t>(kNumShards, 0));
+}
+
+TEST_F(TestCQLPreparedStmtsCache, LookupAfterEviction) {
+  const int kQuery = 0;
+  auto evicted = Allocate(kQuery);
+  ASSERT_NE(evicted, nullptr);
+  ASSERT_EQ(Allocate(kQuery), evicted);
+
+  ASSERT_NO_FATALS(HitMemoryLimit());
+  ASSERT_FALSE(IsCached(kQuery));
+
+  // The client gets the unprepared error and prepares the statement again. A client that is still
+  // executing the evicted statement keeps it alive.
+  ASSERT_EQ(service_->GetPreparedStatement(QueryId(kQuery)), nullptr);
+  ASSERT_EQ(evicted->text(), Query(kQuery));
+  auto allocated = Allocate(kQuery);
+  ASSERT_NE(allocated, evicted);
+  ASSERT_TRUE(IsCached(kQuery));
+
+  // Deleting the evicted statement does not delete the new one with the same query id.
+  service_->DeletePreparedStatement(evicted);
+  ASSERT_TRUE(IsCached(kQuery));
+  service_->DeletePreparedStatement(allocated);
+  ASSERT_FALSE(IsCached(kQuery));
+}
+
 }  // namespace cqlserver
 }  // namespace yb
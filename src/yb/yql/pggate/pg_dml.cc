@@ -245,7 +245,7 @@ Status PgDml::Fetch(int32_t natts,
   }
 
   // Load data from cache in doc_op_ to cursor_ if it is not pointing to any data.
-  if (cursor_.empty()) {
+  if (cursor_.empty() && columnar_row_index_ >= columnar_batch_.row_count()) {
     int64_t row_count = 0;
     // Keep reading untill we either reach the end or get some rows.
     while (row_count == 0) {
@@ -257,10 +257,25 @@ Status PgDml::Fetch(int32_t natts,
 
       // Read from cache.
       RETURN_NOT_OK(doc_op_->GetResult(&row_batch_));
-      RETURN_NOT_OK(PgDocData::LoadCache(row_batch_, &row_count, &cursor_));
+      if (PgDocData::IsColumnarData(row_batch_)) {
+        RETURN_NOT_OK(columnar_batch_.Load(row_batch_));
+        if (columnar_batch_.row_count() != 0 &&
+            columnar_batch_.column_count() != targets_.size()) {
+          return STATUS_FORMAT(Corruption, "Expected $0 columns in columnar data, found $1",
+                               targets_.size(), columnar_batch_.column_count());
+        }
+        columnar_row_index_ = 0;
+        row_count = columnar_batch_.row_count();
+      } else {
+        columnar_batch_.Clear();
+        RETURN_NOT_OK(PgDocData::LoadCache(row_batch_, &row_count, &cursor_));
+      }
     }
 
     accumulated_row_count_ += row_count;
+  } else {
+    // Pick up pages that arrived while the current one is consumed.
+    doc_op_->ReadAhead();
   }
 
   // Read the tuple from cached buffer and write it to postgres buffer.
@@ -272,7 +287,14 @@ Status PgDml::Fetch(int32_t natts,
 }
 
 Status PgDml::WritePgTuple(PgTuple *pg_tuple) {
+  // Postgres executor consumes one tuple per Fetch() call, so even for a columnar batch the values
+  // are translated to datums one row at a time. The columnar format only spares reading the values
+  // through the row cursor; translating a whole batch would require a batch interface in the
+  // executor.
+  const bool columnar = columnar_row_index_ < columnar_batch_.row_count();
+
   int attr_num = 0;
+  size_t column_index = 0;
   for (const PgExpr *target : targets_) {
     if (!target->is_colref() && !target->is_aggregate()) {
       return STATUS(InternalError,
@@ -283,8 +305,19 @@ Status PgDml::WritePgTuple(PgTuple *pg_tuple) {
     } else {
       attr_num++;
     }
-    PgWireDataHeader header = PgDocData::ReadDataHeader(&cursor_);
-    target->TranslateData(&cursor_, header, attr_num - 1, pg_tuple);
+    if (columnar) {
+      // Values are translated directly from the column buffers of the batch.
+      PgWireDataHeader header = columnar_batch_.GetHeader(column_index, columnar_row_index_);
+      Slice value = columnar_batch_.GetValue(column_index, columnar_row_index_);
+      target->TranslateData(&value, header, attr_num - 1, pg_tuple);
+    } else {
+      PgWireDataHeader header = PgDocData::ReadDataHeader(&cursor_);
+      target->TranslateData(&cursor_, header, attr_num - 1, pg_tuple);
+    }
+    ++column_index;
+  }
+  if (columnar) {
+    ++columnar_row_index_;
   }
   return Status::OK();
 }
@@ -19,6 +19,7 @@
 #include "yb/yql/pggate/pg_session.h"
 #include "yb/yql/pggate/pg_statement.h"
 #include "yb/yql/pggate/pg_doc_op.h"
+#include "yb/yql/pggate/util/pg_doc_data.h"
 
 namespace yb {
 namespace pggate {
@@ -137,6 +138,10 @@ class PgDml : public PgStatement {
   // Cursor.
   Slice cursor_;
 
+  // Row batch in columnar format and the index of the next row to read from it.
+  PgColumnarBatch columnar_batch_;
+  int64_t columnar_row_index_ = 0;
+
   // Total number of rows that have been found.
   int64_t accumulated_row_count_ = 0;
 
@@ -30,9 +30,25 @@
 namespace yb {
 namespace pggate {
 
+namespace {
+
+// A query request can be nested, and paging state belong to the innermost query which is
+// the read operator that is operated first and feeds data to other queries.
+// Recursive Proto Message:
+//     PgsqlReadRequestPB { PgsqlReadRequestPB index_request; }
+PgsqlReadRequestPB* InnermostRequest(PgsqlReadRequestPB* req) {
+  while (req->has_index_request()) {
+    req = req->mutable_index_request();
+  }
+  return req;
+}
+
+} // namespace
+
 PgDocOp::PgDocOp(PgSession::
     ScopedRefPtr pg_session, PreventRestart prevent_restart)
-    : pg_session_(std::move(pg_session)), prevent_restart_(prevent_restart) {
+    : pg_session_(std::move(pg_session)), prevent_restart_(prevent_restart),
+      result_cache_consumption_(pg_session_->prefetch_mem_tracker(), 0) {
   exec_params_.limit_count = FLAGS_ysql_prefetch_limit;
   exec_params_.limit_offset = 0;
   exec_params_.limit_use_default = true;
@@ -86,16 +102,20 @@ Result<RequestSent> PgDocOp::Execute() {
 void PgDocOp::InitUnlocked(std::unique_lock<std::mutex>* lock) {
   CHECK(!is_canceled_);
   if (waiting_for_response_) {
-    LOG(DFATAL) << __PRETTY_FUNCTION__
-                << " is not supposed to be called while response is in flight";
+    // A request sent ahead of consumption could still be in flight when the statement is executed
+    // again. Any other request is expected to be waited for by the caller.
+    LOG_IF(DFATAL, !read_ahead_in_flight_) << __PRETTY_FUNCTION__
+        << " is not supposed to be called while response is in flight";
     while (waiting_for_response_) {
       cv_.wait(*lock);
     }
     CHECK(!waiting_for_response_);
   }
   result_cache_.clear();
+  result_cache_consumption_.Reset(0);
   end_of_data_ = false;
   has_cached_data_ = false;
+  has_returned_data_ = false;
 }
 
 Status PgDocOp::GetResult(string *result_set) {
@@ -107,21 +127,27 @@ Status PgDocOp::GetResult(string *result_set) {
   // If the execution has error, return without reading any rows.
   RETURN_NOT_OK(exec_status_);
 
-  RETURN_NOT_OK(SendRequestIfNeededUnlocked());
-
-  // Wait for response from DocDB.
-  while (!has_cached_data_ && !end_of_data_) {
+  // Wait for response from DocDB. A received response is processed here, and more data is
+  // requested until there are results to return.
+  for (;;) {
+    ProcessResponseUnlocked();
+    RETURN_NOT_OK(exec_status_);
+    if (has_cached_data_ || end_of_data_) {
+      break;
+    }
+    RETURN_NOT_OK(SendRequestIfNeededUnlocked());
     cv_.wait(lock);
   }
 
-  RETURN_NOT_OK(exec_status_);
-
   // Read from cache.
   ReadFromCacheUnlocked(result_set);
 
   // This will pre-fetch the next chunk of data if we've consumed all cached
-  // rows.
-  RETURN_NOT_OK(SendRequestIfNeededUnlocked());
+  // rows, or read ahead.
+  if (!waiting_for_response_) {
+    RETURN_NOT_OK(SendRequestIfNeededUnlocked());
+    read_ahead_in_flight_ = waiting_for_response_;
+  }
 
   if (prevent_restart_) {
     pg_session_->pg_txn_manager()->PreventRestart();
@@ -132,21 +158,25 @@ Status PgDocOp::GetResult(string *result_set) {
 void PgDocOp::WriteToCacheUnlocked(std::shared_ptr<client::YBPgsqlOp> yb_op) {
   if (!yb_op->rows_data().empty()) {
     result_cache_.push_back(yb_op->rows_data());
+    result_cache_consumption_.Add(result_cache_.back().size());
     has_cached_data_ = !result_cache_.empty();
   }
 }
 
 void PgDocOp::ReadFromCacheUnlocked(string *result) {
   if (!result_cache_.empty()) {
-    *result = result_cache_.front();
+    *result = std::move(result_cache_.front());
     result_cache_.pop_front();
+    result_cache_consumption_.Add(-static_cast<int64_t>(result->size()));
     has_cached_data_ = !result_cache_.empty();
+    has_returned_data_ = true;
   }
 }
 
 Status PgDocOp::SendRequestIfNeededUnlocked() {
-  // Request more data if more execution is needed and cache is empty.
-  if (!has_cached_data_ && !end_of_data_ && !waiting_for_response_) {
+  // Request more data if more execution is needed and cache is empty or could take more data.
+  if (!end_of_data_ && !waiting_for_response_ &&
+      (!has_cached_data_ || ShouldReadAheadUnlocked())) {
     return SendRequestUnlocked();
   }
   return Status::OK();
@@ -170,7 +200,7 @@ bool PgDocOp::CheckRestartUnlocked(client::YBPgsqlOp* op) {
   }
 
   if (response.status() == PgsqlResponsePB::PGSQL_STATUS_RESTART_REQUIRED_ERROR &&
-      pg_session_->pg_txn_manager()->CanRestart()) {
+      pg_session_->pg_txn_manager()->CanRestart() && PrepareRestartUnlocked()) {
     exec_status_ = pg_session_->RestartTransaction();
     if (exec_status_.ok()) {
       exec_status_ = SendRequestUnlocked();
@@ -205,12 +235,28 @@ PgDocReadOp::~PgDocReadOp() {
 void PgDocReadOp::InitUnlocked(std::unique_lock<std::mutex>* lock) {
   PgDocOp::InitUnlocked(lock);
 
+  has_response_.store(false, std::memory_order_release);
+  response_bytes_ = 0;
+
   read_op_->mutable_request()->set_return_paging_state(true);
+  PgsqlReadRequestPB* innermost_req = InnermostRequest(read_op_->mutable_request());
+  if (innermost_req->has_paging_state()) {
+    initial_paging_state_ = innermost_req->paging_state();
+  } else {
+    initial_paging_state_ = boost::none;
+  }
+
+  partition_reads_.clear();
+  in_flight_partitions_.clear();
+  head_partition_ = 0;
+  started_partitions_ = 0;
+  if (CanReadPartitionsInParallel()) {
+    InitPartitionReads();
+  }
 }
 
-void PgDocReadOp::SetRequestPrefetchLimit() {
+void PgDocReadOp::SetRequestPrefetchLimit(PgsqlReadRequestPB *req) {
   // Predict the maximum prefetch-limit using the associated gflags.
-  PgsqlReadRequestPB *req = read_op_->mutable_request();
   int predicted_limit = FLAGS_ysql_prefetch_limit;
   if (!req->is_forward_scan()) {
     // Backward scan is slower than forward scan, so predicted limit is a smaller number.
@@ -225,9 +271,7 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
   req->set_limit(limit_count);
 }
 
-void PgDocReadOp::SetRowMark() {
-  PgsqlReadRequestPB *const req = read_op_->mutable_request();
-
+void PgDocReadOp::SetRowMark(PgsqlReadRequestPB *req) {
   if (exec_params_.rowmark < 0) {
     req->clear_row_mark_type();
   } else {
@@ -238,8 +282,12 @@ void PgDocReadOp::SetRowMark() {
 Status PgDocReadOp::SendRequestUnlocked() {
   CHECK(!waiting_for_response_);
 
-  SetRequestPrefetchLimit();
-  SetRowMark();
+  if (!partition_reads_.empty()) {
+    return SendPartitionRequestsUnlocked();
+  }
+
+  SetRequestPrefetchLimit(read_op_->mutable_request());
+  SetRowMark(read_op_->mutable_request());
   SCHECK_EQ(VERIFY_RESULT(pg_session_->PgApplyAsync(read_op_, &read_time_)), OpBuffered::kFalse,
             IllegalState, "YSQL read operation should not be buffered");
 
@@ -259,9 +307,38 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
   CHECK(waiting_for_response_);
   cv_.notify_all();
   waiting_for_response_ = false;
-  exec_status_ = exec_status;
+  read_ahead_in_flight_ = false;
+  response_status_ = exec_status;
+
+  // The received results count towards the read-ahead budget before they are processed.
+  response_bytes_ = 0;
+  if (partition_reads_.empty()) {
+    response_bytes_ = read_op_->rows_data().size();
+  } else {
+    for (size_t i : in_flight_partitions_) {
+      response_bytes_ += partition_reads_[i].read_op->rows_data().size();
+    }
+  }
+  result_cache_consumption_.Add(response_bytes_);
+  has_response_.store(true, std::memory_order_release);
+}
 
-  if (exec_status.ok() && CheckRestartUnlocked(read_op_.get())) {
+void PgDocReadOp::ProcessResponseUnlocked() {
+  if (!has_response_.load(std::memory_order_acquire)) {
+    return;
+  }
+  has_response_.store(false, std::memory_order_release);
+  // The results are accounted again once they are moved to the cache.
+  result_cache_consumption_.Add(-static_cast<int64_t>(response_bytes_));
+  response_bytes_ = 0;
+  exec_status_ = response_status_;
+
+  if (!partition_reads_.empty()) {
+    ReceivePartitionResponsesUnlocked();
+    return;
+  }
+
+  if (exec_status_.ok() && CheckRestartUnlocked(read_op_.get())) {
     return;
   }
 
@@ -276,25 +353,7 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
     WriteToCacheUnlocked(read_op_);
 
     // Setup request for the next batch of data.
-    const PgsqlResponsePB& res = read_op_->response();
-    if (res.has_paging_state()) {
-      PgsqlReadRequestPB *req = read_op_->mutable_request();
-      // Set up paging state for next request.
-      // A query request can be nested, and paging state belong to the innermost query which is
-      // the read operator that is operated first and feeds data to other queries.
-      // Recursive Proto Message:
-      //     PgsqlReadRequestPB { PgsqlReadRequestPB index_request; }
-      PgsqlReadRequestPB *innermost_req = req;
-      while (innermost_req->has_index_request()) {
-        innermost_req = innermost_req->mutable_index_request();
-      }
-      *innermost_req->mutable_paging_state() = res.paging_state();
-      // Parse/Analysis/Rewrite catalog version has already been checked on the first request.
-      // The docdb layer will check the target table's schema version is compatible.
-      // This allows long-running queries to continue in the presence of other DDL statements
-      // as long as they do not affect the table(s) being queried.
-      req->clear_ysql_catalog_version();
-    } else {
+    if (!SetupNextPage(read_op_->response(), read_op_->mutable_request())) {
       end_of_data_ = true;
     }
   } else {
@@ -302,6 +361,237 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
   }
 }
 
+void PgDocReadOp::ReadAhead() {
+  if (!has_response_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (is_canceled_) {
+    return;
+  }
+  ProcessResponseUnlocked();
+  if (end_of_data_ || waiting_for_response_ || !ShouldReadAheadUnlocked()) {
+    return;
+  }
+  exec_status_ = SendRequestUnlocked();
+  if (!exec_status_.ok()) {
+    end_of_data_ = true;
+    return;
+  }
+  read_ahead_in_flight_ = waiting_for_response_;
+}
+
+bool PgDocReadOp::ShouldReadAheadUnlocked() const {
+  return !is_canceled_ && exec_status_.ok() &&
+         exec_params_.limit_use_default && exec_params_.rowmark < 0 &&
+         result_cache_consumption_.consumption() < FLAGS_ysql_prefetch_buffer_size;
+}
+
+bool PgDocReadOp::PrepareRestartUnlocked() {
+  if (has_returned_data_) {
+    return false;
+  }
+
+  result_cache_.clear();
+  result_cache_consumption_.Reset(0);
+  has_cached_data_ = false;
+
+  PgsqlReadRequestPB* innermost_req = InnermostRequest(read_op_->mutable_request());
+  if (initial_paging_state_) {
+    *innermost_req->mutable_paging_state() = *initial_paging_state_;
+  } else {
+    innermost_req->clear_paging_state();
+  }
+
+  // Every partition is read again from the start of its tablet, and results buffered for
+  // partitions in earlier rounds are dropped with the partition reads.
+  if (!partition_reads_.empty()) {
+    partition_reads_.clear();
+    in_flight_partitions_.clear();
+    head_partition_ = 0;
+    started_partitions_ = 0;
+    InitPartitionReads();
+  }
+  return true;
+}
+
+bool PgDocReadOp::SetupNextPage(const PgsqlResponsePB& res, PgsqlReadRequestPB *req) {
+  if (!res.has_paging_state()) {
+    return false;
+  }
+
+  // Set up paging state for next request.
+  *InnermostRequest(req)->mutable_paging_state() = res.paging_state();
+  // Parse/Analysis/Rewrite catalog version has already been checked on the first request.
+  // The docdb layer will check the target table's schema version is compatible.
+  // This allows long-running queries to continue in the presence of other DDL statements
+  // as long as they do not affect the table(s) being queried.
+  req->clear_ysql_catalog_version();
+  return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool PgDocReadOp::CanReadPartitionsInParallel() const {
+  if (FLAGS_ysql_select_parallelism <= 1) {
+    return false;
+  }
+
+  // Only full-table forward scans without a statement LIMIT are split. Scans bound to a single
+  // hash value, lookups by ybctid and index scans are served by one tablet anyway, and a LIMIT
+  // would make us read more data than the statement needs.
+  const PgsqlReadRequestPB& req = read_op_->request();
+  if (!req.partition_column_values().empty() ||
+      !req.ybctid_column_value().value().binary_value().empty() ||
+      req.has_index_request() ||
+      req.has_paging_state() ||
+      !req.is_forward_scan() ||
+      !exec_params_.limit_use_default) {
+    return false;
+  }
+
+  const client::YBTable* table = read_op_->table();
+  return table->partition_schema().IsHashPartitioning() && table->GetPartitions()->size() > 1;
+}
+
+void PgDocReadOp::InitPartitionReads() {
+  const auto partitions_ptr = read_op_->table()->GetPartitions();
+  const std::vector<std::string>& partitions = *partitions_ptr;
+  partition_reads_.resize(partitions.size());
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    PartitionRead& partition_read = partition_reads_[i];
+    partition_read.read_op = read_op_->DeepCopy();
+    partition_read.partition_key_end = i + 1 < partitions.size() ? partitions[i + 1] : "";
+
+    // The scan of each partition starts from the beginning of its tablet. The first partition
+    // starts with an empty key which begins the scan at the first tablet.
+    PgsqlReadRequestPB *req = partition_read.read_op->mutable_request();
+    req->set_return_paging_state(true);
+    if (!partitions[i].empty()) {
+      req->mutable_paging_state()->set_next_partition_key(partitions[i]);
+    }
+  }
+  VLOG(1) << __PRETTY_FUNCTION__ << ": Reading " << partitions.size()
+          << " partitions with parallelism " << FLAGS_ysql_select_parallelism;
+}
+
+Status PgDocReadOp::SendPartitionRequestsUnlocked() {
+  const size_t parallelism = FLAGS_ysql_select_parallelism;
+  const bool ordered = FLAGS_ysql_parallel_scan_ordered;
+
+  // Start reading new partitions until the parallelism limit is reached.
+  size_t active_partitions = 0;
+  for (size_t i = head_partition_; i < started_partitions_; ++i) {
+    if (!partition_reads_[i].done) {
+      ++active_partitions;
+    }
+  }
+  while (active_partitions < parallelism && started_partitions_ < partition_reads_.size()) {
+    ++started_partitions_;
+    ++active_partitions;
+  }
+
+  in_flight_partitions_.clear();
+  for (size_t i = head_partition_; i < started_partitions_; ++i) {
+    PartitionRead& partition_read = partition_reads_[i];
+    // With ordered merge, a partition ahead of the head one does not fetch another page until its
+    // buffered results have been returned. This bounds the amount of buffered data.
+    if (partition_read.done ||
+        (ordered && i != head_partition_ && !partition_read.buffered_results.empty())) {
+      continue;
+    }
+    PgsqlReadRequestPB *req = partition_read.read_op->mutable_request();
+    SetRequestPrefetchLimit(req);
+    SetRowMark(req);
+    SCHECK_EQ(VERIFY_RESULT(pg_session_->PgApplyAsync(partition_read.read_op, &read_time_)),
+              OpBuffered::kFalse, IllegalState, "YSQL read operation should not be buffered");
+    in_flight_partitions_.push_back(i);
+  }
+  if (in_flight_partitions_.empty()) {
+    return Status::OK();
+  }
+
+  waiting_for_response_ = true;
+  Status s = pg_session_->PgFlushAsync([this](const Status& s) {
+                                         PgDocReadOp::ReceiveResponse(s);
+                                       });
+  if (!s.ok()) {
+    waiting_for_response_ = false;
+    return s;
+  }
+  return Status::OK();
+}
+
+void PgDocReadOp::ReceivePartitionResponsesUnlocked() {
+  // A restart reads all partitions from the start, so responses of the partitions that succeeded
+  // are dropped and fetched again.
+  if (exec_status_.ok()) {
+    for (size_t i : in_flight_partitions_) {
+      // A restart replaces the partition reads, so hold on to the op.
+      auto op = partition_reads_[i].read_op;
+      if (!op->succeeded()) {
+        if (CheckRestartUnlocked(op.get())) {
+          return;
+        }
+        break;
+      }
+    }
+  }
+
+  if (!exec_status_.ok() || is_canceled_) {
+    end_of_data_ = true;
+    return;
+  }
+
+  for (size_t i : in_flight_partitions_) {
+    PartitionRead& partition_read = partition_reads_[i];
+    const auto& op = partition_read.read_op;
+    if (!op->rows_data().empty()) {
+      partition_read.buffered_results.push_back(op->rows_data());
+      result_cache_consumption_.Add(partition_read.buffered_results.back().size());
+    }
+
+    // The paging state points to the next tablet once this one is exhausted. That tablet is read
+    // by its own partition read.
+    const PgsqlResponsePB& res = op->response();
+    if (!res.has_paging_state() ||
+        (!partition_read.partition_key_end.empty() &&
+         res.paging_state().next_partition_key() >= partition_read.partition_key_end)) {
+      partition_read.done = true;
+    } else {
+      SetupNextPage(res, op->mutable_request());
+    }
+  }
+  in_flight_partitions_.clear();
+
+  // A round could produce no results to return, e.g. when only partitions ahead of the head one
+  // responded with data. GetResult() then keeps reading.
+  MergePartitionResultsUnlocked();
+}
+
+void PgDocReadOp::MergePartitionResultsUnlocked() {
+  if (FLAGS_ysql_parallel_scan_ordered) {
+    while (head_partition_ < partition_reads_.size()) {
+      PartitionRead& partition_read = partition_reads_[head_partition_];
+      result_cache_.splice(result_cache_.end(), partition_read.buffered_results);
+      if (!partition_read.done) {
+        break;
+      }
+      ++head_partition_;
+    }
+  } else {
+    for (size_t i = head_partition_; i < started_partitions_; ++i) {
+      result_cache_.splice(result_cache_.end(), partition_reads_[i].buffered_results);
+    }
+    while (head_partition_ < started_partitions_ && partition_reads_[head_partition_].done) {
+      ++head_partition_;
+    }
+  }
+  has_cached_data_ = !result_cache_.empty();
+  end_of_data_ = head_partition_ == partition_reads_.size();
+}
+
 //--------------------------------------------------------------------------------------------------
 
 PgDocWriteOp::PgDocWriteOp(PgSession::ScopedRefPtr pg_session, client::YBPgsqlWriteOp *write_op)
@@ -15,10 +15,14 @@
 #ifndef YB_YQL_PGGATE_PG_DOC_OP_H_
 #define YB_YQL_PGGATE_PG_DOC_OP_H_
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 
+#include <boost/optional.hpp>
+
 #include "yb/util/locks.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/client/yb_op.h"
 #include "yb/yql/pggate/pg_session.h"
 
@@ -52,6 +56,11 @@ class PgDocOp {
   // Get the result of the op.
   virtual CHECKED_STATUS GetResult(string *result_set);
 
+  // Processes a response that arrived while the caller consumes the last result, and sends the
+  // request for the next page if the op reads ahead. Must be called on the thread that executes
+  // the op. Errors are returned by the next GetResult().
+  virtual void ReadAhead() {}
+
   // Access functions.
   Status exec_status() {
     return exec_status_;
@@ -71,13 +80,28 @@ class PgDocOp {
   void ReadFromCacheUnlocked(string* result);
 
   // Send another request if no request is pending and we've already consumed
-  // all data in the cache.
+  // all data in the cache, or the op reads ahead and the cache is below its memory budget.
   CHECKED_STATUS SendRequestIfNeededUnlocked();
 
+  // Whether the next request could be sent while there is still unconsumed data in the cache.
+  virtual bool ShouldReadAheadUnlocked() const {
+    return false;
+  }
+
+  // Processes a response that was received but left for the thread reading the results. Called
+  // with mtx_ held by the thread that executes the op, before it reads from the cache.
+  virtual void ProcessResponseUnlocked() {}
+
   // Checks whether op causes restart. Could set exec_status_.
   // Returns true is restart was initiated;
   bool CheckRestartUnlocked(client::YBPgsqlOp* op);
 
+  // Prepares the op to be resent at the new read time of a restarted transaction. Returns false if
+  // the op cannot be restarted.
+  virtual bool PrepareRestartUnlocked() {
+    return true;
+  }
+
   // Session control.
   PgSession::ScopedRefPtr pg_session_;
   const PreventRestart prevent_restart_;
@@ -98,18 +122,28 @@ class PgDocOp {
   // request can be sent to DocDB at a time.
   bool waiting_for_response_ = false;
 
+  // Whether the request in flight was sent ahead of the consumption of cached results, rather than
+  // on behalf of a caller that waits for it.
+  bool read_ahead_in_flight_ = false;
+
   // Whether all requested data by the statement has been received or there's a run-time error.
   bool end_of_data_ = false;
 
   // Whether or not result_cache_ is empty().
   bool has_cached_data_ = false;
 
+  // Whether any results have been returned by GetResult() since the op was executed.
+  bool has_returned_data_ = false;
+
   // Whether or not the statement has been canceled by application / users.
   bool is_canceled_ = false;
 
   // Caching state variables.
   std::list<string> result_cache_;
 
+  // Memory consumed by results that have been received but not yet read from the cache.
+  ScopedTrackedConsumption result_cache_consumption_;
+
   // Exec control parameters.
   PgExecParameters exec_params_;
 
@@ -140,18 +174,97 @@ class PgDocReadOp : public PgDocOp {
 
  private:
   // Process response from DocDB.
+  // PgSession is not thread-safe, so the response callback only stores the response. It is
+  // processed by ProcessResponseUnlocked(), and any further request is sent, on the thread that
+  // executes the op and reads its results.
   void InitUnlocked(std::unique_lock<std::mutex>* lock) override;
   CHECKED_STATUS SendRequestUnlocked() override;
   virtual void ReceiveResponse(Status exec_status);
+  void ProcessResponseUnlocked() override;
+  void ReadAhead() override;
+
+  // To overlap fetching with the consumption of results, the request for the next page is sent
+  // when results are returned from the cache, and by ReadAhead() when a page arrives while the
+  // caller consumes results, while the amount of buffered results is below
+  // FLAGS_ysql_prefetch_buffer_size. Statements with a LIMIT or a row mark do not read ahead, as
+  // they would read or lock rows the statement does not need.
+  bool ShouldReadAheadUnlocked() const override;
+
+  // A restart drops the results read at the old read time and reads from the start of the scan
+  // again. It is refused once results have been returned, as they could not be taken back.
+  bool PrepareRestartUnlocked() override;
 
   // Analyze options and pick the appropriate prefetch limit.
-  void SetRequestPrefetchLimit();
+  void SetRequestPrefetchLimit(PgsqlReadRequestPB *req);
+
+  // Set the row_mark_type field of a read request based on our exec control parameter.
+  void SetRowMark(PgsqlReadRequestPB *req);
+
+  // Set up paging state of the given request for the next batch of data based on the response.
+  // Returns false if there is no more data to read.
+  bool SetupNextPage(const PgsqlResponsePB& res, PgsqlReadRequestPB *req);
+
+  //------------------------------------------------------------------------------------------------
+  // Parallel multi-tablet scan.
+  // A full-table scan of a hash-partitioned table is split into one read operation per tablet.
+  // Up to FLAGS_ysql_select_parallelism of these operations are sent in the same flush, and the
+  // next round is sent once all of them have responded. A round is as slow as its slowest tablet,
+  // even when the other tablets could already be read further. When FLAGS_ysql_parallel_scan_ordered is
+  // set, results are returned in tablet order and tablets ahead of the current one keep at most
+  // one page of buffered results.
 
-  // Set the row_mark_type field of our read request based on our exec control parameter.
-  void SetRowMark();
+  // Whether the current read request can be split into per-tablet read operations.
+  bool CanReadPartitionsInParallel() const;
+
+  // Create the per-tablet read operations from read_op_.
+  void InitPartitionReads();
+
+  CHECKED_STATUS SendPartitionRequestsUnlocked();
+  void ReceivePartitionResponsesUnlocked();
+
+  // Move buffered results of the partitions that are ready to be returned into result_cache_.
+  void MergePartitionResultsUnlocked();
+
+  struct PartitionRead {
+    std::shared_ptr<client::YBPgsqlReadOp> read_op;
+
+    // Exclusive end key of the partition. Empty for the last partition.
+    std::string partition_key_end;
+
+    // Results received from this partition that have not been moved to result_cache_ yet.
+    std::list<string> buffered_results;
+
+    // Whether all data of this partition has been received.
+    bool done = false;
+  };
+
+  // Per-tablet read operations. Empty when the scan reads tablets one at a time.
+  std::vector<PartitionRead> partition_reads_;
+
+  // Index of the first partition whose results are not yet completely returned.
+  size_t head_partition_ = 0;
+
+  // Number of partitions that a request has been sent to at least once.
+  size_t started_partitions_ = 0;
+
+  // Partitions that are part of the request that is currently in flight.
+  std::vector<size_t> in_flight_partitions_;
 
   // Operator.
   std::shared_ptr<client::YBPgsqlReadOp> read_op_;
+
+  // Paging state of the innermost request of read_op_ when the op was executed, used to read from
+  // the start of the scan again on restart.
+  boost::optional<PgsqlPagingStatePB> initial_paging_state_;
+
+  // Whether a response has been received and not processed yet, and its status. has_response_ is
+  // checked without the lock by ReadAhead(), which is called for every fetched row.
+  std::atomic<bool> has_response_{false};
+  Status response_status_;
+
+  // Size of the results in the unprocessed response. They are accounted in
+  // result_cache_consumption_ as soon as they are received.
+  size_t response_bytes_ = 0;
 };
 
 class PgDocWriteOp : public PgDocOp {
@@ -15,6 +15,7 @@
 
 #include "yb/yql/pggate/pg_select.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/client/yb_op.h"
 #include "yb/docdb/primitive_value.h"
 
@@ -53,6 +54,7 @@ Status PgSelect::Prepare(PreventRestart prevent_restart) {
   auto doc_op = make_shared<PgDocReadOp>(
       pg_session_, prevent_restart, table_desc_->NewPgsqlSelect());
   read_req_ = doc_op->read_op()->mutable_request();
+  read_req_->set_columnar_result(FLAGS_ysql_enable_columnar_results);
   if (index_id_.IsValid()) {
     index_req_ = read_req_->mutable_index_request();
     index_req_->set_table_id(index_id_.GetYBTableId());
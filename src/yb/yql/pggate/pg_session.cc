@@ -102,12 +102,14 @@ PgSession::PgSession(
     const string& database_name,
     scoped_refptr<PgTxnManager> pg_txn_manager,
     scoped_refptr<server::HybridClock> clock,
-    const tserver::TServerSharedObject* tserver_shared_object)
+    const tserver::TServerSharedObject* tserver_shared_object,
+    const std::shared_ptr<MemTracker>& mem_tracker)
     : client_(client),
       session_(client_->NewSession()),
       pg_txn_manager_(std::move(pg_txn_manager)),
       clock_(std::move(clock)),
-      tserver_shared_object_(tserver_shared_object) {
+      tserver_shared_object_(tserver_shared_object),
+      prefetch_mem_tracker_(MemTracker::FindOrCreateTracker("Prefetch", mem_tracker)) {
   session_->SetTimeout(MonoDelta::FromMilliseconds(FLAGS_pg_yb_session_timeout_ms));
   session_->SetForceConsistentRead(client::ForceConsistentRead::kTrue);
 }
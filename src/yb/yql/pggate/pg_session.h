@@ -23,6 +23,7 @@
 
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/callback.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/oid_generator.h"
 #include "yb/util/result.h"
 
@@ -57,7 +58,8 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
             const string& database_name,
             scoped_refptr<PgTxnManager> pg_txn_manager,
             scoped_refptr<server::HybridClock> clock,
-            const tserver::TServerSharedObject* tserver_shared_object);
+            const tserver::TServerSharedObject* tserver_shared_object,
+            const std::shared_ptr<MemTracker>& mem_tracker);
   virtual ~PgSession();
 
   //------------------------------------------------------------------------------------------------
@@ -198,6 +200,9 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   PgTxnManager* pg_txn_manager() { return pg_txn_manager_.get(); }
 
+  // Memory tracker for results that have been fetched from DocDB ahead of being consumed.
+  const std::shared_ptr<MemTracker>& prefetch_mem_tracker() const { return prefetch_mem_tracker_; }
+
  private:
   // Returns the appropriate session to use, in most cases the one used by the current transaction.
   // read_only_op - whether this is being done in the context of a read-only operation. For
@@ -256,6 +261,8 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   bool has_row_mark_ = false;
 
   const tserver::TServerSharedObject* const tserver_shared_object_;
+
+  std::shared_ptr<MemTracker> prefetch_mem_tracker_;
 };
 
 }  // namespace pggate
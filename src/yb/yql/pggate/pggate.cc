@@ -171,7 +171,8 @@ Status PgApiImpl::CreateSession(const PgEnv *pg_env,
                                 const string& database_name,
                                 PgSession **pg_session) {
   auto session = make_scoped_refptr<PgSession>(
-      client(), database_name, pg_txn_manager_, clock_, tserver_shared_object_.get());
+      client(), database_name, pg_txn_manager_, clock_, tserver_shared_object_.get(),
+      mem_tracker_);
   if (!database_name.empty()) {
     RETURN_NOT_OK(session->ConnectDatabase(database_name));
   }
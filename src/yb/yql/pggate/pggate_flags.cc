@@ -51,10 +51,30 @@ DEFINE_int32(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_int32(ysql_select_parallelism, 1,
+             "Maximum number of tablets that a full-table scan of a hash-partitioned table reads "
+             "from concurrently. A value of 1 or less reads the tablets one at a time");
+
+DEFINE_bool(ysql_parallel_scan_ordered, true,
+            "Whether a parallel full-table scan returns rows in tablet order. When false, rows "
+            "are returned as soon as any tablet responds");
+
+DEFINE_int64(ysql_prefetch_buffer_size, 0,
+             "Read-ahead budget of a YSQL scan, in bytes. While the rows that were fetched but "
+             "not yet consumed by the statement take less than this, the request for the next "
+             "page is sent when a page is handed to the statement, without waiting for the "
+             "statement to consume the cached rows, so the buffered rows can exceed the budget by "
+             "at most one page. Scans with a LIMIT or that lock rows do not read ahead. 0 "
+             "disables read-ahead");
+
 DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
 
+DEFINE_bool(ysql_enable_columnar_results, false,
+            "Request rows of YSQL SELECT statements in columnar format from DocDB. Rows are "
+            "still passed to the PostgreSQL executor one at a time.");
+
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
@@ -25,7 +25,11 @@ DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_bool(pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
+DECLARE_int32(ysql_select_parallelism);
+DECLARE_int64(ysql_prefetch_buffer_size);
+DECLARE_bool(ysql_parallel_scan_ordered);
 DECLARE_int32(ysql_session_max_batch_size);
+DECLARE_bool(ysql_enable_columnar_results);
 DECLARE_bool(ysql_non_txn_copy);
 DECLARE_int32(ysql_max_read_restart_attempts);
 DECLARE_int32(ysql_output_buffer_size);
@@ -13,15 +13,78 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <set>
+
 #include "yb/yql/pggate/test/pggate_test.h"
 #include "yb/common/ybc-internal.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/size_literals.h"
+#include "yb/yql/pggate/pggate_flags.h"
 
 namespace yb {
 namespace pggate {
 
 class PggateTestSelectMultiTablets : public PggateTest {
+ protected:
+  // Creates a table with an INT64 hash column and an INT32 range column, and inserts row_count
+  // rows that have the values 0 to row_count - 1 in both columns.
+  void CreateAndFillTable(const char *tabname, YBCPgOid tab_oid, int row_count);
+
+  // Executes SELECT of both columns of a table created by CreateAndFillTable().
+  void ExecSelectAll(YBCPgOid tab_oid, YBCPgStatement *pg_stmt);
+
+  static constexpr int kColumnCount = 2;
 };
 
+void PggateTestSelectMultiTablets::CreateAndFillTable(
+    const char *tabname, YBCPgOid tab_oid, int row_count) {
+  YBCPgStatement pg_stmt;
+
+  // Create table in the connected database.
+  int col_count = 0;
+  CHECK_YBC_STATUS(YBCPgNewCreateTable(pg_session_, kDefaultDatabase, kDefaultSchema, tabname,
+                                       kDefaultDatabaseOid, tab_oid,
+                                       false /* is_shared_table */, true /* if_not_exist */,
+                                       false /* add_primary_key */, &pg_stmt));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "hash_key", ++col_count,
+                                             DataType::INT64, true, true));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "id", ++col_count,
+                                             DataType::INT32, false, true));
+  CHECK_EQ(col_count, kColumnCount);
+  CHECK_YBC_STATUS(YBCPgExecCreateTable(pg_stmt));
+  CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+  pg_stmt = nullptr;
+
+  // INSERT ----------------------------------------------------------------------------------------
+  CHECK_YBC_STATUS(YBCPgNewInsert(pg_session_, kDefaultDatabaseOid, tab_oid,
+                                  false /* is_single_row_txn */, &pg_stmt));
+  YBCPgExpr expr_hash;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, 0, false, &expr_hash));
+  YBCPgExpr expr_id;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt4(pg_stmt, 0, false, &expr_id));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, 1, expr_hash));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, 2, expr_id));
+
+  for (int i = 0; i < row_count; i++) {
+    YBCPgUpdateConstInt8(expr_hash, i, false);
+    YBCPgUpdateConstInt4(expr_id, i, false);
+    CHECK_YBC_STATUS(YBCPgExecInsert(pg_stmt));
+    CommitTransaction();
+  }
+  CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+}
+
+void PggateTestSelectMultiTablets::ExecSelectAll(YBCPgOid tab_oid, YBCPgStatement *pg_stmt) {
+  CHECK_YBC_STATUS(YBCPgNewSelect(pg_session_, kDefaultDatabaseOid, tab_oid, kInvalidOid,
+                                  true /* prevent_restart */, pg_stmt));
+  YBCPgExpr colref;
+  YBCTestNewColumnRef(*pg_stmt, 1, DataType::INT64, &colref);
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(*pg_stmt, colref));
+  YBCTestNewColumnRef(*pg_stmt, 2, DataType::INT32, &colref);
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(*pg_stmt, colref));
+  CHECK_YBC_STATUS(YBCPgExecSelect(*pg_stmt, nullptr /* exec_params */));
+}
+
 TEST_F(PggateTestSelectMultiTablets, TestSelectMultiTablets) {
   CHECK_OK(Init("TestSelectMultiTablet"));
 
@@ -272,5 +335,118 @@ TEST_F(PggateTestSelectMultiTablets, TestSelectMultiTablets) {
   pg_stmt = nullptr;
 }
 
+TEST_F(PggateTestSelectMultiTablets, TestParallelScan) {
+  CHECK_OK(Init("TestParallelScan"));
+
+  const YBCPgOid tab_oid = 3;
+  const int insert_row_count = 100;
+  CreateAndFillTable("parallel_scan_table", tab_oid, insert_row_count);
+
+  // SELECT ----------------------------------------------------------------------------------------
+  auto select_all_rows = [&] {
+    YBCPgStatement pg_stmt;
+    ExecSelectAll(tab_oid, &pg_stmt);
+
+    uint64_t *values = static_cast<uint64_t*>(YBCPAlloc(kColumnCount * sizeof(uint64_t)));
+    bool *isnulls = static_cast<bool*>(YBCPAlloc(kColumnCount * sizeof(bool)));
+    std::set<int64_t> selected_ids;
+    bool has_data = true;
+    while (true) {
+      YBCPgDmlFetch(pg_stmt, kColumnCount, values, isnulls, nullptr, &has_data);
+      if (!has_data) {
+        break;
+      }
+      CHECK_EQ(values[0], values[1]);
+      CHECK(selected_ids.insert(values[0]).second) << "Duplicate row " << values[0];
+    }
+    CHECK_EQ(selected_ids.size(), static_cast<size_t>(insert_row_count))
+        << "Not all inserted rows are fetched";
+
+    CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+  };
+
+  // Use a small prefetch limit so that every tablet is read in several pages.
+  FLAGS_ysql_prefetch_limit = 7;
+  FLAGS_ysql_select_parallelism = 2;
+  for (bool ordered : {true, false}) {
+    LOG(INFO) << "Test parallel full-table scan, ordered: " << ordered;
+    FLAGS_ysql_parallel_scan_ordered = ordered;
+    select_all_rows();
+  }
+
+  LOG(INFO) << "Test full-table scan with columnar results";
+  FLAGS_ysql_select_parallelism = 1;
+  FLAGS_ysql_enable_columnar_results = true;
+  select_all_rows();
+}
+
+TEST_F(PggateTestSelectMultiTablets, TestReadAhead) {
+  CHECK_OK(Init("TestReadAhead"));
+
+  const YBCPgOid tab_oid = 3;
+  const int insert_row_count = 100;
+  CreateAndFillTable("read_ahead_table", tab_oid, insert_row_count);
+
+  // SELECT ----------------------------------------------------------------------------------------
+  // Results that were received but not fetched yet are accounted to the Prefetch tracker.
+  auto prefetch_tracker = MemTracker::FindTracker(
+      "Prefetch", MemTracker::FindTracker("PostgreSQL"));
+  ASSERT_NE(prefetch_tracker, nullptr);
+
+  uint64_t *values = static_cast<uint64_t*>(YBCPAlloc(kColumnCount * sizeof(uint64_t)));
+  bool *isnulls = static_cast<bool*>(YBCPAlloc(kColumnCount * sizeof(bool)));
+  std::set<int64_t> selected_ids;
+  auto fetch_row = [&](YBCPgStatement pg_stmt) {
+    bool has_data = false;
+    CHECK_YBC_STATUS(YBCPgDmlFetch(pg_stmt, kColumnCount, values, isnulls, nullptr, &has_data));
+    if (has_data) {
+      CHECK_EQ(values[0], values[1]);
+      CHECK(selected_ids.insert(values[0]).second) << "Duplicate row " << values[0];
+    }
+    return has_data;
+  };
+
+  // Fetches the rows of the first page of an executed select, giving the pages requested in the
+  // meantime time to arrive. Returns the number of bytes buffered after that, relative to the size
+  // of the first page.
+  auto buffered_pages_while_consuming_first_page = [&](YBCPgStatement pg_stmt) {
+    CHECK_OK(WaitFor([&] { return prefetch_tracker->consumption() > 0; },
+                     MonoDelta::FromSeconds(30), "First page received"));
+    const double page_bytes = prefetch_tracker->consumption();
+    for (int i = 0; i < FLAGS_ysql_prefetch_limit; ++i) {
+      CHECK(fetch_row(pg_stmt));
+      SleepFor(MonoDelta::FromMilliseconds(500));
+    }
+    return prefetch_tracker->consumption() / page_bytes;
+  };
+
+  // Use a small prefetch limit so that the table is read in many pages, one tablet at a time.
+  FLAGS_ysql_prefetch_limit = 7;
+  FLAGS_ysql_select_parallelism = 1;
+
+  // Without read-ahead only the next page is requested while a page is consumed.
+  LOG(INFO) << "Test SELECT without read-ahead";
+  FLAGS_ysql_prefetch_buffer_size = 0;
+  YBCPgStatement pg_stmt;
+  ExecSelectAll(tab_oid, &pg_stmt);
+  ASSERT_LE(buffered_pages_while_consuming_first_page(pg_stmt), 1);
+  CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+  selected_ids.clear();
+
+  // With read-ahead, every page that arrives while the first one is consumed requests the next.
+  LOG(INFO) << "Test SELECT with read-ahead";
+  FLAGS_ysql_prefetch_buffer_size = 1_MB;
+  ExecSelectAll(tab_oid, &pg_stmt);
+  ASSERT_GT(buffered_pages_while_consuming_first_page(pg_stmt), 1);
+
+  while (fetch_row(pg_stmt)) {
+  }
+  CHECK_EQ(selected_ids.size(), static_cast<size_t>(insert_row_count))
+      << "Not all inserted rows are fetched";
+  ASSERT_EQ(prefetch_tracker->consumption(), 0);
+
+  CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+}
+
 } // namespace pggate
 } // namespace yb
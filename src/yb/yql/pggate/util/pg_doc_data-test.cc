@@ -0,0 +1,191 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/yql/pggate/util/pg_doc_data.h"
+
+#include <limits>
+
+#include "yb/common/ql_value.h"
+#include "yb/gutil/endian.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace pggate {
+
+namespace {
+
+// Offset of the first column in columnar data: marker, row count and column count.
+constexpr size_t kColumnsOffset = 2 * sizeof(int64_t) + sizeof(uint32_t);
+
+// Adds a row with an int64, a string and an int32 column. Negative values are stored as nulls.
+void AddRow(int64_t id, const char* name, int32_t count, PgsqlResultSet* tuples) {
+  PgsqlRSRow* row = tuples->AllocateRSRow(3);
+  if (id >= 0) {
+    row->rscol(0)->set_int64_value(id);
+  }
+  if (name != nullptr) {
+    row->rscol(1)->set_string_value(name);
+  }
+  if (count >= 0) {
+    row->rscol(2)->set_int32_value(count);
+  }
+}
+
+// Checks that the columnar batch has the same values as the row-oriented encoding of the tuples.
+void CheckBatch(const PgsqlResultSet& tuples, const PgColumnarBatch& batch) {
+  ASSERT_EQ(static_cast<size_t>(batch.row_count()), tuples.rsrow_count());
+  for (size_t row = 0; row != tuples.rsrow_count(); ++row) {
+    const PgsqlRSRow& tuple = tuples.rsrows()[row];
+    ASSERT_EQ(batch.column_count(), tuple.rscol_count());
+    for (size_t column = 0; column != tuple.rscol_count(); ++column) {
+      SCOPED_TRACE(Format("Row $0, column $1", row, column));
+      const QLValue& value = tuple.rscol_value(column);
+      ASSERT_EQ(batch.GetHeader(column, row).is_null(), value.IsNull());
+      if (value.IsNull()) {
+        ASSERT_TRUE(batch.GetValue(column, row).empty());
+        continue;
+      }
+      // The row-oriented encoding is a data header followed by the value.
+      faststring expected;
+      ASSERT_OK(PgDocData::WriteColumn(value, &expected));
+      ASSERT_EQ(batch.GetValue(column, row).ToBuffer(),
+                Slice(expected.data() + 1, expected.size() - 1).ToBuffer());
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PgDocDataTest, ColumnarRoundTrip) {
+  PgsqlResultSet tuples;
+  AddRow(1, "one", 10, &tuples);
+  AddRow(2, nullptr, 20, &tuples);
+  AddRow(-1, "", -1, &tuples);
+  // More than 8 rows, so the null bitmaps take more than one byte.
+  for (int64_t i = 3; i != 12; ++i) {
+    AddRow(i, i % 3 == 0 ? nullptr : "value", i % 2 == 0 ? -1 : i * 10, &tuples);
+  }
+
+  faststring buffer;
+  ASSERT_OK(PgDocData::WriteColumnarTuples(tuples, &buffer));
+  const string data = buffer.ToString();
+  ASSERT_TRUE(PgDocData::IsColumnarData(data));
+
+  PgColumnarBatch batch;
+  ASSERT_OK(batch.Load(data));
+  ASSERT_NO_FATALS(CheckBatch(tuples, batch));
+
+  // Row-oriented data is not mistaken for columnar data.
+  buffer.clear();
+  ASSERT_OK(PgDocData::WriteTuples(tuples, &buffer));
+  ASSERT_FALSE(PgDocData::IsColumnarData(buffer.ToString()));
+  ASSERT_NOK(batch.Load(buffer.ToString()));
+}
+
+TEST(PgDocDataTest, ColumnarNulls) {
+  PgsqlResultSet tuples;
+  AddRow(1, nullptr, -1, &tuples);
+  AddRow(-1, nullptr, -1, &tuples);
+
+  faststring buffer;
+  ASSERT_OK(PgDocData::WriteColumnarTuples(tuples, &buffer));
+  PgColumnarBatch batch;
+  ASSERT_OK(batch.Load(buffer.ToString()));
+  ASSERT_NO_FATALS(CheckBatch(tuples, batch));
+
+  // Columns that have only nulls take a type byte and a null bitmap each.
+  const size_t int64_column_size = 1 + 1 + 2 * sizeof(int64_t);
+  ASSERT_EQ(buffer.size(), kColumnsOffset + int64_column_size + 2 * 2);
+}
+
+TEST(PgDocDataTest, ColumnarEmpty) {
+  PgsqlResultSet tuples;
+  faststring buffer;
+  ASSERT_OK(PgDocData::WriteColumnarTuples(tuples, &buffer));
+  PgColumnarBatch batch;
+  ASSERT_OK(batch.Load(buffer.ToString()));
+  ASSERT_EQ(batch.row_count(), 0);
+  ASSERT_EQ(batch.column_count(), 0U);
+}
+
+TEST(PgDocDataTest, ColumnarMixedTypes) {
+  PgsqlResultSet tuples;
+  AddRow(1, "one", 10, &tuples);
+  tuples.AllocateRSRow(3)->rscol(0)->set_string_value("two");
+
+  faststring buffer;
+  auto status = PgDocData::WriteColumnarTuples(tuples, &buffer);
+  ASSERT_TRUE(status.IsCorruption()) << status;
+}
+
+TEST(PgDocDataTest, ColumnarCorruption) {
+  // A single string column, so the layout of the data is known:
+  // type, null bitmap, size of the data buffer, offsets of the rows and the data buffer.
+  PgsqlResultSet tuples;
+  for (const char* name : {"one", "two", "three"}) {
+    tuples.AllocateRSRow(1)->rscol(0)->set_string_value(name);
+  }
+  faststring buffer;
+  ASSERT_OK(PgDocData::WriteColumnarTuples(tuples, &buffer));
+  const string data = buffer.ToString();
+  const size_t values_size_offset = kColumnsOffset + 1 + 1;
+  const size_t offsets_offset = values_size_offset + sizeof(uint32_t);
+  const uint32_t values_size = NetworkByteOrder::Load32(data.data() + values_size_offset);
+
+  PgColumnarBatch batch;
+  ASSERT_OK(batch.Load(data));
+
+  auto check_corruption = [&batch](const string& corrupted) {
+    auto status = batch.Load(corrupted);
+    ASSERT_TRUE(status.IsCorruption()) << status;
+  };
+
+  auto with_offset = [&](size_t row, uint32_t offset) {
+    string corrupted = data;
+    NetworkByteOrder::Store32(&corrupted[offsets_offset + row * sizeof(uint32_t)], offset);
+    return corrupted;
+  };
+
+  // Offset past the end of the data buffer.
+  ASSERT_NO_FATALS(check_corruption(with_offset(1, values_size + 1)));
+  ASSERT_NO_FATALS(check_corruption(with_offset(2, std::numeric_limits<uint32_t>::max())));
+  // Decreasing offsets.
+  ASSERT_NO_FATALS(check_corruption(with_offset(0, NetworkByteOrder::Load32(
+      data.data() + offsets_offset + sizeof(uint32_t)) + 1)));
+
+  // Data buffer larger than the remaining data.
+  {
+    string corrupted = data;
+    NetworkByteOrder::Store32(&corrupted[values_size_offset], values_size + 1);
+    ASSERT_NO_FATALS(check_corruption(corrupted));
+  }
+
+  // Row count that does not fit into the data.
+  {
+    string corrupted = data;
+    NetworkByteOrder::Store64(&corrupted[sizeof(int64_t)], 1ULL << 40);
+    ASSERT_NO_FATALS(check_corruption(corrupted));
+    NetworkByteOrder::Store64(&corrupted[sizeof(int64_t)], static_cast<uint64_t>(-1));
+    ASSERT_NO_FATALS(check_corruption(corrupted));
+  }
+
+  // Truncated data.
+  for (size_t size : {size_t(0), kColumnsOffset - 1, offsets_offset, data.size() - 1}) {
+    SCOPED_TRACE(Format("Size: $0", size));
+    ASSERT_NO_FATALS(check_corruption(data.substr(0, size)));
+  }
+}
+
+}  // namespace pggate
+}  // namespace yb
@@ -60,6 +60,10 @@ Status PgDocData::WriteColumn(const QLValue& col_value, faststring *buffer) {
     return Status::OK();
   }
 
+  return WriteColumnValue(col_value, buffer);
+}
+
+Status PgDocData::WriteColumnValue(const QLValue& col_value, faststring *buffer) {
   switch (col_value.type()) {
     case InternalType::VALUE_NOT_SET:
       break;
@@ -124,6 +128,65 @@ Status PgDocData::WriteColumn(const QLValue& col_value, faststring *buffer) {
   return Status::OK();
 }
 
+Status PgDocData::WriteColumnarTuples(const PgsqlResultSet& tuples, faststring *buffer) {
+  const std::vector<PgsqlRSRow>& rows = tuples.rsrows();
+  const size_t row_count = rows.size();
+  const size_t column_count = row_count == 0 ? 0 : rows.front().rscols().size();
+
+  WriteInt64(kColumnarDataMarker, buffer);
+  WriteInt64(row_count, buffer);
+  WriteUint32(column_count, buffer);
+
+  faststring values;
+  for (size_t column = 0; column < column_count; ++column) {
+    // All non-null values of a column have the same type.
+    InternalType type = InternalType::VALUE_NOT_SET;
+    std::vector<uint8_t> null_bitmap((row_count + 7) / 8, 0);
+    for (size_t row = 0; row < row_count; ++row) {
+      const QLValue& value = rows[row].rscol_value(column);
+      if (value.IsNull()) {
+        null_bitmap[row / 8] |= 1 << (row % 8);
+      } else if (type == InternalType::VALUE_NOT_SET) {
+        type = value.type();
+      } else if (type != value.type()) {
+        return STATUS_FORMAT(Corruption, "Column $0 has values of types $1 and $2",
+                             column, type, value.type());
+      }
+    }
+    WriteUint8(static_cast<uint8_t>(type), buffer);
+    buffer->append(null_bitmap.data(), null_bitmap.size());
+
+    const size_t value_size = PgColumnarBatch::FixedValueSize(type);
+    if (value_size != 0 || type == InternalType::VALUE_NOT_SET) {
+      for (size_t row = 0; row < row_count; ++row) {
+        const QLValue& value = rows[row].rscol_value(column);
+        if (value.IsNull()) {
+          buffer->resize(buffer->size() + value_size);
+          memset(buffer->data() + buffer->size() - value_size, 0, value_size);
+        } else {
+          RETURN_NOT_OK(WriteColumnValue(value, buffer));
+        }
+      }
+      continue;
+    }
+
+    // Variable-length values: offsets followed by the data buffer.
+    values.clear();
+    faststring offsets;
+    for (size_t row = 0; row < row_count; ++row) {
+      WriteUint32(values.size(), &offsets);
+      const QLValue& value = rows[row].rscol_value(column);
+      if (!value.IsNull()) {
+        RETURN_NOT_OK(WriteColumnValue(value, &values));
+      }
+    }
+    WriteUint32(values.size(), buffer);
+    buffer->append(offsets.data(), offsets.size());
+    buffer->append(values.data(), values.size());
+  }
+  return Status::OK();
+}
+
 //--------------------------------------------------------------------------------------------------
 // Read Tuple Routine in DocDB Format (wire_protocol).
 //--------------------------------------------------------------------------------------------------
@@ -151,5 +214,134 @@ PgWireDataHeader PgDocData::ReadDataHeader(Slice *cursor) {
   return PgWireDataHeader(header_data);
 }
 
+bool PgDocData::IsColumnarData(const string& data) {
+  if (data.size() < sizeof(int64_t)) {
+    return false;
+  }
+  Slice cursor(data);
+  int64_t marker;
+  ReadNumber(&cursor, &marker);
+  return marker == kColumnarDataMarker;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Columnar Batch.
+//--------------------------------------------------------------------------------------------------
+
+size_t PgColumnarBatch::FixedValueSize(InternalType type) {
+  switch (type) {
+    case InternalType::kBoolValue:
+      return sizeof(bool);
+    case InternalType::kInt8Value:
+      return sizeof(int8_t);
+    case InternalType::kInt16Value:
+      return sizeof(int16_t);
+    case InternalType::kInt32Value:
+    case InternalType::kUint32Value:
+    case InternalType::kFloatValue:
+      return sizeof(int32_t);
+    case InternalType::kInt64Value:
+    case InternalType::kUint64Value:
+    case InternalType::kDoubleValue:
+      return sizeof(int64_t);
+    default:
+      return 0;
+  }
+}
+
+Status PgColumnarBatch::Load(const string& data) {
+  Clear();
+  Slice cursor(data);
+
+  auto ensure_size = [&cursor](size_t size) -> Status {
+    if (cursor.size() < size) {
+      return STATUS_FORMAT(Corruption, "Columnar data is truncated: $0 bytes left, $1 expected",
+                           cursor.size(), size);
+    }
+    return Status::OK();
+  };
+
+  int64_t marker;
+  RETURN_NOT_OK(ensure_size(2 * sizeof(int64_t) + sizeof(uint32_t)));
+  cursor.remove_prefix(PgDocData::ReadNumber(&cursor, &marker));
+  SCHECK_EQ(marker, PgDocData::kColumnarDataMarker, Corruption, "Data is not in columnar format");
+  int64_t row_count;
+  cursor.remove_prefix(PgDocData::ReadNumber(&cursor, &row_count));
+  uint32_t column_count;
+  cursor.remove_prefix(PgDocData::ReadNumber(&cursor, &column_count));
+  SCHECK_GE(row_count, 0, Corruption, "Negative row count in columnar data");
+  // Each column has at least one null bit per row, so the row count is limited by the data size.
+  // That also keeps sizes computed from the row count below from overflowing.
+  if (column_count != 0 && static_cast<uint64_t>(row_count) > cursor.size() * 8) {
+    return STATUS_FORMAT(Corruption, "Row count $0 does not fit into $1 bytes of columnar data",
+                         row_count, cursor.size());
+  }
+
+  const size_t null_bitmap_size = (row_count + 7) / 8;
+  columns_.reserve(column_count);
+  for (uint32_t i = 0; i != column_count; ++i) {
+    Column column;
+    RETURN_NOT_OK(ensure_size(sizeof(uint8_t) + null_bitmap_size));
+    uint8_t type;
+    cursor.remove_prefix(PgDocData::ReadNumber(&cursor, &type));
+    column.type = static_cast<InternalType>(type);
+    column.null_bitmap = cursor.data();
+    cursor.remove_prefix(null_bitmap_size);
+
+    column.value_size = FixedValueSize(column.type);
+    if (column.value_size != 0 || column.type == InternalType::VALUE_NOT_SET) {
+      column.offsets = nullptr;
+      column.values_size = column.value_size * row_count;
+    } else {
+      RETURN_NOT_OK(ensure_size(sizeof(uint32_t) * (row_count + 1)));
+      uint32_t values_size;
+      cursor.remove_prefix(PgDocData::ReadNumber(&cursor, &values_size));
+      column.offsets = cursor.data();
+      cursor.remove_prefix(sizeof(uint32_t) * row_count);
+      column.values_size = values_size;
+      // GetValue() reads the data buffer between adjacent offsets, so they should not decrease
+      // and should not point past the end of the buffer.
+      uint32_t prev_offset = 0;
+      for (int64_t row = 0; row != row_count; ++row) {
+        const uint32_t offset = GetOffset(column, row);
+        if (offset < prev_offset || offset > values_size) {
+          return STATUS_FORMAT(
+              Corruption, "Invalid offset $0 of row $1 in column $2, previous: $3, data size: $4",
+              offset, row, i, prev_offset, values_size);
+        }
+        prev_offset = offset;
+      }
+    }
+    RETURN_NOT_OK(ensure_size(column.values_size));
+    column.values = cursor.data();
+    cursor.remove_prefix(column.values_size);
+    columns_.push_back(column);
+  }
+  row_count_ = row_count;
+  return Status::OK();
+}
+
+PgWireDataHeader PgColumnarBatch::GetHeader(size_t column, int64_t row) const {
+  PgWireDataHeader header;
+  if (columns_[column].null_bitmap[row / 8] & (1 << (row % 8))) {
+    header.set_null();
+  }
+  return header;
+}
+
+uint32_t PgColumnarBatch::GetOffset(const Column& column, int64_t row) const {
+  return NetworkByteOrder::Load32(column.offsets + row * sizeof(uint32_t));
+}
+
+Slice PgColumnarBatch::GetValue(size_t column_index, int64_t row) const {
+  const Column& column = columns_[column_index];
+  if (column.offsets == nullptr) {
+    return Slice(column.values + row * column.value_size, column.value_size);
+  }
+  const uint32_t begin = GetOffset(column, row);
+  const uint32_t end = row + 1 < row_count_ ? GetOffset(column, row + 1) : column.values_size;
+  return Slice(column.values + begin, end - begin);
+}
+
 }  // namespace pggate
 }  // namespace yb
@@ -29,9 +29,75 @@ class PgDocData : public PgWire {
 
   static CHECKED_STATUS WriteColumn(const QLValue& col_value, faststring *buffer);
 
+  // Columnar format. Values of the same column of all rows are written together:
+  //   int64 kColumnarDataMarker, int64 row count, uint32 column count, and for each column
+  //   - uint8 InternalType of the column values (VALUE_NOT_SET if all values are null).
+  //   - Null bitmap, one bit per row.
+  //   - For fixed-width types, an array of row count values. Null values are zero-filled.
+  //   - For variable-length types, uint32 size of the data buffer, an array of row count uint32
+  //     offsets into the data buffer, and the data buffer. Null values have empty data.
+  // Each value is encoded the same way as in the row-oriented format, so it can be translated to
+  // a datum with PgExpr::TranslateData.
+  static CHECKED_STATUS WriteColumnarTuples(const PgsqlResultSet& tuples, faststring *buffer);
+
   static CHECKED_STATUS LoadCache(const string& data, int64_t *total_row_count, Slice *cursor);
 
   static PgWireDataHeader ReadDataHeader(Slice *cursor);
+
+  // Whether the data was written by WriteColumnarTuples().
+  static bool IsColumnarData(const string& data);
+
+  // Value that starts columnar data. The row-oriented format starts with a non-negative row count.
+  static constexpr int64_t kColumnarDataMarker = -1;
+
+ private:
+  // Write the value of a non-null column without data header.
+  static CHECKED_STATUS WriteColumnValue(const QLValue& col_value, faststring *buffer);
+};
+
+// Read access to rows written by PgDocData::WriteColumnarTuples(). Values are not copied, the
+// loaded data must outlive this object or the next Load() call.
+class PgColumnarBatch {
+ public:
+  CHECKED_STATUS Load(const string& data);
+
+  void Clear() {
+    row_count_ = 0;
+    columns_.clear();
+  }
+
+  int64_t row_count() const {
+    return row_count_;
+  }
+
+  size_t column_count() const {
+    return columns_.size();
+  }
+
+  PgWireDataHeader GetHeader(size_t column, int64_t row) const;
+
+  // Returns the encoded value of the given column in the given row. Empty for null values.
+  Slice GetValue(size_t column, int64_t row) const;
+
+  // Size of a value of the given type in the columnar format, or 0 for variable-length types.
+  static size_t FixedValueSize(InternalType type);
+
+ private:
+  struct Column {
+    InternalType type;
+    const uint8_t* null_bitmap;
+    size_t value_size;
+    // Fixed-width values or variable-length data buffer.
+    const uint8_t* values;
+    size_t values_size;
+    // Offsets of variable-length values. Null for fixed-width types.
+    const uint8_t* offsets;
+  };
+
+  uint32_t GetOffset(const Column& column, int64_t row) const;
+
+  int64_t row_count_ = 0;
+  std::vector<Column> columns_;
 };
 
 }  // namespace pggate
@@ -13,6 +13,8 @@
 
 #include "yb/yql/redis/redisserver/redis_commands.h"
 
+#include <unordered_map>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/preprocessor/stringize.hpp>
@@ -33,6 +35,7 @@
 #include "yb/rpc/scheduler.h"
 
 #include "yb/util/crypt.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/redis_util.h"
 #include "yb/util/stol_utils.h"
@@ -63,6 +66,13 @@ DEFINE_string(redis_passwords_separator, ",", "The character used to separate mu
 DEFINE_int32(redis_keys_threshold, 10000,
              "Maximum number of keys allowed to be in the db before the KEYS operation errors out");
 
+DEFINE_bool(redis_enable_multi_key_commands, false,
+            "Enables MGET and MSET with several keys. Keys served by the same tablet are sent in "
+            "one operation, which tablet servers of older versions apply to the first key only, so "
+            "it should be enabled only after all tablet servers are upgraded. MSET is not atomic "
+            "across tablets: when it fails, keys of some tablets could be already written.");
+TAG_FLAG(redis_enable_multi_key_commands, runtime);
+
 __attribute__((unused))
 DEFINE_validator(redis_passwords_separator, &ValidateRedisPasswordSeparator);
 
@@ -187,6 +197,45 @@ namespace {
 template<class Op>
 using Parser = Status(*)(Op*, const RedisClientCommand&);
 
+// Splits operation of a multi key command into parts, each of them contains keys served by a
+// single tablet. So such command costs one operation per tablet, instead of one per key.
+template<class Op>
+Result<std::vector<MultiKeyPart<Op>>> SplitByTablet(
+    const std::shared_ptr<client::YBTable>& table, Op* op) {
+  auto& request = *op->mutable_request();
+  std::vector<RedisKeyValuePB> key_values(request.extra_key_values_size() + 1);
+  key_values[0].Swap(request.mutable_key_value());
+  for (int i = 0; i != request.extra_key_values_size(); ++i) {
+    key_values[i + 1].Swap(request.mutable_extra_key_values(i));
+  }
+  request.clear_key_value();
+  request.clear_extra_key_values();
+
+  std::vector<MultiKeyPart<Op>> parts;
+  std::unordered_map<std::string, size_t> partition_start_to_part;
+  for (size_t i = 0; i != key_values.size(); ++i) {
+    auto& key_value = key_values[i];
+    std::string partition_key;
+    RETURN_NOT_OK(table->partition_schema().EncodeRedisKey(key_value.key(), &partition_key));
+    // Hash code of the first key is filled by the batcher, but we need it for all keys.
+    key_value.set_hash_code(PartitionSchema::DecodeMultiColumnHashValue(partition_key));
+    auto it = partition_start_to_part.emplace(
+        table->FindPartitionStart(partition_key), parts.size()).first;
+    if (it->second == parts.size()) {
+      parts.emplace_back();
+      parts.back().operation = std::make_shared<Op>(table);
+      *parts.back().operation->mutable_request() = request;
+    }
+    auto& part = parts[it->second];
+    auto& part_request = *part.operation->mutable_request();
+    auto* dest = part_request.has_key_value() ? part_request.add_extra_key_values()
+                                              : part_request.mutable_key_value();
+    dest->Swap(&key_value);
+    part.key_positions.push_back(i);
+  }
+  return parts;
+}
+
 template<class Op>
 void Command(
     const RedisCommandInfo& info,
@@ -208,6 +257,21 @@ void Command(
     RespondWithFailure(context->call(), idx, s.message().ToBuffer());
     return;
   }
+  if (op->request().extra_key_values_size() != 0) {
+    if (!FLAGS_redis_enable_multi_key_commands) {
+      RespondWithFailure(
+          context->call(), idx,
+          Format("$0 with several keys is not enabled", boost::to_upper_copy(info.name)));
+      return;
+    }
+    auto parts = SplitByTablet(table, op.get());
+    if (!parts.ok()) {
+      RespondWithFailure(context->call(), idx, parts.status().message().ToBuffer());
+      return;
+    }
+    context->Apply(idx, std::move(*parts), info.metrics);
+    return;
+  }
   context->Apply(idx, std::move(op), info.metrics);
 }
 
@@ -881,7 +945,7 @@ class KeysProcessor : public std::enable_shared_from_this<KeysProcessor> {
  public:
   explicit KeysProcessor(const LocalCommandData& data)
       : data_(data),
-        partitions_(data.table()->GetPartitions()), sessions_(partitions_.size()),
+        partitions_(*data.table()->GetPartitions()), sessions_(partitions_.size()),
         callbacks_(partitions_.size()) {
     resp_.set_code(RedisResponsePB::OK);
   }
@@ -77,6 +77,14 @@ class RedisServiceData {
 
 YB_STRONGLY_TYPED_BOOL(ManualResponse);
 
+// Part of a multi key command (MGET, MSET), that contains keys served by a single tablet.
+template <class Op>
+struct MultiKeyPart {
+  std::shared_ptr<Op> operation;
+  // Positions of keys of this part in the command.
+  std::vector<size_t> key_positions;
+};
+
 // Context for batch of Redis commands.
 class BatchContext : public RefCountedThreadSafe<BatchContext> {
  public:
@@ -98,6 +106,18 @@ class BatchContext : public RefCountedThreadSafe<BatchContext> {
       std::shared_ptr<client::YBRedisWriteOp> operation,
       const rpc::RpcMethodMetrics& metrics) = 0;
 
+  // Applies parts of a multi key command. The command is responded when all parts are done,
+  // array responses of the parts are combined in the order of keys in the command.
+  virtual void Apply(
+      size_t index,
+      std::vector<MultiKeyPart<client::YBRedisReadOp>> parts,
+      const rpc::RpcMethodMetrics& metrics) = 0;
+
+  virtual void Apply(
+      size_t index,
+      std::vector<MultiKeyPart<client::YBRedisWriteOp>> parts,
+      const rpc::RpcMethodMetrics& metrics) = 0;
+
   virtual void Apply(
       size_t index,
       std::function<bool(client::YBSession*, const StatusFunctor&)> functor,
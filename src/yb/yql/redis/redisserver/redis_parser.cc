@@ -166,13 +166,28 @@ CHECKED_STATUS ParseSetNX(YBRedisWriteOp *op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
-// TODO: support MSET
+// All keys are placed to a single operation, it is split into per tablet parts before applying.
+// Keys of the same tablet are written atomically, but MSET as a whole is not atomic.
 CHECKED_STATUS ParseMSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
   if (args.size() < 3 || args.size() % 2 == 0) {
     return STATUS_SUBSTITUTE(InvalidCommand,
         "An MSET request must have at least 3, odd number of arguments, found $0", args.size());
   }
-  return STATUS(InvalidCommand, "MSET command not yet supported");
+  auto* request = op->mutable_request();
+  request->mutable_set_request(); // Allocates new RedisSetRequestPB().
+  for (size_t i = 1; i < args.size(); i += 2) {
+    const auto& key = args[i];
+    const auto& value = args[i + 1];
+    if (key.empty()) {
+      return STATUS_SUBSTITUTE(InvalidCommand,
+          "An MSET request must have non empty key fields");
+    }
+    auto* key_value = i == 1 ? request->mutable_key_value() : request->add_extra_key_values();
+    key_value->set_key(key.cdata(), key.size());
+    key_value->add_value(value.cdata(), value.size());
+    key_value->set_type(REDIS_TYPE_STRING);
+  }
+  return Status::OK();
 }
 
 CHECKED_STATUS ParseHSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
@@ -532,9 +547,20 @@ CHECKED_STATUS ParseHGetLikeCommands(YBRedisReadOp* op, const RedisClientCommand
   return ParseCollection(op, args, boost::none, add_string_subkey, remove_duplicates);
 }
 
-// TODO: Support MGET
+// All keys are placed to a single operation, it is split into per tablet parts before applying.
 CHECKED_STATUS ParseMGet(YBRedisReadOp* op, const RedisClientCommand& args) {
-  return STATUS(InvalidCommand, "MGET command not yet supported");
+  auto* request = op->mutable_request();
+  request->mutable_get_request()->set_request_type(RedisGetRequestPB_GetRequestType_MGET);
+  for (size_t i = 1; i != args.size(); ++i) {
+    const auto& key = args[i];
+    if (key.empty()) {
+      return STATUS_SUBSTITUTE(InvalidCommand,
+          "An MGET request must have non empty key fields");
+    }
+    auto* key_value = i == 1 ? request->mutable_key_value() : request->add_extra_key_values();
+    key_value->set_key(key.cdata(), key.size());
+  }
+  return Status::OK();
 }
 
 CHECKED_STATUS ParseHGet(YBRedisReadOp* op, const RedisClientCommand& args) {
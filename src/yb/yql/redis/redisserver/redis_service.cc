@@ -165,19 +165,95 @@ OperationType Opposite(OperationType type) {
   FATAL_INVALID_ENUM_VALUE(OperationType, type);
 }
 
+// Combines responses of parts of a multi key command into a single response.
+// Parts are applied independently, so a failed MSET could leave keys of other parts written.
+class MultiKeyResponse {
+ public:
+  MultiKeyResponse(const std::shared_ptr<RedisInboundCall>& call,
+                   size_t index,
+                   const rpc::RpcMethodMetrics& metrics,
+                   size_t num_parts,
+                   size_t num_keys)
+      : call_(call), index_(index), metrics_(metrics), parts_left_(num_parts),
+        num_keys_(num_keys) {
+    response_.set_code(RedisResponsePB::OK);
+  }
+
+  // response is nullptr when part does not have an operation.
+  void PartDone(const Status& status, RedisResponsePB* response,
+                const std::vector<size_t>& key_positions) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!failed_) {
+        if (!status.ok() || response == nullptr || response->code() != RedisResponsePB::OK) {
+          failed_ = true;
+          status_ = status;
+          if (response != nullptr) {
+            response_.Swap(response);
+          }
+        } else if (response->has_array_response()) {
+          CombineArray(response->mutable_array_response(), key_positions);
+        }
+      }
+      if (--parts_left_ != 0) {
+        return;
+      }
+    }
+
+    if (!failed_) {
+      call_->RespondSuccess(index_, metrics_, &response_);
+    } else if (!status_.ok() && response_.code() != RedisResponsePB::SERVER_ERROR) {
+      call_->RespondFailure(index_, status_);
+    } else {
+      call_->Respond(index_, false, &response_);
+    }
+  }
+
+ private:
+  void CombineArray(RedisArrayPB* array, const std::vector<size_t>& key_positions) {
+    auto* elements = response_.mutable_array_response()->mutable_elements();
+    if (elements->empty()) {
+      elements->Reserve(num_keys_);
+      for (size_t i = 0; i != num_keys_; ++i) {
+        elements->Add();
+      }
+    }
+    size_t size = std::min<size_t>(key_positions.size(), array->elements_size());
+    for (size_t i = 0; i != size; ++i) {
+      elements->Mutable(key_positions[i])->swap(*array->mutable_elements(i));
+    }
+  }
+
+  std::shared_ptr<RedisInboundCall> call_;
+  const size_t index_;
+  rpc::RpcMethodMetrics metrics_;
+  std::mutex mutex_;
+  size_t parts_left_;
+  const size_t num_keys_;
+  bool failed_ = false;
+  Status status_;
+  RedisResponsePB response_;
+};
+
+typedef std::shared_ptr<MultiKeyResponse> MultiKeyResponsePtr;
+
 class Operation {
  public:
   template <class Op>
   Operation(const std::shared_ptr<RedisInboundCall>& call,
             size_t index,
             std::shared_ptr<Op> operation,
-            const rpc::RpcMethodMetrics& metrics)
+            const rpc::RpcMethodMetrics& metrics,
+            MultiKeyResponsePtr multi_key_response = nullptr,
+            std::vector<size_t> key_positions = std::vector<size_t>())
     : type_(std::is_same<Op, YBRedisReadOp>::value ? OperationType::kRead : OperationType::kWrite),
       call_(call),
       index_(index),
       operation_(std::move(operation)),
       metrics_(metrics),
-      manual_response_(ManualResponse::kFalse) {
+      manual_response_(ManualResponse::kFalse),
+      multi_key_response_(std::move(multi_key_response)),
+      key_positions_(std::move(key_positions)) {
     auto status = operation_->GetPartitionKey(&partition_key_);
     if (!status.ok()) {
       Respond(status);
@@ -269,6 +345,17 @@ class Operation {
   void GetKeys(RedisKeyList* keys) const {
     if (FLAGS_redis_safe_batch) {
       keys->emplace_back(operation_ ? operation_->GetKey() : Slice());
+      switch (type_) {
+        case OperationType::kRead:
+          AddExtraKeys(down_cast<YBRedisReadOp*>(operation_.get())->request(), keys);
+          break;
+        case OperationType::kWrite:
+          AddExtraKeys(down_cast<YBRedisWriteOp*>(operation_.get())->request(), keys);
+          break;
+        case OperationType::kNone: FALLTHROUGH_INTENDED;
+        case OperationType::kLocal:
+          break;
+      }
     }
   }
 
@@ -303,6 +390,12 @@ class Operation {
       return;
     }
 
+    if (multi_key_response_) {
+      multi_key_response_->PartDone(
+          status, operation_ ? &response() : nullptr, key_positions_);
+      return;
+    }
+
     if (status.ok()) {
       if (operation_) {
         call_->RespondSuccess(index_, metrics_, &response());
@@ -323,6 +416,13 @@ class Operation {
   }
 
  private:
+  template <class Request>
+  static void AddExtraKeys(const Request& request, RedisKeyList* keys) {
+    for (const auto& key_value : request.extra_key_values()) {
+      keys->emplace_back(key_value.key());
+    }
+  }
+
   OperationType type_;
   std::shared_ptr<RedisInboundCall> call_;
   size_t index_;
@@ -331,6 +431,9 @@ class Operation {
   std::string partition_key_;
   rpc::RpcMethodMetrics metrics_;
   ManualResponse manual_response_;
+  // Set when this operation is a part of a multi key command.
+  MultiKeyResponsePtr multi_key_response_;
+  std::vector<size_t> key_positions_;
   client::internal::RemoteTabletPtr tablet_;
   std::atomic<bool> responded_{false};
 };
@@ -377,6 +480,9 @@ class SessionPool {
 class Block;
 typedef std::shared_ptr<Block> BlockPtr;
 
+class BlockLevel;
+typedef std::shared_ptr<BlockLevel> BlockLevelPtr;
+
 class Block : public std::enable_shared_from_this<Block> {
  public:
   typedef MCVector<Operation*> Ops;
@@ -409,9 +515,8 @@ class Block : public std::enable_shared_from_this<Block> {
     }
     if (has_ok) {
       if (applied_operations) {
-        // Allow local calls in this thread only if no one is waiting behind us.
-        session_->set_allow_local_calls_in_curr_thread(
-            allow_local_calls_in_curr_thread && this->next_ == nullptr);
+        // Level decides whether local calls are allowed, since it knows who is waiting behind us.
+        session_->set_allow_local_calls_in_curr_thread(allow_local_calls_in_curr_thread);
         session_->FlushAsync(std::move(callback));
       }
     } else {
@@ -419,15 +524,12 @@ class Block : public std::enable_shared_from_this<Block> {
     }
   }
 
-  BlockPtr SetNext(const BlockPtr& next) {
-    BlockPtr result = std::move(next_);
-    next_ = next;
-    return result;
+  void SetLevel(BlockLevelPtr level) {
+    level_ = std::move(level);
   }
 
   std::string ToString() const {
-    return Format("{ ops: $0 context: $1 next: $2 }",
-                  ops_, static_cast<void*>(context_.get()), next_);
+    return Format("{ ops: $0 context: $1 }", ops_, static_cast<void*>(context_.get()));
   }
 
  private:
@@ -496,12 +598,13 @@ class Block : public std::enable_shared_from_this<Block> {
       session_pool_->Release(session_);
       session_.reset();
     }
-    if (next_) {
-      next_->Launch(session_pool_, allow_local_calls_in_curr_thread);
-    }
+    NotifyLevel(allow_local_calls_in_curr_thread);
     context_.reset();
   }
 
+  // Notifies level that this block was processed, so next level could be launched.
+  void NotifyLevel(bool allow_local_calls_in_curr_thread);
+
   bool Retrying() {
     auto old_table = context_->table();
     context_->CleanYBTableFromCache();
@@ -544,37 +647,94 @@ class Block : public std::enable_shared_from_this<Block> {
   MonoTime start_;
   SessionPool* session_pool_;
   std::shared_ptr<client::YBSession> session_;
-  BlockPtr next_;
+  BlockLevelPtr level_;
   int num_retries_ = 1;
 };
 
 typedef std::array<rpc::RpcMethodMetrics, kOperationTypeMapSize> InternalMetrics;
 
-struct BlockData {
-  explicit BlockData(Arena* arena) : used_keys(UsedKeys::allocator_type(arena)) {}
+// Set of blocks of a single tablet that could be executed concurrently.
+// Operations in a level don't conflict with each other, except operations of the same type on the
+// same key, that are kept in the same block in the original order.
+// Next level is launched when all blocks of this level are processed.
+class BlockLevel {
+ public:
+  BlockPtr& block(OperationType type) {
+    switch (type) {
+      case OperationType::kRead:
+        return read_block_;
+      case OperationType::kWrite:
+        return write_block_;
+      case OperationType::kLocal:
+        return local_block_;
+      case OperationType::kNone:
+        FATAL_INVALID_ENUM_VALUE(OperationType, type);
+    }
+    FATAL_INVALID_ENUM_VALUE(OperationType, type);
+  }
+
+  void SetNext(BlockLevelPtr next) {
+    next_ = std::move(next);
+  }
+
+  void Launch(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
+    // Blocks refer to their level, so we move them out to avoid reference cycle.
+    std::array<BlockPtr, 3> blocks = {
+        std::move(read_block_), std::move(write_block_), std::move(local_block_) };
+    size_t num_blocks = 0;
+    for (const auto& block : blocks) {
+      if (block) {
+        ++num_blocks;
+      }
+    }
+    pending_blocks_.store(num_blocks, std::memory_order_release);
+    // Allow local calls in this thread only if no one is waiting behind us.
+    allow_local_calls_in_curr_thread = allow_local_calls_in_curr_thread && next_ == nullptr;
+    for (auto& block : blocks) {
+      if (block) {
+        block->Launch(session_pool, allow_local_calls_in_curr_thread);
+      }
+    }
+  }
+
+  void BlockProcessed(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
+    if (pending_blocks_.fetch_sub(1, std::memory_order_acq_rel) == 1 && next_) {
+      next_->Launch(session_pool, allow_local_calls_in_curr_thread);
+    }
+  }
 
   std::string ToString() const {
-    return Format("{ used_keys: $0 block: $1 count: $2 }", used_keys, block, count);
+    return Format("{ read_block: $0 write_block: $1 local_block: $2 }",
+                  read_block_, write_block_, local_block_);
   }
 
-  typedef MCUnorderedSet<Slice, Slice::Hash> UsedKeys;
-  UsedKeys used_keys;
-  BlockPtr block;
-  size_t count = 0;
+ private:
+  BlockPtr read_block_;
+  BlockPtr write_block_;
+  BlockPtr local_block_;
+  std::atomic<size_t> pending_blocks_{0};
+  BlockLevelPtr next_;
 };
 
-class TabletOperations {
- public:
-  explicit TabletOperations(Arena* arena)
-      : read_data_(arena), write_data_(arena) {
+void Block::NotifyLevel(bool allow_local_calls_in_curr_thread) {
+  auto level = std::move(level_);
+  if (level) {
+    level->BlockProcessed(session_pool_, allow_local_calls_in_curr_thread);
   }
+}
+
+// Levels of the last read and write operations on a key, increased by one.
+// Zero means that there was no such operation.
+struct KeyLevels {
+  size_t read = 0;
+  size_t write = 0;
 
-  BlockData& data(OperationType type) {
+  size_t& last(OperationType type) {
     switch (type) {
       case OperationType::kRead:
-        return read_data_;
+        return read;
       case OperationType::kWrite:
-        return write_data_;
+        return write;
       case OperationType::kNone: FALLTHROUGH_INTENDED;
       case OperationType::kLocal:
         FATAL_INVALID_ENUM_VALUE(OperationType, type);
@@ -582,16 +742,28 @@ class TabletOperations {
     FATAL_INVALID_ENUM_VALUE(OperationType, type);
   }
 
+  // Returns minimal level, that could be used by operation of specified type on this key.
+  // Operation should not be reordered with operations of the same type, and should go after
+  // conflicting operations of the opposite type.
+  size_t MinLevel(OperationType type) {
+    auto same = last(type);
+    return std::max(same ? same - 1 : 0, last(Opposite(type)));
+  }
+};
+
+// Operations of a single tablet, split into levels.
+// Each operation is placed to the first level, where it does not conflict with previous operations.
+// So independent keys don't wait for each other, while operations on the same key are executed
+// in the original order.
+class TabletOperations {
+ public:
+  explicit TabletOperations(Arena* arena)
+      : levels_(arena), key_levels_(arena) {
+  }
+
   void Done(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
-    if (flush_head_) {
-      flush_head_->Launch(session_pool, allow_local_calls_in_curr_thread);
-    } else {
-      if (read_data_.block) {
-        read_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
-      }
-      if (write_data_.block) {
-        write_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
-      }
+    if (!levels_.empty()) {
+      levels_.front()->Launch(session_pool, allow_local_calls_in_curr_thread);
     }
   }
 
@@ -600,149 +772,62 @@ class TabletOperations {
                Operation* operation,
                const InternalMetrics& metrics_internal) {
     auto type = operation->type();
-    if (type == OperationType::kLocal) {
-      ProcessLocalOperation(context, arena, operation, metrics_internal);
-      return;
-    }
     boost::container::small_vector<Slice, RedisClientCommand::static_capacity> keys;
-    operation->GetKeys(&keys);
-    CheckConflicts(type, keys);
-    auto& data = this->data(type);
-    if (!data.block) {
-      ArenaAllocator<Block> alloc(arena);
-      data.block = std::allocate_shared<Block>(
-          alloc, context, alloc, metrics_internal[static_cast<size_t>(OperationType::kRead)]);
-      if (last_conflict_type_ == OperationType::kLocal) {
-        last_local_block_->SetNext(data.block);
-        last_conflict_type_ = type;
-      } else if (type == last_conflict_type_) {
-        auto old_value = this->data(Opposite(type)).block->SetNext(data.block);
-        if (old_value) {
-          LOG(DFATAL) << "Opposite already had next block: "
-                      << operation->call().serialized_request().ToDebugString();
+    size_t level_idx;
+    if (type == OperationType::kLocal) {
+      // Local operation is executed after all previous operations, and before all following ones.
+      level_idx = levels_.size();
+      min_level_ = level_idx + 1;
+    } else {
+      operation->GetKeys(&keys);
+      level_idx = min_level_;
+      for (const auto& key : keys) {
+        auto it = key_levels_.find(key);
+        if (it != key_levels_.end()) {
+          level_idx = std::max(level_idx, it->second.MinLevel(type));
         }
       }
     }
-    data.block->AddOperation(operation);
-    RememberKeys(type, &keys);
-  }
-
-  std::string ToString() const {
-    return Format("{ read_data: $0 write_data: $1 flush_head: $2 last_local_block: $3 "
-                  "last_conflict_type: $4 }",
-                  read_data_, write_data_, flush_head_, last_local_block_, last_conflict_type_);
-  }
 
- private:
-  void ProcessLocalOperation(const BatchContextPtr& context,
-                             Arena* arena,
-                             Operation* operation,
-                             const InternalMetrics& metrics_internal) {
-    ArenaAllocator<Block> alloc(arena);
-    auto block = std::allocate_shared<Block>(
-        alloc, context, alloc, metrics_internal[static_cast<size_t>(OperationType::kLocal)]);
-    switch (last_conflict_type_) {
-      case OperationType::kNone:
-        if (read_data_.block) {
-          flush_head_ = read_data_.block;
-          if (write_data_.block) {
-            read_data_.block->SetNext(write_data_.block);
-            write_data_.block->SetNext(block);
-          } else {
-            read_data_.block->SetNext(block);
-          }
-        } else if (write_data_.block) {
-          flush_head_ = write_data_.block;
-          write_data_.block->SetNext(block);
-        } else {
-          flush_head_ = block;
-        }
-        break;
-      case OperationType::kRead:
-        read_data_.block->SetNext(block);
-        break;
-      case OperationType::kWrite:
-        write_data_.block->SetNext(block);
-        break;
-      case OperationType::kLocal:
-        last_local_block_->SetNext(block);
-        break;
-    }
-    read_data_.block = nullptr;
-    read_data_.used_keys.clear();
-    write_data_.block = nullptr;
-    write_data_.used_keys.clear();
-    last_local_block_ = block;
-    last_conflict_type_ = OperationType::kLocal;
+    auto& level = Level(arena, level_idx);
+    auto& block = level->block(type);
+    if (!block) {
+      ArenaAllocator<Block> alloc(arena);
+      auto metrics_type = type == OperationType::kLocal ? OperationType::kLocal
+                                                        : OperationType::kRead;
+      block = std::allocate_shared<Block>(
+          alloc, context, alloc, metrics_internal[static_cast<size_t>(metrics_type)]);
+      block->SetLevel(level);
+    }
     block->AddOperation(operation);
-  }
 
-  void ConflictFound(OperationType type) {
-    auto& data = this->data(type);
-    auto& opposite_data = this->data(Opposite(type));
-
-    switch (last_conflict_type_) {
-      case OperationType::kNone:
-        flush_head_ = opposite_data.block;
-        opposite_data.block->SetNext(data.block);
-        break;
-      case OperationType::kWrite:
-      case OperationType::kRead:
-        data.block = nullptr;
-        data.used_keys.clear();
-        break;
-      case OperationType::kLocal:
-        last_local_block_->SetNext(data.block);
-        break;
+    for (const auto& key : keys) {
+      auto& last = key_levels_[key].last(type);
+      last = std::max(last, level_idx + 1);
     }
-    last_conflict_type_ = type;
   }
 
-  void CheckConflicts(OperationType type, const RedisKeyList& keys) {
-    if (last_conflict_type_ == type) {
-      return;
-    }
-    if (last_conflict_type_ == OperationType::kLocal) {
-      return;
-    }
-    auto& opposite = data(Opposite(type));
-    bool conflict = false;
-    for (const auto& key : keys) {
-      if (opposite.used_keys.count(key)) {
-        conflict = true;
-        break;
-      }
-    }
-    if (conflict) {
-      ConflictFound(type);
-    }
+  std::string ToString() const {
+    return Format("{ levels: $0 min_level: $1 }", levels_, min_level_);
   }
 
-  void RememberKeys(OperationType type, RedisKeyList* keys) {
-    BlockData* dest;
-    switch (type) {
-      case OperationType::kRead:
-        dest = &read_data_;
-        break;
-      case OperationType::kWrite:
-        dest = &write_data_;
-        break;
-      case OperationType::kNone: FALLTHROUGH_INTENDED;
-      case OperationType::kLocal:
-        FATAL_INVALID_ENUM_VALUE(OperationType, type);
-    }
-    for (auto& key : *keys) {
-      dest->used_keys.insert(std::move(key));
+ private:
+  const BlockLevelPtr& Level(Arena* arena, size_t idx) {
+    while (levels_.size() <= idx) {
+      auto level = std::allocate_shared<BlockLevel>(ArenaAllocator<BlockLevel>(arena));
+      if (!levels_.empty()) {
+        levels_.back()->SetNext(level);
+      }
+      levels_.push_back(std::move(level));
     }
+    return levels_[idx];
   }
 
-  BlockData read_data_;
-  BlockData write_data_;
-  BlockPtr flush_head_;
-  BlockPtr last_local_block_;
+  MCVector<BlockLevelPtr> levels_;
+  MCUnorderedMap<Slice, KeyLevels, Slice::Hash> key_levels_;
 
-  // Type of command that caused last conflict between reads and writes.
-  OperationType last_conflict_type_ = OperationType::kNone;
+  // Minimal level that could be used by the next operation, i.e. level after the last local one.
+  size_t min_level_ = 0;
 };
 
 YB_STRONGLY_TYPED_BOOL(IsMonitorMessage);
@@ -903,6 +988,20 @@ class BatchContextImpl : public BatchContext {
     DoApply(index, std::move(operation), metrics);
   }
 
+  void Apply(
+      size_t index,
+      std::vector<MultiKeyPart<client::YBRedisReadOp>> parts,
+      const rpc::RpcMethodMetrics& metrics) override {
+    DoApplyMultiKey(index, std::move(parts), metrics);
+  }
+
+  void Apply(
+      size_t index,
+      std::vector<MultiKeyPart<client::YBRedisWriteOp>> parts,
+      const rpc::RpcMethodMetrics& metrics) override {
+    DoApplyMultiKey(index, std::move(parts), metrics);
+  }
+
   void Apply(
       size_t index,
       std::function<bool(client::YBSession*, const StatusFunctor&)> functor,
@@ -927,6 +1026,21 @@ class BatchContextImpl : public BatchContext {
     }
   }
 
+  template <class Op>
+  void DoApplyMultiKey(
+      size_t index, std::vector<MultiKeyPart<Op>> parts, const rpc::RpcMethodMetrics& metrics) {
+    size_t num_keys = 0;
+    for (const auto& part : parts) {
+      num_keys += part.key_positions.size();
+    }
+    auto response = std::make_shared<MultiKeyResponse>(
+        call_, index, metrics, parts.size(), num_keys);
+    for (auto& part : parts) {
+      DoApply(index, std::move(part.operation), metrics, response,
+              std::move(part.key_positions));
+    }
+  }
+
   void LookupDone(
       Operation* operation, int retries, const Result<client::internal::RemoteTabletPtr>& result) {
     const int kMaxRetries = 2;
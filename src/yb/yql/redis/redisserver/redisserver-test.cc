@@ -52,6 +52,7 @@ DECLARE_bool(emulate_redis_responses);
 DECLARE_bool(test_tserver_timeout);
 DECLARE_bool(enable_backpressure_mode_for_testing);
 DECLARE_bool(yedis_enable_flush);
+DECLARE_bool(redis_enable_multi_key_commands);
 DECLARE_int32(redis_service_yb_client_timeout_millis);
 DECLARE_int32(redis_max_value_size);
 DECLARE_int32(redis_max_command_size);
@@ -1310,6 +1311,19 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+TEST_F_EX(TestRedisService, SafeBatchInterleavedKeys, TestRedisServiceSafeBatch) {
+  // Operations on the same key should keep their order, while operations on other keys could be
+  // executed concurrently with them.
+  for (int i = 0; i != 100; ++i) {
+    SendCommandAndExpectResponse(
+        __LINE__,
+        Format("set a$0 1\r\nget a$0\r\nset b$0 2\r\nset a$0 3\r\nget b$0\r\nget a$0\r\n"
+                   "set b$0 4\r\nget b$0\r\nget c$0\r\nset c$0 5\r\nget c$0\r\n", i),
+        "+OK\r\n$1\r\n1\r\n+OK\r\n+OK\r\n$1\r\n2\r\n$1\r\n3\r\n+OK\r\n$1\r\n4\r\n"
+            "$-1\r\n+OK\r\n$1\r\n5\r\n");
+  }
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,
@@ -4325,6 +4339,57 @@ TEST_F(TestRedisService, TestSetNX) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestMultiKeyCommands) {
+  FLAGS_redis_enable_multi_key_commands = true;
+  // Use enough keys, so they are spread over several tablets.
+  constexpr int kNumKeys = 50;
+  std::vector<std::string> mset = {"MSET"};
+  std::vector<std::string> mget = {"MGET"};
+  std::vector<RedisReply> expected;
+  for (int i = 0; i != kNumKeys; ++i) {
+    auto key = Format("key_$0", i);
+    mset.push_back(key);
+    mset.push_back(Format("value_$0", i));
+    mget.push_back(key);
+    expected.emplace_back(RedisReplyType::kString, Format("value_$0", i));
+  }
+  DoRedisTestOk(__LINE__, mset);
+  DoRedisTestInt(__LINE__, {"HSET", "map_key", "subkey", "value"}, 1);
+
+  SyncClient();
+
+  // Missing keys, keys that don't hold a string and repeated keys.
+  mget.push_back("missing_key");
+  expected.emplace_back();
+  mget.push_back("map_key");
+  expected.emplace_back();
+  mget.push_back("key_0");
+  expected.emplace_back(RedisReplyType::kString, "value_0");
+  DoRedisTestResultsArray(__LINE__, mget, expected);
+  DoRedisTestResultsArray(
+      __LINE__, {"MGET", "key_1"}, {RedisReply(RedisReplyType::kString, "value_1")});
+
+  DoRedisTestExpectError(__LINE__, {"MSET", "key_1", "value_1", "key_2"});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
+TEST_F(TestRedisService, TestMultiKeyCommandsDisabled) {
+  FLAGS_redis_enable_multi_key_commands = false;
+  DoRedisTestExpectError(__LINE__, {"MSET", "key_1", "value_1", "key_2", "value_2"});
+  DoRedisTestExpectError(__LINE__, {"MGET", "key_1", "key_2"});
+
+  // Single key commands are not affected.
+  DoRedisTestOk(__LINE__, {"MSET", "key_1", "value_1"});
+  SyncClient();
+  DoRedisTestResultsArray(
+      __LINE__, {"MGET", "key_1"}, {RedisReply(RedisReplyType::kString, "value_1")});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestAdditionalCommands) {
 
   // The default value is true, but we explicitly set this here for clarity.